@@ -0,0 +1,80 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "algo/cpu_features.h"
+#if SIMD_X86 && defined(_MSC_VER)
+    #include <immintrin.h>
+    #include <intrin.h>
+#endif
+
+using namespace au;
+
+static algo::SimdLevel detect_simd_level()
+{
+    #if SIMD_NEON
+        return algo::SimdLevel::Neon;
+    #elif SIMD_X86 && defined(__GNUC__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return algo::SimdLevel::Avx2;
+        if (__builtin_cpu_supports("ssse3"))
+            return algo::SimdLevel::Ssse3;
+        if (__builtin_cpu_supports("sse2"))
+            return algo::SimdLevel::Sse2;
+        return algo::SimdLevel::None;
+    #elif SIMD_X86 && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        const auto max_leaf = info[0];
+        __cpuid(info, 1);
+        const bool sse2 = info[3] & (1 << 26);
+        const bool ssse3 = info[2] & (1 << 9);
+        const bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28))
+            && (_xgetbv(0) & 6) == 6;
+        bool avx2 = false;
+        if (max_leaf >= 7 && os_avx)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = info[1] & (1 << 5);
+        }
+        if (avx2)
+            return algo::SimdLevel::Avx2;
+        if (ssse3)
+            return algo::SimdLevel::Ssse3;
+        if (sse2)
+            return algo::SimdLevel::Sse2;
+        return algo::SimdLevel::None;
+    #else
+        return algo::SimdLevel::None;
+    #endif
+}
+
+algo::SimdLevel algo::get_simd_level()
+{
+    static const auto level = detect_simd_level();
+    return level;
+}
+
+bool algo::is_simd_level_supported(const SimdLevel level)
+{
+    const auto best = get_simd_level();
+    if (level == SimdLevel::None)
+        return true;
+    if (best == SimdLevel::Neon || level == SimdLevel::Neon)
+        return best == level;
+    return level <= best;
+}
@@ -0,0 +1,60 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "types.h"
+
+#if defined(__x86_64__) || defined(__i386__) \
+    || defined(_M_X64) || defined(_M_IX86)
+    #define SIMD_X86 1
+#else
+    #define SIMD_X86 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define SIMD_NEON 1
+#else
+    #define SIMD_NEON 0
+#endif
+
+// Lets single functions use instruction sets the rest of the program isn't
+// compiled for. Callers must check the CPU first.
+#if SIMD_X86 && defined(__GNUC__)
+    #define SIMD_TARGET(x) __attribute__((target(x)))
+#else
+    #define SIMD_TARGET(x)
+#endif
+
+namespace au {
+namespace algo {
+
+    enum class SimdLevel : u8
+    {
+        None,
+        Sse2,
+        Ssse3,
+        Avx2,
+        Neon,
+    };
+
+    // Detected once; returns the best level this CPU supports.
+    SimdLevel get_simd_level();
+
+    bool is_simd_level_supported(const SimdLevel level);
+
+} }
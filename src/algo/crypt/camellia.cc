@@ -17,7 +17,6 @@
 
 #include "algo/crypt/camellia.h"
 #include "algo/binary.h"
-#include "algo/ptr.h"
 #include "algo/range.h"
 
 using namespace au;
@@ -25,7 +24,7 @@ using namespace au::algo::crypt;
 
 static const size_t small_rounds = 3;
 
-static u32 sbox1_1110[] =
+static const u32 sbox1_1110[] =
 {
     0x70707000, 0x82828200, 0x2C2C2C00, 0xECECEC00,
     0xB3B3B300, 0x27272700, 0xC0C0C000, 0xE5E5E500,
@@ -93,7 +92,7 @@ static u32 sbox1_1110[] =
     0x77777700, 0xC7C7C700, 0x80808000, 0x9E9E9E00,
 };
 
-static u32 sbox2_0222[] =
+static const u32 sbox2_0222[] =
 {
     0x00E0E0E0, 0x00050505, 0x00585858, 0x00D9D9D9,
     0x00676767, 0x004E4E4E, 0x00818181, 0x00CBCBCB,
@@ -161,7 +160,7 @@ static u32 sbox2_0222[] =
     0x00EEEEEE, 0x008F8F8F, 0x00010101, 0x003D3D3D,
 };
 
-static u32 sbox3_3033[] =
+static const u32 sbox3_3033[] =
 {
     0x38003838, 0x41004141, 0x16001616, 0x76007676,
     0xD900D9D9, 0x93009393, 0x60006060, 0xF200F2F2,
@@ -229,7 +228,7 @@ static u32 sbox3_3033[] =
     0xBB00BBBB, 0xE300E3E3, 0x40004040, 0x4F004F4F,
 };
 
-static u32 sbox4_4404[] =
+static const u32 sbox4_4404[] =
 {
     0x70700070, 0x2C2C002C, 0xB3B300B3, 0xC0C000C0,
     0xE4E400E4, 0x57570057, 0xEAEA00EA, 0xAEAE00AE,
@@ -341,7 +340,8 @@ void Camellia::encrypt_block_128(
     const u32 input_block[4],
     u32 output_block[4]) const
 {
-    auto key_ptr = algo::make_ptr(key.data(), key.size());
+    // the key size is validated in the constructor
+    auto key_ptr = key.data();
     for (const auto i : algo::range(4))
         output_block[i] = input_block[i] ^ *key_ptr++;
 
@@ -416,10 +416,7 @@ void Camellia::decrypt_block_128(
             | (algo::rotr<u32>(output_block[i], 8) & 0xFF00FF00);
     }
 
-    auto key_ptr
-        = algo::make_ptr(key.data(), key.size())
-        + get_key_size(grand_rounds)
-        - 4;
+    auto key_ptr = key.data() + get_key_size(grand_rounds) - 4;
 
     for (const auto i : algo::range(4))
         output_block[i] ^= key_ptr[i];
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 #include "algo/range.h"
 #include "err.h"
@@ -34,17 +35,48 @@ namespace algo {
                 throw err::BadDataSizeError();
         }
 
-        Grid(const Grid &other) : Grid(other.width(), other.height())
+        Grid(const Grid &other) :
+            content(other.content),
+            _width(other._width),
+            _height(other._height)
         {
-            for (const auto y : algo::range(_height))
-            for (const auto x : algo::range(_width))
-                at(x, y) = other.at(x, y);
+        }
+
+        Grid(Grid &&other) noexcept :
+            content(std::move(other.content)),
+            _width(other._width),
+            _height(other._height)
+        {
+            other.content.clear();
+            other._width = 0;
+            other._height = 0;
         }
 
         virtual ~Grid()
         {
         }
 
+        Grid &operator=(const Grid &other)
+        {
+            content = other.content;
+            _width = other._width;
+            _height = other._height;
+            return *this;
+        }
+
+        Grid &operator=(Grid &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+            content = std::move(other.content);
+            _width = other._width;
+            _height = other._height;
+            other.content.clear();
+            other._width = 0;
+            other._height = 0;
+            return *this;
+        }
+
         size_t width() const
         {
             return _width;
@@ -16,13 +16,13 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "algo/pack/huffman.h"
-#include "io/msb_bit_stream.h"
+#include "algo/range.h"
 
 using namespace au;
 using namespace au::algo::pack;
 
-static int init_huffman_impl(
-    io::BaseBitStream &input_stream, u16 nodes[2][512], int &size)
+template<typename T> static int init_huffman_impl(
+    T &input_stream, u16 nodes[2][512], int &size)
 {
     if (!input_stream.read(1))
         return input_stream.read(8);
@@ -41,11 +41,37 @@ HuffmanTree::HuffmanTree(io::BaseBitStream &input_stream)
     root = init_huffman_impl(input_stream, nodes, size);
 }
 
+HuffmanTree::HuffmanTree(io::MsbBitReader &input_reader)
+{
+    size = 256;
+    root = init_huffman_impl(input_reader, nodes, size);
+}
+
 HuffmanTree::HuffmanTree(const bstr &data)
 {
-    io::MsbBitStream input_stream(data);
+    io::MsbBitReader input_reader(data);
     size = 256;
-    root = init_huffman_impl(input_stream, nodes, size);
+    root = init_huffman_impl(input_reader, nodes, size);
+}
+
+// Nodes 256..511 are internal, anything else is a byte.
+static u32 get_table_node(const u16 node)
+{
+    return node >= 256 && node <= 511
+        ? node - 256
+        : (node & 0xFF) | HuffmanTable::leaf_flag;
+}
+
+HuffmanTable HuffmanTree::get_table() const
+{
+    std::vector<u32> children;
+    for (const auto i : algo::range(256, size))
+    {
+        children.push_back(get_table_node(nodes[0][i]));
+        children.push_back(get_table_node(nodes[1][i]));
+    }
+    return HuffmanTable(
+        children, get_table_node(root), HuffmanBitOrder::MsbFirst);
 }
 
 bstr algo::pack::decode_huffman(
@@ -53,15 +79,21 @@ bstr algo::pack::decode_huffman(
     const bstr &input,
     const size_t target_size)
 {
-    bstr output;
-    output.resize(target_size);
-    io::MsbBitStream input_stream(input);
-    while (output.size() < target_size && input_stream.left())
-    {
-        auto byte = huffman_tree.root;
-        while (byte >= 256 && byte <= 511)
-            byte = huffman_tree.nodes[input_stream.read(1)][byte];
-        output += static_cast<const u8>(byte);
-    }
+    io::MsbBitReader input_reader(input);
+    return decode_huffman(huffman_tree, input_reader, target_size);
+}
+
+bstr algo::pack::decode_huffman(
+    const HuffmanTree &huffman_tree,
+    io::MsbBitReader &input_reader,
+    const size_t target_size)
+{
+    const auto table = huffman_tree.get_table();
+    bstr output(target_size);
+    auto output_ptr = output.get<u8>();
+    const auto output_end = output.end<const u8>();
+    while (output_ptr < output_end && input_reader.left())
+        *output_ptr++ = table.decode(input_reader);
+    output.resize(output_ptr - output.get<u8>());
     return output;
 }
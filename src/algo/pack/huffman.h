@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include "algo/pack/huffman_table.h"
 #include "io/base_bit_stream.h"
+#include "io/msb_bit_reader.h"
 
 namespace au {
 namespace algo {
@@ -27,6 +29,9 @@ namespace pack {
     {
         HuffmanTree(const bstr &data);
         HuffmanTree(io::BaseBitStream &input_stream);
+        HuffmanTree(io::MsbBitReader &input_reader);
+
+        HuffmanTable get_table() const;
 
         int size;
         u16 root;
@@ -38,4 +43,10 @@ namespace pack {
         const bstr &input,
         const size_t target_size);
 
+    // Stops early if the input ends before target_size bytes were decoded.
+    bstr decode_huffman(
+        const HuffmanTree &huffman_tree,
+        io::MsbBitReader &input_reader,
+        const size_t target_size);
+
 } } }
@@ -0,0 +1,160 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "algo/pack/huffman_table.h"
+#include <algorithm>
+#include "algo/range.h"
+
+using namespace au;
+using namespace au::algo::pack;
+
+const u32 HuffmanTable::leaf_flag;
+const u32 HuffmanTable::missing_node;
+
+static const size_t max_code_size = 31;
+
+static u32 reverse_bits(u32 value, const size_t size)
+{
+    u32 result = 0;
+    for (const auto i : algo::range(size))
+    {
+        result = (result << 1) | (value & 1);
+        value >>= 1;
+    }
+    return result;
+}
+
+static size_t get_depth(
+    const std::vector<u32> &children, const u32 node, const size_t limit)
+{
+    if (!limit || node & HuffmanTable::leaf_flag)
+        return 0;
+    if (node >= children.size() / 2)
+        throw err::CorruptDataError("Invalid Huffman tree");
+    return 1 + std::max(
+        get_depth(children, children[node * 2], limit - 1),
+        get_depth(children, children[node * 2 + 1], limit - 1));
+}
+
+HuffmanTable::HuffmanTable(
+    const std::vector<u32> &children,
+    const u32 root,
+    const HuffmanBitOrder bit_order,
+    const size_t max_lookup_bits)
+    : children(children), bit_order(bit_order)
+{
+    // missing_node has leaf_flag set, so it stops the descent too
+    lookup_bits = get_depth(children, root, max_lookup_bits);
+    table.resize(1 << lookup_bits, Entry {0, 0, EntryType::Missing});
+    fill(root, 0, 0);
+}
+
+void HuffmanTable::fill(const u32 node, const u32 code, const size_t size)
+{
+    if (node == missing_node)
+        return;
+
+    if (size < lookup_bits && !(node & leaf_flag))
+    {
+        fill(children[node * 2], code << 1, size + 1);
+        fill(children[node * 2 + 1], (code << 1) | 1, size + 1);
+        return;
+    }
+
+    Entry entry;
+    entry.size = size;
+    if (node & leaf_flag)
+    {
+        entry.type = EntryType::Leaf;
+        entry.value = node & ~leaf_flag;
+    }
+    else
+    {
+        entry.type = EntryType::Node;
+        entry.value = node;
+    }
+
+    // replicate the entry for every value of the bits past the code
+    const auto padding_bits = lookup_bits - size;
+    for (const auto suffix : algo::range(1 << padding_bits))
+    {
+        const auto index = bit_order == HuffmanBitOrder::MsbFirst
+            ? (code << padding_bits) | suffix
+            : reverse_bits(code, size) | (suffix << size);
+        table[index] = entry;
+    }
+}
+
+u32 HuffmanTable::walk(const u32 node, const u32 bit) const
+{
+    if (node >= children.size() / 2)
+        throw err::CorruptDataError("Invalid Huffman tree");
+    const auto child = children[node * 2 + bit];
+    if (child == missing_node)
+        throw err::CorruptDataError("Invalid Huffman code");
+    return child;
+}
+
+HuffmanTable HuffmanTable::from_code_sizes(
+    const std::vector<u8> &code_sizes,
+    const HuffmanBitOrder bit_order,
+    const size_t max_lookup_bits)
+{
+    std::vector<u32> symbols;
+    for (const auto symbol : algo::range(code_sizes.size()))
+    {
+        if (code_sizes[symbol] > max_code_size)
+            throw err::CorruptDataError("Huffman code is too long");
+        if (code_sizes[symbol])
+            symbols.push_back(symbol);
+    }
+    std::stable_sort(
+        symbols.begin(),
+        symbols.end(),
+        [&](const u32 a, const u32 b)
+        {
+            return code_sizes[a] < code_sizes[b];
+        });
+
+    std::vector<u32> children = {missing_node, missing_node};
+    u32 code = 0;
+    size_t size = 0;
+    for (const auto symbol : symbols)
+    {
+        code <<= code_sizes[symbol] - size;
+        size = code_sizes[symbol];
+        if (code >> size)
+            throw err::CorruptDataError("Oversubscribed Huffman code");
+
+        u32 node = 0;
+        for (size_t i = size - 1; i > 0; i--)
+        {
+            const auto child_index = node * 2 + ((code >> i) & 1);
+            if (children[child_index] == missing_node)
+            {
+                children[child_index] = children.size() / 2;
+                children.push_back(missing_node);
+                children.push_back(missing_node);
+            }
+            node = children[child_index];
+        }
+        children[node * 2 + (code & 1)] = symbol | leaf_flag;
+        code++;
+    }
+
+    return HuffmanTable(children, 0, bit_order, max_lookup_bits);
+}
@@ -0,0 +1,112 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <vector>
+#include "err.h"
+#include "types.h"
+
+namespace au {
+namespace algo {
+namespace pack {
+
+    enum class HuffmanBitOrder : u8
+    {
+        // the first bit of a code is the most significant bit of the input
+        // bytes, as read by io::MsbBitReader
+        MsbFirst,
+
+        // the first bit of a code is the least significant bit of the input
+        // bytes, as read by io::LsbBitReader
+        LsbFirst,
+    };
+
+    // Decodes prefix codes with a table indexed by the next few input bits.
+    // Codes that fit in the table take one lookup; longer codes continue
+    // one bit at a time through the tree the table was built from.
+    class HuffmanTable final
+    {
+    public:
+        static const u32 leaf_flag = 0x80000000;
+        static const u32 missing_node = 0xFFFFFFFF;
+
+        // children holds two entries per internal node: the node reached
+        // with bit 0 and the node reached with bit 1. An entry is either an
+        // index of another internal node, a symbol ORed with leaf_flag or
+        // missing_node for codes that must not appear. root has the same
+        // form.
+        HuffmanTable(
+            const std::vector<u32> &children,
+            const u32 root,
+            const HuffmanBitOrder bit_order,
+            const size_t max_lookup_bits = 10);
+
+        // Assigns canonical codes: shorter codes come first, codes of the
+        // same size are ordered by their symbol. Zero size means the
+        // symbol doesn't appear.
+        static HuffmanTable from_code_sizes(
+            const std::vector<u8> &code_sizes,
+            const HuffmanBitOrder bit_order,
+            const size_t max_lookup_bits = 10);
+
+        // T is io::MsbBitReader or io::LsbBitReader, matching bit_order.
+        template<typename T> inline u32 decode(T &reader) const;
+
+    private:
+        enum class EntryType : u8
+        {
+            Missing,
+            Leaf,
+            Node,
+        };
+
+        struct Entry final
+        {
+            u32 value;
+            u8 size;
+            EntryType type;
+        };
+
+        void fill(const u32 node, const u32 code, const size_t size);
+        u32 walk(const u32 node, const u32 bit) const;
+
+        std::vector<u32> children;
+        std::vector<Entry> table;
+        HuffmanBitOrder bit_order;
+        size_t lookup_bits;
+    };
+
+    template<typename T> inline u32 HuffmanTable::decode(T &reader) const
+    {
+        const auto &entry = table[reader.peek(lookup_bits)];
+        if (entry.type == EntryType::Leaf)
+        {
+            reader.consume(entry.size);
+            return entry.value;
+        }
+        if (entry.type == EntryType::Missing)
+            throw err::CorruptDataError("Invalid Huffman code");
+        reader.consume(lookup_bits);
+        auto node = entry.value;
+        do
+            node = walk(node, reader.read(1));
+        while (!(node & leaf_flag));
+        return node & ~leaf_flag;
+    }
+
+} } }
@@ -16,16 +16,31 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "algo/pack/lzss.h"
-#include <array>
-#include "algo/ptr.h"
+#include "algo/pack/lzss_engine.h"
 #include "algo/range.h"
 #include "io/memory_byte_stream.h"
+#include "io/msb_bit_reader.h"
 #include "io/msb_bit_stream.h"
 
 using namespace au;
 
 namespace
 {
+    struct BytewiseLzssFormat final
+    {
+        static const bool msb_first_flags = false;
+        static const bool literal_flag = true;
+        static const u8 input_mask = 0;
+        static const size_t extended_match_size = 0;
+
+        static inline void decode_match(
+            const u8 lo, const u8 hi, size_t &position, size_t &size)
+        {
+            position = lo | ((hi & 0xF0) << 4);
+            size = (hi & 0xF) + 3;
+        }
+    };
+
     struct LzssEncoderState final
     {
         LzssEncoderState(const size_t dict_size, const size_t max_match_size);
@@ -154,6 +169,38 @@ bstr BytewiseLzssWriter::retrieve()
     return byte_stream.seek(0).read_to_eof();
 }
 
+template<typename T> static bstr lzss_decompress_bitwise(
+    T &input_stream,
+    const size_t output_size,
+    const algo::pack::BitwiseLzssSettings &settings)
+{
+    algo::pack::LzssWindow window(
+        1 << settings.position_bits, settings.initial_dictionary_pos);
+
+    bstr output(output_size);
+    auto output_ptr = output.get<u8>();
+    const auto output_end = output.end<const u8>();
+    while (output_ptr < output_end)
+    {
+        if (input_stream.read(1))
+        {
+            const auto b = input_stream.read(8);
+            *output_ptr++ = b;
+            window.put(b);
+        }
+        else
+        {
+            const auto look_behind_pos
+                = input_stream.read(settings.position_bits);
+            const auto repetitions = input_stream.read(settings.size_bits)
+                + settings.min_match_size;
+            output_ptr += window.copy(
+                look_behind_pos, repetitions, output_ptr, output_end);
+        }
+    }
+    return output;
+}
+
 algo::pack::BytewiseLzssSettings::BytewiseLzssSettings()
     : initial_dictionary_pos(0xFEE)
 {
@@ -164,8 +211,8 @@ bstr algo::pack::lzss_decompress(
     const size_t output_size,
     const BitwiseLzssSettings &settings)
 {
-    io::MsbBitStream bit_stream(input);
-    return lzss_decompress(bit_stream, output_size, settings);
+    io::MsbBitReader reader(input);
+    return lzss_decompress_bitwise(reader, output_size, settings);
 }
 
 bstr algo::pack::lzss_decompress(
@@ -173,38 +220,7 @@ bstr algo::pack::lzss_decompress(
     const size_t output_size,
     const BitwiseLzssSettings &settings)
 {
-    std::vector<u8> dict(1 << settings.position_bits, 0);
-    auto dict_ptr
-        = algo::make_cyclic_ptr(dict.data(), dict.size())
-        + settings.initial_dictionary_pos;
-
-    bstr output(output_size);
-    auto output_ptr = algo::make_ptr(output);
-    while (output_ptr.left())
-    {
-        if (input_stream.read(1))
-        {
-            const auto b = input_stream.read(8);
-            *output_ptr++ = b;
-            *dict_ptr++ = b;
-        }
-        else
-        {
-            auto look_behind_pos = input_stream.read(settings.position_bits);
-            auto repetitions = input_stream.read(settings.size_bits)
-                + settings.min_match_size;
-            auto source_ptr
-                = algo::make_cyclic_ptr(dict.data(), dict.size())
-                + look_behind_pos;
-            while (repetitions-- && output_ptr.left())
-            {
-                const auto b = *source_ptr++;
-                *output_ptr++ = b;
-                *dict_ptr++ = b;
-            }
-        }
-    }
-    return output;
+    return lzss_decompress_bitwise(input_stream, output_size, settings);
 }
 
 bstr algo::pack::lzss_decompress(
@@ -212,49 +228,15 @@ bstr algo::pack::lzss_decompress(
     const size_t output_size,
     const BytewiseLzssSettings &settings)
 {
-    std::array<u8, 0x1000> dict = {0};
-    auto dict_ptr
-        = algo::make_cyclic_ptr(dict.data(), dict.size())
-        + settings.initial_dictionary_pos;
-
+    LzssWindow window(0x1000, settings.initial_dictionary_pos);
     bstr output(output_size);
-    auto output_ptr = algo::make_ptr(output);
-    auto input_ptr = algo::make_ptr(input);
-
-    u16 control = 0;
-    while (output_ptr.left())
-    {
-        control >>= 1;
-        if (!(control & 0x100))
-        {
-            if (!input_ptr.left()) break;
-            control = *input_ptr++ | 0xFF00;
-        }
-        if (control & 1)
-        {
-            if (!input_ptr.left()) break;
-            const auto b = *input_ptr++;
-            *output_ptr++ = b;
-            *dict_ptr++ = b;
-        }
-        else
-        {
-            if (input_ptr.left() < 2) break;
-            const auto lo = *input_ptr++;
-            const auto hi = *input_ptr++;
-            const auto look_behind_pos = lo | ((hi & 0xF0) << 4);
-            auto repetitions = (hi & 0xF) + 3;
-            auto source_ptr
-                = algo::make_cyclic_ptr(dict.data(), dict.size())
-                + look_behind_pos;
-            while (repetitions-- && output_ptr.left())
-            {
-                const auto b = *source_ptr++;
-                *output_ptr++ = b;
-                *dict_ptr++ = b;
-            }
-        }
-    }
+    auto input_ptr = input.get<const u8>();
+    lzss_decompress_bytewise<BytewiseLzssFormat>(
+        input_ptr,
+        input.end<const u8>(),
+        output.get<u8>(),
+        output.end<const u8>(),
+        window);
     return output;
 }
 
@@ -0,0 +1,49 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "algo/pack/lzss_engine.h"
+
+using namespace au;
+using namespace au::algo::pack;
+
+LzssWindow::LzssWindow(const size_t size, const size_t initial_pos)
+    : buffer(size), mask(size - 1), pos(initial_pos & (size - 1))
+{
+}
+
+u8 *LzssWindow::data()
+{
+    return buffer.data();
+}
+
+size_t LzssWindow::size() const
+{
+    return buffer.size();
+}
+
+size_t LzssWindow::copy_slow(size_t src, const size_t n, u8 *output_ptr)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        const auto c = buffer[src];
+        *output_ptr++ = c;
+        buffer[pos] = c;
+        src = (src + 1) & mask;
+        pos = (pos + 1) & mask;
+    }
+    return n;
+}
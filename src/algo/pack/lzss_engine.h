@@ -0,0 +1,182 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "types.h"
+
+namespace au {
+namespace algo {
+namespace pack {
+
+    // Sliding window shared by the LZSS decoders. Matches that neither wrap
+    // around the window nor read bytes they produce themselves are copied in
+    // blocks; everything else goes through the byte loop.
+    class LzssWindow final
+    {
+    public:
+        // size must be a power of two.
+        LzssWindow(const size_t size, const size_t initial_pos);
+
+        u8 *data();
+        size_t size() const;
+
+        inline void put(const u8 c)
+        {
+            buffer[pos] = c;
+            pos = (pos + 1) & mask;
+        }
+
+        // Copies up to size bytes starting at source_pos to both the output
+        // and the window. Returns the number of bytes written.
+        inline size_t copy(
+            const size_t source_pos,
+            const size_t size,
+            u8 *output_ptr,
+            const u8 *output_end)
+        {
+            const auto src = source_pos & mask;
+            const auto dst = pos;
+            const auto n = std::min<size_t>(size, output_end - output_ptr);
+            if (src + n <= buffer.size()
+                && dst + n <= buffer.size()
+                && (dst <= src || dst >= src + n))
+            {
+                copy_block(output_ptr, &buffer[src], n);
+                copy_block(&buffer[dst], output_ptr, n);
+                pos = (dst + n) & mask;
+                return n;
+            }
+            return copy_slow(src, n, output_ptr);
+        }
+
+    private:
+        static inline void copy_block(u8 *target, const u8 *source, size_t n)
+        {
+            while (n >= 16)
+            {
+                std::memcpy(target, source, 16);
+                target += 16;
+                source += 16;
+                n -= 16;
+            }
+            if (n >= 8)
+            {
+                std::memcpy(target, source, 8);
+                target += 8;
+                source += 8;
+                n -= 8;
+            }
+            while (n--)
+                *target++ = *source++;
+        }
+
+        size_t copy_slow(size_t src, const size_t n, u8 *output_ptr);
+
+        std::vector<u8> buffer;
+        size_t mask;
+        size_t pos;
+    };
+
+    // Decodes byte-oriented LZSS, where every flag byte describes the next
+    // eight literals or matches. The layout is described by Format:
+    //
+    // struct Format final
+    // {
+    //     // true if flags are consumed starting from the highest bit
+    //     static const bool msb_first_flags;
+    //     // value of the flag bit that marks a literal
+    //     static const bool literal_flag;
+    //     // XORed with every input byte
+    //     static const u8 input_mask;
+    //     // match size that is followed by an extra size byte, or 0
+    //     static const size_t extended_match_size;
+    //     // splits a match into its window position and size
+    //     static void decode_match(
+    //         const u8 lo, const u8 hi, size_t &position, size_t &size);
+    // };
+    //
+    // Stops when either the output is full or the input runs out, leaving
+    // input_ptr past the last consumed byte. Returns the number of bytes
+    // written.
+    template<typename Format> size_t lzss_decompress_bytewise(
+        const u8 *&input_ptr,
+        const u8 *input_end,
+        u8 *output_start,
+        const u8 *output_end,
+        LzssWindow &window)
+    {
+        auto output_ptr = output_start;
+        u16 control = 0;
+        while (output_ptr < output_end)
+        {
+            bool flag;
+            if (Format::msb_first_flags)
+            {
+                control <<= 1;
+                if (!(control & 0x80))
+                {
+                    if (input_ptr >= input_end)
+                        break;
+                    control = ((*input_ptr++ ^ Format::input_mask) << 8) | 0xFF;
+                }
+                flag = control & 0x8000;
+            }
+            else
+            {
+                control >>= 1;
+                if (!(control & 0x100))
+                {
+                    if (input_ptr >= input_end)
+                        break;
+                    control = (*input_ptr++ ^ Format::input_mask) | 0xFF00;
+                }
+                flag = control & 1;
+            }
+
+            if (flag == Format::literal_flag)
+            {
+                if (input_ptr >= input_end)
+                    break;
+                const u8 c = *input_ptr++ ^ Format::input_mask;
+                *output_ptr++ = c;
+                window.put(c);
+                continue;
+            }
+
+            if (input_end - input_ptr < 2)
+                break;
+            const u8 lo = *input_ptr++ ^ Format::input_mask;
+            const u8 hi = *input_ptr++ ^ Format::input_mask;
+            size_t position, size;
+            Format::decode_match(lo, hi, position, size);
+            if (Format::extended_match_size
+                && size == Format::extended_match_size)
+            {
+                if (input_ptr >= input_end)
+                    break;
+                size += *input_ptr++ ^ Format::input_mask;
+            }
+            output_ptr += window.copy(position, size, output_ptr, output_end);
+        }
+        return output_ptr - output_start;
+    }
+
+} } }
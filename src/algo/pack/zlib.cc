@@ -17,23 +17,38 @@
 
 #include "algo/pack/zlib.h"
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <zlib.h>
 #include "algo/format.h"
 #include "err.h"
-#include "io/memory_byte_stream.h"
 
 using namespace au;
 using namespace au::algo::pack;
 
-static const int buffer_size = 8192;
+namespace
+{
+    using InputFunc = std::function<void(z_stream &s)>;
+    using OutputFunc = std::function<void(z_stream &s)>;
 
-static bstr process_stream(
-    io::BaseByteStream &input_stream,
+    struct ZlibResult final
+    {
+        size_t input_size;
+        size_t output_size;
+    };
+}
+
+static const size_t input_chunk_size = 0x10000;
+static const size_t min_output_size = 0x1000;
+static const size_t max_zlib_size = std::numeric_limits<uInt>::max();
+
+static ZlibResult process_stream(
     const ZlibKind kind,
     const std::function<int(z_stream &s, const int window_bits)> &init_func,
     const std::function<int(z_stream &s)> &process_func,
     const std::function<int(z_stream &s)> &end_func,
+    const InputFunc &input_func,
+    const OutputFunc &output_func,
     const std::string &error_message)
 {
     const int window_bits
@@ -49,38 +64,18 @@ static bstr process_stream(
     if (init_func(s, window_bits) != Z_OK)
         throw std::logic_error("Failed to initialize zlib stream");
 
-    bstr output, input_chunk, output_chunk(buffer_size);
-    size_t written = 0;
     int ret;
-    const auto initial_pos = input_stream.pos();
     do
     {
         if (s.avail_in == 0)
-        {
-            input_chunk = input_stream.read(
-                std::min<size_t>(input_stream.left(), buffer_size));
-            s.next_in = const_cast<Bytef*>(input_chunk.get<const Bytef>());
-            s.avail_in = input_chunk.size();
-        }
-
-        s.next_out = output_chunk.get<Bytef>();
-        s.avail_out = output_chunk.size();
-
+            input_func(s);
+        if (s.avail_out == 0)
+            output_func(s);
         ret = process_func(s);
-        output += output_chunk.substr(0, s.total_out - written);
-        written = s.total_out;
-        if (ret == Z_BUF_ERROR)
-        {
-            input_chunk += input_stream.read(
-                std::min<size_t>(input_stream.left(), buffer_size));
-            s.next_in = const_cast<Bytef*>(input_chunk.get<const Bytef>());
-            s.avail_in = input_chunk.size();
-        }
     }
     while (ret == Z_OK);
 
-    input_stream.seek(initial_pos + s.total_in);
-    const auto pos = s.next_in - input_chunk.get<const Bytef>();
+    const ZlibResult result = {s.total_in, s.total_out};
     end_func(s);
     if (ret != Z_STREAM_END)
     {
@@ -88,16 +83,54 @@ static bstr process_stream(
             "%s (%s near %x)",
             error_message.c_str(),
             s.msg ? s.msg : "unknown error",
-            pos));
+            result.input_size));
     }
-    return output;
+    return result;
 }
 
-bstr algo::pack::zlib_inflate(
-    io::BaseByteStream &input_stream, const ZlibKind kind)
+// Feeds the whole memory region at once (in as few steps as zlib's 32-bit
+// counters allow).
+static InputFunc make_memory_input(const u8 *input, const size_t input_size)
+{
+    return [=](z_stream &s)
+    {
+        const size_t offset = s.total_in;
+        s.next_in = const_cast<Bytef*>(input + offset);
+        s.avail_in = std::min(input_size - offset, max_zlib_size);
+    };
+}
+
+static InputFunc make_stream_input(
+    io::BaseByteStream &input_stream, bstr &input_chunk)
+{
+    return [&](z_stream &s)
+    {
+        const auto size = std::min<size_t>(
+            input_stream.left(), input_chunk.size());
+        input_stream.read(input_chunk.get<u8>(), size);
+        s.next_in = input_chunk.get<Bytef>();
+        s.avail_in = size;
+    };
+}
+
+// Points zlib past what was written so far, doubling the buffer if it's
+// full so that the total number of copies stays linear.
+static OutputFunc make_growing_output(bstr &output)
+{
+    return [&output](z_stream &s)
+    {
+        const size_t written = s.total_out;
+        if (written == output.size())
+            output.resize(std::max(written * 2, min_output_size));
+        s.next_out = output.get<Bytef>() + written;
+        s.avail_out = std::min(output.size() - written, max_zlib_size);
+    };
+}
+
+static ZlibResult inflate_growing(
+    const ZlibKind kind, const InputFunc &input_func, bstr &output)
 {
     return process_stream(
-        input_stream,
         kind,
         [](z_stream &s, const int window_bits)
         {
@@ -111,13 +144,80 @@ bstr algo::pack::zlib_inflate(
         {
             return inflateEnd(&s);
         },
+        input_func,
+        make_growing_output(output),
         "Failed to inflate zlib stream");
 }
 
+bstr algo::pack::zlib_inflate(
+    io::BaseByteStream &input_stream, const ZlibKind kind)
+{
+    return ::zlib_inflate(input_stream, 0, kind);
+}
+
+bstr algo::pack::zlib_inflate(
+    io::BaseByteStream &input_stream,
+    const size_t size_orig,
+    const ZlibKind kind)
+{
+    const auto initial_pos = input_stream.pos();
+    bstr input_chunk(std::min<uoff_t>(input_stream.left(), input_chunk_size));
+    bstr output(std::min<uoff_t>(
+        size_orig, input_stream.left() * max_deflate_ratio));
+    const auto result = inflate_growing(
+        kind, make_stream_input(input_stream, input_chunk), output);
+    input_stream.seek(initial_pos + result.input_size);
+    output.resize(result.output_size);
+    return output;
+}
+
 bstr algo::pack::zlib_inflate(const bstr &input, const ZlibKind kind)
 {
-    io::MemoryByteStream input_stream(input);
-    return ::zlib_inflate(input_stream, kind);
+    return ::zlib_inflate(input, 0, kind);
+}
+
+bstr algo::pack::zlib_inflate(
+    const bstr &input, const size_t size_orig, const ZlibKind kind)
+{
+    bstr output(size_orig
+        ? std::min(size_orig, input.size() * max_deflate_ratio)
+        : input.size() * 4);
+    const auto result = inflate_growing(
+        kind, make_memory_input(input.get<u8>(), input.size()), output);
+    output.resize(result.output_size);
+    return output;
+}
+
+size_t algo::pack::zlib_inflate(
+    const u8 *input,
+    const size_t input_size,
+    u8 *output,
+    const size_t output_size,
+    const ZlibKind kind)
+{
+    const auto result = process_stream(
+        kind,
+        [](z_stream &s, const int window_bits)
+        {
+            return inflateInit2(&s, window_bits);
+        },
+        [](z_stream &s)
+        {
+            return inflate(&s, Z_NO_FLUSH);
+        },
+        [](z_stream &s)
+        {
+            return inflateEnd(&s);
+        },
+        make_memory_input(input, input_size),
+        [=](z_stream &s)
+        {
+            const size_t written = s.total_out;
+            s.next_out = output + written;
+            s.avail_out = std::min(output_size - written, max_zlib_size);
+        },
+        "Failed to inflate zlib stream");
+    return result.output_size;
 }
 
 bstr algo::pack::zlib_deflate(
@@ -125,28 +225,35 @@ bstr algo::pack::zlib_deflate(
     const ZlibKind kind,
     const CompressionLevel compression_level)
 {
-    io::MemoryByteStream input_stream(input);
-    return process_stream(
-        input_stream,
+    bstr output;
+    const auto result = process_stream(
         kind,
-        [compression_level](z_stream &s, const int window_bits)
+        [&](z_stream &s, const int window_bits)
         {
             std::vector<int> levels = {9, 6, 1, 0};
-            return deflateInit2(
+            const auto ret = deflateInit2(
                 &s,
                 levels.at(static_cast<int>(compression_level)),
                 Z_DEFLATED,
                 window_bits,
                 9,
                 Z_DEFAULT_STRATEGY);
+            if (ret == Z_OK)
+                output.resize(deflateBound(&s, input.size()));
+            return ret;
         },
-        [&input_stream](z_stream &s)
+        [&input](z_stream &s)
         {
-            return deflate(&s, input_stream.left() ? Z_NO_FLUSH : Z_FINISH);
+            const auto finished = s.total_in + s.avail_in == input.size();
+            return deflate(&s, finished ? Z_FINISH : Z_NO_FLUSH);
         },
         [](z_stream &s)
         {
             return deflateEnd(&s);
         },
+        make_memory_input(input.get<u8>(), input.size()),
+        make_growing_output(output),
         "Failed to deflate stream");
+    output.resize(result.output_size);
+    return output;
 }
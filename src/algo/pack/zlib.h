@@ -32,13 +32,41 @@ namespace pack {
         Gzip       = 2, // == PlainZlib + variable header data
     };
 
+    // Deflate can't compress better than roughly 1:1032, so bigger expected
+    // sizes come from corrupt headers and shouldn't be preallocated.
+    static const size_t max_deflate_ratio = 1032;
+
+    // Inflates a stream of unknown size, growing the output geometrically.
+    // Leaves the input stream right after the compressed data.
+    bstr zlib_inflate(
+        io::BaseByteStream &input_stream,
+        const ZlibKind kind = ZlibKind::PlainZlib);
+
+    // Same as above, but preallocates the output for the expected size so
+    // that well-formed streams are inflated in a single pass.
     bstr zlib_inflate(
         io::BaseByteStream &input_stream,
+        const size_t size_orig,
         const ZlibKind kind = ZlibKind::PlainZlib);
 
     bstr zlib_inflate(
         const bstr &input, const ZlibKind kind = ZlibKind::PlainZlib);
 
+    bstr zlib_inflate(
+        const bstr &input,
+        const size_t size_orig,
+        const ZlibKind kind = ZlibKind::PlainZlib);
+
+    // Inflates the given memory region (e.g. a mapped file) straight into
+    // the given destination without any intermediate copies. Returns the
+    // number of written bytes; throws if the output doesn't fit.
+    size_t zlib_inflate(
+        const u8 *input,
+        const size_t input_size,
+        u8 *output,
+        const size_t output_size,
+        const ZlibKind kind = ZlibKind::PlainZlib);
+
     bstr zlib_deflate(
         const bstr &input,
         const ZlibKind kind = ZlibKind::PlainZlib,
@@ -0,0 +1,126 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "algo/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "algo/range.h"
+
+using namespace au;
+
+static std::atomic<size_t> thread_limit(0);
+static std::atomic<size_t> busy_thread_count(0);
+static thread_local bool is_thread_counted = false;
+
+static size_t get_thread_limit()
+{
+    const size_t limit = thread_limit;
+    if (limit)
+        return limit;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Marks up to wanted helper threads as busy; returns how many it got.
+static size_t reserve_threads(const size_t wanted)
+{
+    size_t busy = busy_thread_count;
+    while (true)
+    {
+        const auto limit = get_thread_limit();
+        const auto count = std::min(wanted, busy < limit ? limit - busy : 0);
+        if (!count)
+            return 0;
+        if (busy_thread_count.compare_exchange_weak(busy, busy + count))
+            return count;
+    }
+}
+
+algo::BusyThreadScope::BusyThreadScope() : counted(!is_thread_counted)
+{
+    if (!counted)
+        return;
+    ++busy_thread_count;
+    is_thread_counted = true;
+}
+
+algo::BusyThreadScope::~BusyThreadScope()
+{
+    if (!counted)
+        return;
+    --busy_thread_count;
+    is_thread_counted = false;
+}
+
+void algo::set_thread_limit(const size_t limit)
+{
+    thread_limit = limit;
+}
+
+void algo::run_in_parallel(
+    const size_t task_count,
+    const size_t thread_count,
+    const std::function<void(const size_t)> &func)
+{
+    if (!task_count)
+        return;
+
+    const BusyThreadScope busy_scope;
+    const auto helper_count = reserve_threads(
+        std::min(thread_count ? thread_count : task_count, task_count) - 1);
+
+    std::atomic<size_t> next_task(0);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    const auto work = [&]()
+    {
+        size_t task;
+        while ((task = next_task++) < task_count)
+        {
+            try
+            {
+                func(task);
+            }
+            catch (...)
+            {
+                std::unique_lock<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (const auto i : algo::range(helper_count))
+    {
+        threads.emplace_back([&]()
+        {
+            // already counted by reserve_threads()
+            is_thread_counted = true;
+            work();
+        });
+    }
+    work();
+    for (auto &thread : threads)
+        thread.join();
+    busy_thread_count -= helper_count;
+    if (error)
+        std::rethrow_exception(error);
+}
@@ -0,0 +1,54 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <functional>
+#include "types.h"
+
+namespace au {
+namespace algo {
+
+    // Counts the current thread as busy for as long as the scope lives.
+    // Worker pools wrap every task they run in one, so that nested
+    // run_in_parallel() calls see the cores they already occupy.
+    class BusyThreadScope final
+    {
+    public:
+        BusyThreadScope();
+        ~BusyThreadScope();
+
+    private:
+        bool counted;
+    };
+
+    // Caps the number of busy threads across the whole process
+    // (0 = one per CPU core).
+    void set_thread_limit(const size_t thread_limit);
+
+    // Calls func for every task index in [0, task_count), spreading the
+    // calls over up to thread_count threads (0 = no limit of its own). The
+    // calling thread takes part. Helper threads are started only while the
+    // process-wide thread limit has room, so calls made from a saturated
+    // worker pool run inline. The first exception is rethrown after all
+    // threads have finished.
+    void run_in_parallel(
+        const size_t task_count,
+        const size_t thread_count,
+        const std::function<void(const size_t)> &func);
+
+} }
@@ -19,11 +19,17 @@
 #include "algo/locale.h"
 #include "algo/range.h"
 #include "err.h"
+#include "io/slice_byte_stream.h"
 #include "virtual_file_system.h"
 
 using namespace au;
 using namespace au::dec::abogado;
 
+dec::DecoderSignature DskArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("DSK");
+}
+
 bool DskArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("DSK");
@@ -65,8 +71,10 @@ std::unique_ptr<io::File> DskArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> DskArchiveDecoder::get_linked_formats() const
@@ -142,6 +142,11 @@ static bstr read_single_channel(
     return data;
 }
 
+dec::DecoderSignature KgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool KgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -25,6 +25,9 @@ namespace abogado {
 
     class KgImageDecoder final : public BaseImageDecoder
     {
+    public:
+        DecoderSignature get_signature() const override;
+
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
         res::Image decode_impl(
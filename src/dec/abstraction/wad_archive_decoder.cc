@@ -18,6 +18,7 @@
 #include "dec/abstraction/wad_archive_decoder.h"
 #include "algo/locale.h"
 #include "algo/range.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::abstraction;
@@ -30,6 +31,11 @@ static const std::string read_string(io::BaseByteStream &input_stream)
     return algo::utf8_to_sjis(input_stream.read(name_size)).str();
 }
 
+dec::DecoderSignature WadArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool WadArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -82,8 +88,10 @@ std::unique_ptr<io::File> WadArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> WadArchiveDecoder::get_linked_formats() const
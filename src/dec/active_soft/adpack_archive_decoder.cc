@@ -17,12 +17,18 @@
 
 #include "dec/active_soft/adpack_archive_decoder.h"
 #include "algo/range.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::active_soft;
 
 static const bstr magic = "ADPACK32"_b;
 
+dec::DecoderSignature AdpackArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool AdpackArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -59,8 +65,10 @@ std::unique_ptr<io::File> AdpackArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> AdpackArchiveDecoder::get_linked_formats() const
@@ -25,6 +25,11 @@ using namespace au::dec::active_soft;
 
 static const bstr magic = ".8Bit\x8D\x5D\x8C\xCB\x00"_b;
 
+dec::DecoderSignature Ed8ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Ed8ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -32,6 +32,11 @@ static inline u8 clamp(const u8 input, const u8 min, const u8 max)
     return std::max<u8>(std::min<u8>(input, max), min);
 }
 
+dec::DecoderSignature EdtImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool EdtImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -25,6 +25,9 @@ namespace active_soft {
 
     class EdtImageDecoder final : public BaseImageDecoder
     {
+    public:
+        DecoderSignature get_signature() const override;
+
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
         res::Image decode_impl(
@@ -27,6 +27,11 @@ static const bstr magic = "AFF\x00"_b;
 static const bstr key =
     "\xC8\xBB\x8F\xB7\xED\x43\x99\x4A\xA2\x7E\x5B\xB0\x68\x18\xF8\x88"_b;
 
+dec::DecoderSignature AffFileDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool AffFileDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -33,6 +33,11 @@ static void decrypt(bstr &input)
         input[i] ^= key[i];
 }
 
+dec::DecoderSignature AjpImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool AjpImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -18,12 +18,18 @@
 #include "dec/alice_soft/alk_archive_decoder.h"
 #include "algo/format.h"
 #include "algo/range.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::alice_soft;
 
 static const bstr magic = "ALK0"_b;
 
+dec::DecoderSignature AlkArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool AlkArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -56,8 +62,10 @@ std::unique_ptr<io::File> AlkArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    auto output_file = std::make_unique<io::File>(entry->path, data);
+    auto output_file = std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
     output_file->guess_extension();
     return output_file;
 }
@@ -20,6 +20,7 @@
 #include "algo/range.h"
 #include "algo/str.h"
 #include "err.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::alice_soft;
@@ -102,8 +103,10 @@ std::unique_ptr<io::File> DatArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    auto output_file = std::make_unique<io::File>(entry->path, data);
+    auto output_file = std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
     output_file->guess_extension();
     return output_file;
 }
@@ -26,6 +26,11 @@ static const bstr magic1 = "dcf\x20"_b;
 static const bstr magic2 = "dfdl"_b;
 static const bstr magic3 = "dcgd"_b;
 
+dec::DecoderSignature DcfImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic1);
+}
+
 bool DcfImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic1.size()) == magic1;
@@ -129,6 +129,11 @@ static void apply_alpha(res::Image &image, const bstr &input)
     }
 }
 
+dec::DecoderSignature QntImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool QntImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
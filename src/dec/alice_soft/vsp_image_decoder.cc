@@ -22,6 +22,11 @@
 using namespace au;
 using namespace au::dec::alice_soft;
 
+dec::DecoderSignature VspImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("vsp");
+}
+
 bool VspImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("vsp");
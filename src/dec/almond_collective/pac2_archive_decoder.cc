@@ -33,6 +33,11 @@ namespace
     };
 }
 
+dec::DecoderSignature Pac2ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Pac2ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -387,6 +387,11 @@ Pac3ArchiveDecoder::Pac3ArchiveDecoder()
         });
 }
 
+dec::DecoderSignature Pac3ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Pac3ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -27,6 +27,7 @@ namespace almond_collective {
     {
     public:
         Pac3ArchiveDecoder();
+        DecoderSignature get_signature() const override;
 
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
@@ -22,6 +22,11 @@ using namespace au::dec::almond_collective;
 
 static const auto magic = "TEYL"_b;
 
+dec::DecoderSignature TeylImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool TeylImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -22,6 +22,11 @@ using namespace au::dec::amuse_craft;
 
 static const bstr magic = "BGM\x20"_b;
 
+dec::DecoderSignature BgmAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool BgmAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -25,6 +25,9 @@ namespace amuse_craft {
 
     class BgmAudioDecoder final : public BaseFileDecoder
     {
+    public:
+        DecoderSignature get_signature() const override;
+
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
 
@@ -70,6 +70,11 @@ static bstr decompress(const bstr &input, const size_t size_orig)
     return output;
 }
 
+dec::DecoderSignature PgdC00ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic, 24);
+}
+
 bool PgdC00ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     input_file.stream.seek(24);
@@ -171,6 +171,11 @@ static bstr apply_delta_filter(
     return output;
 }
 
+dec::DecoderSignature PgdGeImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PgdGeImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
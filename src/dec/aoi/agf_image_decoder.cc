@@ -25,6 +25,11 @@ using namespace au::dec::aoi;
 
 static const bstr magic = "AGF\x00"_b;
 
+dec::DecoderSignature AgfImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool AgfImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -19,12 +19,18 @@
 #include "algo/locale.h"
 #include "algo/range.h"
 #include "err.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::aoi;
 
 static const bstr magic = "VF"_b;
 
+dec::DecoderSignature VfsArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool VfsArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (input_file.stream.seek(0).read(magic.size()) != magic)
@@ -103,8 +109,10 @@ std::unique_ptr<io::File> VfsArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> VfsArchiveDecoder::get_linked_formats() const
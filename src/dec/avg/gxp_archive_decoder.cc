@@ -38,6 +38,11 @@ static bstr decrypt(const bstr &input)
     return output;
 }
 
+dec::DecoderSignature GxpArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool GxpArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
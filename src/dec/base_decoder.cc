@@ -43,6 +43,11 @@ void BaseDecoder::add_arg_parser_decorator(
     add_arg_parser_decorator(decorator);
 }
 
+DecoderSignature BaseDecoder::get_signature() const
+{
+    return DecoderSignature();
+}
+
 bool BaseDecoder::is_recognized(io::File &input_file) const
 {
     try
@@ -33,6 +33,8 @@ namespace dec {
         std::vector<ArgParserDecorator>
             get_arg_parser_decorators() const override;
 
+        virtual DecoderSignature get_signature() const override;
+
         virtual bool is_recognized(io::File &input_file) const override;
 
         virtual std::vector<std::string> get_linked_formats() const override;
@@ -100,6 +100,11 @@ bstr BseDecoder::decode()
     return data;
 }
 
+dec::DecoderSignature BseFileDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool BseFileDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
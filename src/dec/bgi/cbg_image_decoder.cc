@@ -46,6 +46,11 @@ static Version get_version(io::BaseByteStream &input_stream)
     return ret;
 }
 
+dec::DecoderSignature CbgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool CbgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
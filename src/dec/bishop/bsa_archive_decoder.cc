@@ -18,12 +18,18 @@
 #include "dec/bishop/bsa_archive_decoder.h"
 #include "algo/range.h"
 #include "err.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::bishop;
 
 static const bstr magic = "BSArc\x00\x00\x00"_b;
 
+dec::DecoderSignature BsaArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool BsaArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -105,8 +111,10 @@ std::unique_ptr<io::File> BsaArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> BsaArchiveDecoder::get_linked_formats() const
@@ -16,12 +16,18 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "dec/bishop/bsc_image_archive_decoder.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::bishop;
 
 static const auto magic = "BSS-Composition"_b;
 
+dec::DecoderSignature BscImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool BscImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -56,8 +62,10 @@ std::unique_ptr<io::File> BscImageArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 static auto _ = dec::register_decoder<BscImageArchiveDecoder>("bishop/bsc");
@@ -25,6 +25,9 @@ namespace bishop {
 
     class BscImageArchiveDecoder final : public BaseArchiveDecoder
     {
+    public:
+        DecoderSignature get_signature() const override;
+
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
 
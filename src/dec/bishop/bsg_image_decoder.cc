@@ -25,6 +25,11 @@ using namespace au::dec::bishop;
 
 static const bstr magic = "BSS-Graphics"_b;
 
+dec::DecoderSignature BsgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool BsgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
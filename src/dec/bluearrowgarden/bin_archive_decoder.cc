@@ -40,6 +40,11 @@ namespace
     };
 }
 
+dec::DecoderSignature BinArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("bin");
+}
+
 bool BinArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("bin"))
@@ -60,7 +65,8 @@ std::unique_ptr<dec::ArchiveMeta> BinArchiveDecoder::read_meta_impl(
     io::MemoryByteStream table_stream(algo::pack::zlib_inflate(
         input_file.stream
             .seek(input_file.stream.size() - 8 - table_size_comp)
-            .read(table_size_comp)));
+            .read(table_size_comp),
+        table_size_orig));
 
     const auto file_count = table_stream.read_le<u32>();
     auto meta = std::make_unique<ArchiveMeta>();
@@ -97,7 +103,8 @@ std::unique_ptr<io::File> BinArchiveDecoder::read_file_impl(
             algo::pack::zlib_inflate(
                 input_file.stream
                     .seek(segment.offset)
-                    .read(segment.size_comp)));
+                    .read(segment.size_comp),
+                segment.size_orig));
     }
     ret->stream.seek(0);
     ret->guess_extension();
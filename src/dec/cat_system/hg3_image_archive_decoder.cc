@@ -114,8 +114,9 @@ static std::unique_ptr<res::Image> decode_img0000(
     const auto ctl_size_comp = input_stream.read_le<u32>();
     const auto ctl_size_orig = input_stream.read_le<u32>();
     const auto data = algo::pack::zlib_inflate(
-        input_stream.read(data_size_comp));
-    const auto ctl = algo::pack::zlib_inflate(input_stream.read(ctl_size_comp));
+        input_stream.read(data_size_comp), data_size_orig);
+    const auto ctl = algo::pack::zlib_inflate(
+        input_stream.read(ctl_size_comp), ctl_size_orig);
 
     io::LsbBitStream ctl_bit_stream(ctl);
     auto copy = ctl_bit_stream.read(1);
@@ -156,6 +157,11 @@ static std::unique_ptr<res::Image> decode_jpeg(
     throw err::NotSupportedError("Not implemented");
 }
 
+dec::DecoderSignature Hg3ImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Hg3ImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -157,6 +157,11 @@ static bstr get_game_id(const ResourceKeys &res_keys)
     return algo::trim_to_zero(bf.decrypt(res_keys.v_code2));
 }
 
+dec::DecoderSignature IntArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool IntArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
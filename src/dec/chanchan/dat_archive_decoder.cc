@@ -120,6 +120,11 @@ static int tell_version(io::BaseByteStream &input_stream)
     return -1;
 }
 
+dec::DecoderSignature DatArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("dat");
+}
+
 bool DatArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("dat"))
@@ -19,12 +19,18 @@
 #include "algo/format.h"
 #include "algo/range.h"
 #include "err.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::cri;
 
 static const bstr magic = "AFS2"_b;
 
+dec::DecoderSignature Afs2ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Afs2ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     input_file.stream.seek(0);
@@ -63,8 +69,10 @@ std::unique_ptr<io::File> Afs2ArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> Afs2ArchiveDecoder::get_linked_formats() const
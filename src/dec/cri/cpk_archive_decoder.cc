@@ -16,13 +16,13 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "dec/cri/cpk_archive_decoder.h"
+#include <algorithm>
 #include <map>
 #include "algo/any.h"
 #include "algo/range.h"
-#include "algo/str.h"
+#include "dec/cri/crilayla.h"
 #include "err.h"
 #include "io/memory_byte_stream.h"
-#include "io/msb_bit_stream.h"
 
 using namespace au;
 using namespace au::dec::cri;
@@ -99,50 +99,6 @@ static bstr read_utf_packet(io::BaseByteStream &input_stream)
         : decrypt_utf_packet(utf_packet);
 }
 
-static bstr decompress_layla(const bstr &input)
-{
-    io::MemoryByteStream input_stream(input);
-    input_stream.seek(layla_magic.size());
-    const auto size_orig = input_stream.read_le<u32>();
-    const auto size_comp = input_stream.read_le<u32>();
-    const auto data_comp = algo::reverse(input_stream.read(size_comp));
-    const auto prefix = input_stream.read_to_eof();
-
-    io::MsbBitStream bit_stream(data_comp);
-    bstr output;
-    output.reserve(size_orig);
-    while (output.size() < size_orig)
-    {
-        if (bit_stream.read(1))
-        {
-            auto repetitions = 3;
-            auto look_behind = bit_stream.read(13) + 3;
-
-            std::vector<size_t> sizes = {5, 3, 2};
-            while (true)
-            {
-                size_t size = 8;
-                if (!sizes.empty())
-                {
-                    size = sizes.back();
-                    sizes.pop_back();
-                }
-                const auto marker = bit_stream.read(size);
-                repetitions += marker;
-                if (marker != (1u << size) - 1)
-                    break;
-            }
-
-            while (repetitions--)
-                output += output.at(output.size() - look_behind);
-        }
-        else
-            output += static_cast<u8>(bit_stream.read(8));
-    }
-
-    return prefix + algo::reverse(output);
-}
-
 static std::vector<Row> parse_utf_packet(const bstr &utf_packet)
 {
     io::MemoryByteStream utf_stream(utf_packet);
@@ -352,6 +308,11 @@ static void read_itoc(
     }
 }
 
+dec::DecoderSignature CpkArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool CpkArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -414,7 +375,7 @@ std::unique_ptr<io::File> CpkArchiveDecoder::read_file_impl(
         .seek(entry->offset)
         .read(entry->size);
     if (data.substr(0, layla_magic.size()) == layla_magic)
-        data = decompress_layla(data);
+        data = crilayla_decompress(data);
     return std::make_unique<io::File>(entry->path, data);
 }
 
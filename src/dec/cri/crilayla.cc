@@ -0,0 +1,121 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dec/cri/crilayla.h"
+#include <algorithm>
+#include <cstring>
+#include "err.h"
+#include "io/memory_byte_stream.h"
+
+using namespace au;
+
+static const bstr magic = "CRILAYLA"_b;
+static const size_t marker_sizes[] = {2, 3, 5};
+
+namespace
+{
+    // Reads bits MSB first, walking the input from its last byte back to
+    // its first one.
+    class ReverseBitReader final
+    {
+    public:
+        ReverseBitReader(const u8 *data, const size_t size)
+            : data(data), left(size), buffer(0), bits_available(0)
+        {
+        }
+
+        inline u32 read(const size_t bits)
+        {
+            while (bits_available < bits)
+            {
+                if (!left)
+                    throw err::EofError();
+                buffer = (buffer << 8) | data[--left];
+                bits_available += 8;
+            }
+            bits_available -= bits;
+            return (buffer >> bits_available) & ((1u << bits) - 1);
+        }
+
+    private:
+        const u8 *data;
+        size_t left;
+        u32 buffer;
+        size_t bits_available;
+    };
+}
+
+bstr dec::cri::crilayla_decompress(const bstr &input)
+{
+    io::MemoryByteStream input_stream(input);
+    input_stream.seek(magic.size());
+    const auto size_orig = input_stream.read_le<u32>();
+    const auto size_comp = input_stream.read_le<u32>();
+    const auto data_comp = input_stream.pos();
+    input_stream.skip(size_comp);
+    const auto prefix_size = input_stream.left();
+
+    // The prefix goes first, the compressed data decodes backwards after it
+    bstr output(prefix_size + size_orig);
+    input_stream.read(output.get<u8>(), prefix_size);
+
+    ReverseBitReader bit_reader(input.get<const u8>() + data_comp, size_comp);
+    const auto output_start = output.get<u8>() + prefix_size;
+    auto output_ptr = output.end<u8>();
+    while (output_ptr > output_start)
+    {
+        if (!bit_reader.read(1))
+        {
+            *--output_ptr = bit_reader.read(8);
+            continue;
+        }
+
+        const auto look_behind = bit_reader.read(13) + 3;
+        size_t repetitions = 3;
+        size_t marker_index = 0;
+        while (true)
+        {
+            const auto size = marker_index < 3
+                ? marker_sizes[marker_index++]
+                : 8;
+            const auto marker = bit_reader.read(size);
+            repetitions += marker;
+            if (marker != (1u << size) - 1)
+                break;
+        }
+
+        if (look_behind > static_cast<size_t>(output.end<u8>() - output_ptr))
+            throw err::CorruptDataError("Look-behind out of bounds");
+        repetitions = std::min<size_t>(
+            repetitions, output_ptr - output_start);
+        if (repetitions <= look_behind)
+        {
+            output_ptr -= repetitions;
+            std::memcpy(output_ptr, output_ptr + look_behind, repetitions);
+        }
+        else
+        {
+            while (repetitions--)
+            {
+                output_ptr--;
+                *output_ptr = output_ptr[look_behind];
+            }
+        }
+    }
+
+    return output;
+}
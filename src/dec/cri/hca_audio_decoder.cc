@@ -192,6 +192,11 @@ static void decode_block(
     }
 }
 
+dec::DecoderSignature HcaAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool HcaAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -21,6 +21,7 @@
 #include "dec/cronus/common.h"
 #include "err.h"
 #include "io/memory_byte_stream.h"
+#include "io/slice_byte_stream.h"
 #include "plugin_manager.h"
 
 using namespace au;
@@ -123,8 +124,10 @@ std::unique_ptr<io::File> PakArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    auto output_file = std::make_unique<io::File>(entry->path, data);
+    auto output_file = std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
     output_file->guess_extension();
     return output_file;
 }
@@ -23,6 +23,11 @@ using namespace au::dec::crowd;
 
 static const auto magic = "cwd format  - version 1.00 -"_b;
 
+dec::DecoderSignature CwdImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool CwdImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
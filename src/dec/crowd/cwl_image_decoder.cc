@@ -25,6 +25,11 @@ using namespace au::dec::crowd;
 
 static const auto magic = "SZDD"_b;
 
+dec::DecoderSignature CwlImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic).add_extension("cwl");
+}
+
 bool CwlImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic
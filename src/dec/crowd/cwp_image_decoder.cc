@@ -24,6 +24,11 @@ using namespace au::dec::crowd;
 
 static const auto magic = "CWDP"_b;
 
+dec::DecoderSignature CwpImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool CwpImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -24,6 +24,11 @@ using namespace au::dec::crowd;
 
 static const bstr magic = "CRM\x00"_b;
 
+dec::DecoderSignature EogAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool EogAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
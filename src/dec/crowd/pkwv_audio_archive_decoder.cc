@@ -42,6 +42,11 @@ namespace
     };
 }
 
+dec::DecoderSignature PkwvAudioArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PkwvAudioArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
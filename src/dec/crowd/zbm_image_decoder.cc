@@ -25,6 +25,11 @@ using namespace au::dec::crowd;
 
 static const auto magic = "SZDD"_b;
 
+dec::DecoderSignature ZbmImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic).add_extension("zbm");
+}
+
 bool ZbmImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic
@@ -46,6 +46,11 @@ AppendixArchiveDecoder::AppendixArchiveDecoder()
             "Specifies plugin for decoding image files."));
 }
 
+dec::DecoderSignature AppendixArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("appendix");
+}
+
 bool AppendixArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("appendix");
@@ -0,0 +1,59 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dec/decoder_signature.h"
+
+using namespace au;
+using namespace au::dec;
+
+DecoderSignature::DecoderSignature() : min_size(0)
+{
+}
+
+DecoderSignature &DecoderSignature::add_magic(
+    const bstr &magic, const uoff_t offset)
+{
+    magics.push_back({offset, magic});
+    return *this;
+}
+
+DecoderSignature &DecoderSignature::add_extension(const std::string &extension)
+{
+    extensions.push_back(extension);
+    return *this;
+}
+
+DecoderSignature &DecoderSignature::set_min_size(const uoff_t min_size)
+{
+    this->min_size = min_size;
+    return *this;
+}
+
+bool DecoderSignature::empty() const
+{
+    return magics.empty() && extensions.empty() && !min_size;
+}
+
+bool DecoderSignature::matches_extension(const io::path &path) const
+{
+    if (extensions.empty())
+        return true;
+    for (const auto &extension : extensions)
+        if (path.has_extension(extension))
+            return true;
+    return false;
+}
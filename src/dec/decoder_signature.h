@@ -0,0 +1,58 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "io/file.h"
+#include "types.h"
+
+namespace au {
+namespace dec {
+
+    // Cheap, declarative preconditions of a decoder's is_recognized_impl.
+    // A file that fails them is never handed to the decoder for probing.
+    // Decoders that declare nothing are always probed.
+    class DecoderSignature final
+    {
+    public:
+        struct Magic final
+        {
+            uoff_t offset;
+            bstr bytes;
+        };
+
+        DecoderSignature();
+
+        // any of the added magics must match
+        DecoderSignature &add_magic(const bstr &magic, const uoff_t offset = 0);
+
+        // any of the added extensions must match
+        DecoderSignature &add_extension(const std::string &extension);
+
+        DecoderSignature &set_min_size(const uoff_t min_size);
+
+        bool empty() const;
+        bool matches_extension(const io::path &path) const;
+
+        std::vector<Magic> magics;
+        std::vector<std::string> extensions;
+        uoff_t min_size;
+    };
+
+} }
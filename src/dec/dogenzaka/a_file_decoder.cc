@@ -62,6 +62,11 @@ static const bstr get_key(const bstr &password)
     return algo::crypt::sha1(password).substr(0, 16);
 }
 
+dec::DecoderSignature AFileDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool AFileDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -17,10 +17,16 @@
 
 #include "dec/dogenzaka/bin_archive_decoder.h"
 #include "algo/range.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::dogenzaka;
 
+dec::DecoderSignature BinArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("bin");
+}
+
 bool BinArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("bin");
@@ -70,8 +76,10 @@ std::unique_ptr<io::File> BinArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    auto file = std::make_unique<io::File>(entry->path, data);
+    auto file = std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
     file->guess_extension();
     return file;
 }
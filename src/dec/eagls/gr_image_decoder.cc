@@ -42,6 +42,11 @@ static size_t guess_output_size(const bstr &data)
     return pixels_start + stride * height * (depth >> 3);
 }
 
+dec::DecoderSignature GrImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("gr");
+}
+
 bool GrImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("gr");
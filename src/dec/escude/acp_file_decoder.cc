@@ -34,6 +34,11 @@ namespace
     };
 }
 
+dec::DecoderSignature AcpFileDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool AcpFileDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -64,6 +64,11 @@ static bstr do_decode(const bstr &input, size_t canvas_size)
     return output;
 }
 
+dec::DecoderSignature AcdImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool AcdImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -66,6 +66,11 @@ McaArchiveDecoder::McaArchiveDecoder()
         });
 }
 
+dec::DecoderSignature McaArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool McaArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -28,6 +28,7 @@ namespace fc01 {
     {
     public:
         McaArchiveDecoder();
+        DecoderSignature get_signature() const override;
 
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
@@ -99,6 +99,11 @@ McgImageDecoder::McgImageDecoder()
         });
 }
 
+dec::DecoderSignature McgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool McgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
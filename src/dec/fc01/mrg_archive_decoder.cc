@@ -55,6 +55,11 @@ static u8 guess_key(const bstr &table_data, size_t file_size)
     return key;
 }
 
+dec::DecoderSignature MrgArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool MrgArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -25,6 +25,11 @@ using namespace au::dec::french_bread;
 
 static const bstr magic = "LLIF"_b;
 
+dec::DecoderSignature Ex3ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Ex3ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
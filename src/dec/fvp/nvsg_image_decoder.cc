@@ -26,6 +26,11 @@ using namespace au::dec::fvp;
 static const bstr hzc1_magic = "hzc1"_b;
 static const bstr nvsg_magic = "NVSG"_b;
 
+dec::DecoderSignature NvsgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(hzc1_magic);
+}
+
 bool NvsgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (input_file.stream.read(hzc1_magic.size()) != hzc1_magic)
@@ -16,57 +16,55 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "dec/glib/custom_lzss.h"
-#include "algo/range.h"
+#include "algo/pack/lzss_engine.h"
+#include "err.h"
 #include "io/memory_byte_stream.h"
 
-// Modified LZSS routines (repetition count is negated)
-
 using namespace au;
 using namespace au::dec;
 
+namespace
+{
+    // Modified LZSS routine (repetition count is negated)
+    struct GlibLzssFormat final
+    {
+        static const bool msb_first_flags = false;
+        static const bool literal_flag = true;
+        static const u8 input_mask = 0;
+        static const size_t extended_match_size = 0;
+
+        static inline void decode_match(
+            const u8 lo, const u8 hi, size_t &position, size_t &size)
+        {
+            position = ((hi & 0xF0) << 4) | lo;
+            size = (~hi & 0xF) + 3;
+        }
+    };
+}
+
 bstr glib::custom_lzss_decompress(const bstr &input, const size_t output_size)
 {
-    io::MemoryByteStream output_stream(input);
-    return glib::custom_lzss_decompress(output_stream, output_size);
+    io::MemoryByteStream input_stream(input);
+    return glib::custom_lzss_decompress(input_stream, output_size);
 }
 
 bstr glib::custom_lzss_decompress(
     io::BaseByteStream &input_stream, const size_t output_size)
 {
-    const size_t dict_size = 0x1000;
-    size_t dict_pos = 0xFEE;
-    u8 dict[dict_size] {};
+    const auto input_pos = input_stream.pos();
+    const auto input = input_stream.read_to_eof();
+    auto input_ptr = input.get<const u8>();
 
+    algo::pack::LzssWindow window(0x1000, 0xFEE);
     bstr output(output_size);
-    auto output_ptr = output.get<u8>();
-    auto output_end = output.end<const u8>();
-
-    u16 control = 0;
-    while (output_ptr < output_end)
-    {
-        control >>= 1;
-        if (!(control & 0x100))
-            control = input_stream.read<u8>() | 0xFF00;
-
-        if (control & 1)
-        {
-            auto byte = input_stream.read<u8>();
-            dict[dict_pos++] = *output_ptr++ = byte;
-            dict_pos %= dict_size;
-            continue;
-        }
-
-        u32 tmp1 = input_stream.read<u8>();
-        u32 tmp2 = input_stream.read<u8>();
-
-        u32 look_behind_pos = (((tmp2 & 0xF0) << 4) | tmp1) % dict_size;
-        u16 repetitions = (~tmp2 & 0xF) + 3;
-        while (repetitions-- && output_ptr < output_end)
-        {
-            dict[dict_pos++] = *output_ptr++ = dict[look_behind_pos++];
-            look_behind_pos %= dict_size;
-            dict_pos %= dict_size;
-        }
-    }
+    const auto written = algo::pack::lzss_decompress_bytewise<GlibLzssFormat>(
+        input_ptr,
+        input.end<const u8>(),
+        output.get<u8>(),
+        output.end<const u8>(),
+        window);
+    input_stream.seek(input_pos + (input_ptr - input.get<const u8>()));
+    if (written < output_size)
+        throw err::EofError();
     return output;
 }
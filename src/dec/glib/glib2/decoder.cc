@@ -0,0 +1,99 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dec/glib/glib2/decoder.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include "algo/range.h"
+
+using namespace au;
+using namespace au::dec::glib::glib2;
+
+using TransformPair = std::pair<TransformFunc, TransformFunc>;
+
+// The plugins only ever pair a few dozen transforms, so the tables are
+// built once and shared by all decoders using the same pair.
+static std::shared_ptr<const bstr> get_table(
+    const Transform &transform1, const Transform &transform2)
+{
+    static std::mutex mutex;
+    static std::map<TransformPair, std::shared_ptr<const bstr>> tables;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    const auto key = TransformPair(transform1.func, transform2.func);
+    const auto it = tables.find(key);
+    if (it != tables.end())
+        return it->second;
+
+    const auto period = std::max(transform1.period, transform2.period);
+    auto table = std::make_shared<bstr>(period << 8);
+    auto *table_ptr = table->get<u8>();
+    for (const auto acc : algo::range(period))
+    for (const auto byte : algo::range(0x100))
+    {
+        *table_ptr++ = transform2.func(transform1.func(byte, acc), acc);
+    }
+    tables[key] = table;
+    return table;
+}
+
+Decoder::Decoder(
+    const std::array<size_t, 4> &src_permutation,
+    const std::array<size_t, 4> &dst_permutation,
+    const Transform &transform1,
+    const Transform &transform2) :
+    src_permutation(src_permutation),
+    dst_permutation(dst_permutation),
+    period_mask(std::max(transform1.period, transform2.period) - 1),
+    table(get_table(transform1, transform2))
+{
+}
+
+bstr Decoder::decode(const bstr &input) const
+{
+    bstr output(input.size());
+    const auto *input_ptr = input.get<const u8>();
+    auto *output_ptr = output.get<u8>();
+    const auto *table_ptr = table->get<const u8>();
+    const auto src0 = src_permutation[0], dst0 = dst_permutation[0];
+    const auto src1 = src_permutation[1], dst1 = dst_permutation[1];
+    const auto src2 = src_permutation[2], dst2 = dst_permutation[2];
+    const auto src3 = src_permutation[3], dst3 = dst_permutation[3];
+
+    size_t acc = 0;
+    const auto aligned_size = input.size() & ~3;
+    while (acc < aligned_size)
+    {
+        const auto *row0 = table_ptr + (((acc + 0) & period_mask) << 8);
+        const auto *row1 = table_ptr + (((acc + 1) & period_mask) << 8);
+        const auto *row2 = table_ptr + (((acc + 2) & period_mask) << 8);
+        const auto *row3 = table_ptr + (((acc + 3) & period_mask) << 8);
+        output_ptr[acc + dst0] = row0[input_ptr[acc + src0]];
+        output_ptr[acc + dst1] = row1[input_ptr[acc + src1]];
+        output_ptr[acc + dst2] = row2[input_ptr[acc + src2]];
+        output_ptr[acc + dst3] = row3[input_ptr[acc + src3]];
+        acc += 4;
+    }
+    while (acc < input.size())
+    {
+        const auto *row = table_ptr + ((acc & period_mask) << 8);
+        output_ptr[acc] = row[input_ptr[acc]];
+        acc++;
+    }
+    return output;
+}
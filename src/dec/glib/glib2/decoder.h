@@ -0,0 +1,61 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include "types.h"
+
+namespace au {
+namespace dec {
+namespace glib {
+namespace glib2  {
+
+    using TransformFunc = u8 (*)(const u8 byte, const size_t acc);
+
+    // Transforms a single byte at given position. Only the lowest bits of
+    // the position matter: func(byte, acc) == func(byte, acc % period),
+    // where period is a power of two no greater than 256.
+    struct Transform final
+    {
+        TransformFunc func;
+        size_t period;
+    };
+
+    class Decoder final
+    {
+    public:
+        Decoder(
+            const std::array<size_t, 4> &src_permutation,
+            const std::array<size_t, 4> &dst_permutation,
+            const Transform &transform1,
+            const Transform &transform2);
+
+        bstr decode(const bstr &input) const;
+
+    private:
+        std::array<size_t, 4> src_permutation;
+        std::array<size_t, 4> dst_permutation;
+        size_t period_mask;
+
+        // transform2(transform1(byte, acc), acc) for every byte and every
+        // position within the period, at (acc << 8) | byte
+        std::shared_ptr<const bstr> table;
+    };
+
+} } } }
@@ -45,22 +45,58 @@ static const std::array<size_t, 4> permutations[] =
     {3, 2, 0, 1},
 };
 
-static const std::function<u8(u8, size_t)> funcs[] =
+static const Transform transforms[] =
 {
-    [](u8 b, size_t acc) { return (b << 5) | (b >> 3); },
-    [](u8 b, size_t acc) { return (b << (8 - (acc & 7))) | (b >> (acc & 7)); },
-    [](u8 b, size_t acc) { return b + acc * (2 * (acc & 1) - 1); },
-    [](u8 b, size_t acc) { return b ^ (0x1100 >> (acc & 7)); },
-    [](u8 b, size_t acc)
     {
-        const auto c = b ^ (0x80 >> (acc & 7));
-        return (c >> (acc & 7)) | (c << (8 - (acc & 7)));
+        [](const u8 b, const size_t acc) -> u8
+        {
+            return (b << 5) | (b >> 3);
+        },
+        1
+    },
+    {
+        [](const u8 b, const size_t acc) -> u8
+        {
+            return (b << (8 - (acc & 7))) | (b >> (acc & 7));
+        },
+        8
+    },
+    {
+        [](const u8 b, const size_t acc) -> u8
+        {
+            return b + acc * (2 * (acc & 1) - 1);
+        },
+        0x100
+    },
+    {
+        [](const u8 b, const size_t acc) -> u8
+        {
+            return b ^ (0x1100 >> (acc & 7));
+        },
+        8
     },
-    [](u8 b, size_t acc) { return b ^ ((b >> 1) & 0x55); },
-    [](u8 b, size_t acc)
     {
-        const auto c = b ^ (acc & 1);
-        return (c << 1) ^ (((c << 1) ^ (c >> 1)) & 0x55);
+        [](const u8 b, const size_t acc) -> u8
+        {
+            const auto c = b ^ (0x80 >> (acc & 7));
+            return (c >> (acc & 7)) | (c << (8 - (acc & 7)));
+        },
+        8
+    },
+    {
+        [](const u8 b, const size_t acc) -> u8
+        {
+            return b ^ ((b >> 1) & 0x55);
+        },
+        1
+    },
+    {
+        [](const u8 b, const size_t acc) -> u8
+        {
+            const auto c = b ^ (acc & 1);
+            return (c << 1) ^ (((c << 1) ^ (c >> 1)) & 0x55);
+        },
+        2
     },
 };
 
@@ -960,14 +996,11 @@ std::unique_ptr<Decoder> MeiPlugin::create_decoder(
     }
 
     const auto mapping = mappings.at(keys[0]);
-    return std::unique_ptr<Decoder>(
-        new Decoder
-        {
-            permutations[mapping.src_permutation_index],
-            permutations[mapping.dst_permutation_index],
-            funcs[mapping.func1_index],
-            funcs[mapping.func2_index],
-        });
+    return std::make_unique<Decoder>(
+        permutations[mapping.src_permutation_index],
+        permutations[mapping.dst_permutation_index],
+        transforms[mapping.func1_index],
+        transforms[mapping.func2_index]);
 }
 
 std::unique_ptr<Decoder> MeiPlugin::create_header_decoder() const
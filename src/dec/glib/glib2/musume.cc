@@ -33,17 +33,50 @@ static const std::array<size_t, 4> permutations[6] =
     {3, 2, 1, 0},
 };
 
-static const std::function<u8(u8, size_t)> funcs[] =
+static const Transform transforms[] =
 {
-    [](u8 byte, size_t acc)
     {
-        return (byte >> (acc & 7)) | (byte << (8 - (acc & 7)));
+        [](const u8 byte, const size_t acc) -> u8
+        {
+            return (byte >> (acc & 7)) | (byte << (8 - (acc & 7)));
+        },
+        8
+    },
+    {
+        [](const u8 byte, const size_t acc) -> u8
+        {
+            return byte ^ acc;
+        },
+        0x100
+    },
+    {
+        [](const u8 byte, const size_t acc) -> u8
+        {
+            return byte ^ 0xFF;
+        },
+        1
+    },
+    {
+        [](const u8 byte, const size_t acc) -> u8
+        {
+            return (byte - 0x64) ^ 0xFF;
+        },
+        1
+    },
+    {
+        [](const u8 byte, const size_t acc) -> u8
+        {
+            return byte + acc;
+        },
+        0x100
+    },
+    {
+        [](const u8 byte, const size_t acc) -> u8
+        {
+            return (byte << 4) | (byte >> 4);
+        },
+        1
     },
-    [](u8 byte, size_t acc) { return byte ^ acc; },
-    [](u8 byte, size_t acc) { return byte ^ 0xFF; },
-    [](u8 byte, size_t acc) { return (byte - 0x64) ^ 0xFF; },
-    [](u8 byte, size_t acc) { return byte + acc; },
-    [](u8 byte, size_t acc) { return (byte << 4) | (byte >> 4); },
 };
 
 static const std::vector<u16> decoder_table
@@ -162,14 +195,11 @@ std::unique_ptr<Decoder> MusumePlugin::create_decoder(
     const auto func1_index = (index / 5) % 6;
     const auto func2_index = index % 5 - ((index % 5 < func1_index) - 1);
 
-    return std::unique_ptr<Decoder>(
-        new Decoder
-        {
-            permutations[src_permutation],
-            permutations[dst_permutation],
-            funcs[func2_index],
-            funcs[func1_index],
-        });
+    return std::make_unique<Decoder>(
+        permutations[src_permutation],
+        permutations[dst_permutation],
+        transforms[func2_index],
+        transforms[func1_index]);
 }
 
 std::unique_ptr<Decoder> MusumePlugin::create_header_decoder() const
@@ -18,23 +18,14 @@
 #pragma once
 
 #include <array>
-#include <functional>
 #include <memory>
-#include "types.h"
+#include "dec/glib/glib2/decoder.h"
 
 namespace au {
 namespace dec {
 namespace glib {
 namespace glib2  {
 
-    struct Decoder final
-    {
-        std::array<size_t, 4> src_permutation;
-        std::array<size_t, 4> dst_permutation;
-        std::function<u8(u8, size_t)> func1;
-        std::function<u8(u8, size_t)> func2;
-    };
-
     class IPlugin
     {
     public:
@@ -52,33 +52,12 @@ static const bstr magic_21 = "GLibArchiveData2.1\x00"_b;
 static const bstr magic_20 = "GLibArchiveData2.0\x00"_b;
 static const size_t header_size = 0x5C;
 
-static bstr decode(const bstr &input, const glib2::Decoder &decoder)
-{
-    bstr output(input.size());
-    u32 acc = 0;
-    while (acc < (input.size() & (~3)))
-    {
-        auto src_index = (acc & (~3)) + decoder.src_permutation[acc & 3];
-        auto dst_index = (acc & (~3)) + decoder.dst_permutation[acc & 3];
-        auto byte = input[src_index];
-        byte = decoder.func2(decoder.func1(byte, acc), acc);
-        output[dst_index] = byte;
-        acc++;
-    }
-    while (acc < input.size())
-    {
-        output[acc] = decoder.func2(decoder.func1(input[acc], acc), acc);
-        acc++;
-    }
-    return output;
-}
-
 static Header read_header(
     io::BaseByteStream &input_stream, const glib2::IPlugin &plugin)
 {
     input_stream.seek(0);
     auto decoder = plugin.create_header_decoder();
-    auto buffer = decode(input_stream.read(header_size), *decoder);
+    auto buffer = decoder->decode(input_stream.read(header_size));
     io::MemoryByteStream header_stream(buffer);
 
     Header header;
@@ -179,7 +158,7 @@ std::unique_ptr<dec::ArchiveMeta> Glib2ArchiveDecoder::read_meta_impl(
     input_file.stream.seek(header.table_offset);
     auto table_data = input_file.stream.read(header.table_size);
     for (const auto &key : header.table_keys)
-        table_data = decode(table_data, *plugin->create_decoder(key));
+        table_data = plugin->create_decoder(key)->decode(table_data);
 
     io::MemoryByteStream table_stream(table_data);
     if (table_stream.read(table_magic.size()) != table_magic)
@@ -243,7 +222,7 @@ std::unique_ptr<io::File> Glib2ArchiveDecoder::read_file_impl(
             chunk_size, entry->size - written);
         auto buffer = input_file.stream.read(current_chunk_size);
         if (decoders[key_id])
-            buffer = decode(buffer, *decoders[key_id]);
+            buffer = decoders[key_id]->decode(buffer);
         output_file->stream.write(buffer);
         key_id++;
         key_id %= 4;
@@ -38,6 +38,11 @@ namespace
     };
 }
 
+dec::DecoderSignature GmlArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool GmlArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
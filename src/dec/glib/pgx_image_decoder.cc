@@ -24,6 +24,11 @@ using namespace au::dec::glib;
 
 static const bstr magic = "PGX\x00"_b;
 
+dec::DecoderSignature PgxImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PgxImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
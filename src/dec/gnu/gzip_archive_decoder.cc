@@ -60,6 +60,11 @@ namespace
     };
 }
 
+dec::DecoderSignature GzipArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool GzipArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     input_file.stream.seek(0);
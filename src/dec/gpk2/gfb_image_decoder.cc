@@ -25,6 +25,11 @@ using namespace au::dec::gpk2;
 
 static const bstr magic = "GFB\x20"_b;
 
+dec::DecoderSignature GfbImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool GfbImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -26,6 +26,11 @@ using namespace au::dec::gs;
 
 static const bstr magic = "GsSYMBOL5BINDATA"_b;
 
+dec::DecoderSignature DatArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool DatArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -24,6 +24,11 @@ using namespace au::dec::gs;
 
 static const bstr magic = "\x00\x00\x04\x00"_b;
 
+dec::DecoderSignature GsImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool GsImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -19,12 +19,18 @@
 #include "algo/pack/lzss.h"
 #include "algo/range.h"
 #include "io/memory_byte_stream.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::gs;
 
 static const bstr magic = "DataPack5\x00\x00\x00\x00\x00\x00\x00"_b;
 
+dec::DecoderSignature PakArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PakArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -72,8 +78,10 @@ std::unique_ptr<io::File> PakArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    auto output_file = std::make_unique<io::File>(entry->path, data);
+    auto output_file = std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
     output_file->guess_extension();
     return output_file;
 }
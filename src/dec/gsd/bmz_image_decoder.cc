@@ -24,6 +24,11 @@ using namespace au::dec::gsd;
 
 static const bstr magic = "ZLC3"_b;
 
+dec::DecoderSignature BmzImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool BmzImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -34,7 +39,8 @@ res::Image BmzImageDecoder::decode_impl(
 {
     input_file.stream.seek(magic.size());
     const auto size_orig = input_file.stream.read_le<u32>();
-    const auto data = algo::pack::zlib_inflate(input_file.stream.read_to_eof());
+    const auto data = algo::pack::zlib_inflate(
+        input_file.stream.read_to_eof(), size_orig);
     const auto pseudo_file = std::make_unique<io::File>(input_file.path, data);
     return dec::microsoft::BmpImageDecoder().decode(logger, *pseudo_file);
 }
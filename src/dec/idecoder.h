@@ -21,6 +21,7 @@
 #include <vector>
 #include "algo/naming_strategies.h"
 #include "arg_parser_decorator.h"
+#include "dec/decoder_signature.h"
 #include "io/file.h"
 
 namespace au {
@@ -28,6 +29,9 @@ namespace dec {
 
     class IDecoderVisitor;
 
+    // Instances are created once and then shared between tasks and threads,
+    // so const methods must be reentrant and must not change the decoder.
+    // Only arg parser decorators may change it, before it is shared.
     class IDecoder
     {
     public:
@@ -38,6 +42,8 @@ namespace dec {
         virtual std::vector<ArgParserDecorator>
             get_arg_parser_decorators() const = 0;
 
+        virtual DecoderSignature get_signature() const = 0;
+
         virtual bool is_recognized(io::File &input_file) const = 0;
 
         virtual std::vector<std::string> get_linked_formats() const = 0;
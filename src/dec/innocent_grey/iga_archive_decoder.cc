@@ -44,6 +44,11 @@ static u32 read_integer(io::BaseByteStream &input_stream)
     return ret >> 1;
 }
 
+dec::DecoderSignature IgaArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool IgaArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -32,6 +32,11 @@ namespace
     };
 }
 
+dec::DecoderSignature PackdatArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PackdatArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
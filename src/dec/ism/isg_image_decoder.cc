@@ -87,6 +87,11 @@ static void unpack_v21(
     }
 }
 
+dec::DecoderSignature IsgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool IsgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -113,6 +113,11 @@ static bstr decode_pixels(const bstr &source, size_t width, size_t height)
     return target;
 }
 
+dec::DecoderSignature PrsImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PrsImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -193,6 +193,11 @@ static bstr decode_v2(
     return samples;
 }
 
+dec::DecoderSignature WadyAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool WadyAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
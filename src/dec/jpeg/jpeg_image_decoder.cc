@@ -25,6 +25,11 @@ using namespace au::dec::jpeg;
 
 static const bstr magic = "\xFF\xD8\xFF"_b;
 
+dec::DecoderSignature JpegImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool JpegImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -39,6 +39,11 @@ algo::NamingStrategy An00ImageArchiveDecoder::naming_strategy() const
     return algo::NamingStrategy::Sibling;
 }
 
+dec::DecoderSignature An00ImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool An00ImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -26,6 +26,9 @@ namespace kaguya {
 
     class An00ImageArchiveDecoder final : public BaseArchiveDecoder
     {
+    public:
+        DecoderSignature get_signature() const override;
+
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
 
@@ -40,6 +40,11 @@ algo::NamingStrategy An10ImageArchiveDecoder::naming_strategy() const
     return algo::NamingStrategy::Sibling;
 }
 
+dec::DecoderSignature An10ImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool An10ImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
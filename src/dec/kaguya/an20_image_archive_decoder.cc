@@ -41,6 +41,11 @@ algo::NamingStrategy An20ImageArchiveDecoder::naming_strategy() const
     return algo::NamingStrategy::Sibling;
 }
 
+dec::DecoderSignature An20ImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool An20ImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
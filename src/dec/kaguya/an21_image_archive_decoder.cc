@@ -42,6 +42,11 @@ algo::NamingStrategy An21ImageArchiveDecoder::naming_strategy() const
     return algo::NamingStrategy::Sibling;
 }
 
+dec::DecoderSignature An21ImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool An21ImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
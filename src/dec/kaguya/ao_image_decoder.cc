@@ -22,6 +22,11 @@ using namespace au::dec::kaguya;
 
 static const bstr magic = "AO"_b;
 
+dec::DecoderSignature AoImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool AoImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -23,6 +23,11 @@ using namespace au::dec::kaguya;
 
 static const bstr magic = "AP-2"_b;
 
+dec::DecoderSignature Ap2ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Ap2ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
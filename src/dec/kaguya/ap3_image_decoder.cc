@@ -23,6 +23,11 @@ using namespace au::dec::kaguya;
 
 static const bstr magic = "AP-3"_b;
 
+dec::DecoderSignature Ap3ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Ap3ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
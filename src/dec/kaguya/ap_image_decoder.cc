@@ -22,6 +22,11 @@ using namespace au::dec::kaguya;
 
 static const bstr magic = "AP"_b;
 
+dec::DecoderSignature ApImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool ApImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (input_file.stream.read(magic.size()) != magic)
@@ -37,6 +37,11 @@ static bstr decompress(const bstr &input, const size_t size_orig)
     return algo::pack::lzss_decompress(input, size_orig, settings);
 }
 
+dec::DecoderSignature Aps3ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Aps3ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -162,6 +162,11 @@ static bstr descramble(const bstr &input)
     return output;
 }
 
+dec::DecoderSignature BmrFileDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool BmrFileDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -33,6 +33,11 @@ namespace
     };
 }
 
+dec::DecoderSignature Link2ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Link2ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -22,6 +22,11 @@ using namespace au::dec::kaguya;
 
 static const auto magic = "LINK4"_b;
 
+dec::DecoderSignature Link4ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Link4ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
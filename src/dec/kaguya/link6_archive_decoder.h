@@ -25,6 +25,9 @@ namespace kaguya {
 
     class Link6ArchiveDecoder final : public BaseLinkArchiveDecoder
     {
+    public:
+        DecoderSignature get_signature() const override;
+
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
         int get_version() const override;
@@ -24,6 +24,11 @@ using namespace au::dec::kaguya;
 
 static const auto magic = "LINK"_b;
 
+dec::DecoderSignature LinkArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool LinkArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (input_file.stream.seek(0).read(magic.size()) != magic)
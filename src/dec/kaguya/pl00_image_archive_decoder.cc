@@ -42,6 +42,11 @@ algo::NamingStrategy Pl00ImageArchiveDecoder::naming_strategy() const
     return algo::NamingStrategy::Sibling;
 }
 
+dec::DecoderSignature Pl00ImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Pl00ImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
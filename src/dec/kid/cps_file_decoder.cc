@@ -56,6 +56,11 @@ static bstr decrypt(
     return output_stream.read_to_eof();
 }
 
+dec::DecoderSignature CpsFileDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool CpsFileDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
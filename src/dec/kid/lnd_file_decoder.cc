@@ -99,6 +99,11 @@ bstr LndFileDecoder::decompress_raw_data(const bstr &input, size_t size_orig)
     return output;
 }
 
+dec::DecoderSignature LndFileDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool LndFileDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -27,6 +27,7 @@ namespace kid {
     {
     public:
         static bstr decompress_raw_data(const bstr &input, size_t size_orig);
+        DecoderSignature get_signature() const override;
 
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
@@ -34,6 +34,11 @@ namespace
     };
 }
 
+dec::DecoderSignature LnkArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool LnkArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -25,6 +25,11 @@ using namespace au::dec::kid;
 
 static const bstr magic = "PRT\x00"_b;
 
+dec::DecoderSignature PrtImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PrtImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -22,6 +22,11 @@ using namespace au::dec::kid;
 
 static const bstr magic = "WAF\x00\x00\x00"_b;
 
+dec::DecoderSignature WafAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool WafAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -25,6 +25,9 @@ namespace kid {
 
     class WafAudioDecoder final : public BaseAudioDecoder
     {
+    public:
+        DecoderSignature get_signature() const override;
+
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
         res::Audio decode_impl(
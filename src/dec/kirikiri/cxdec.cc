@@ -44,44 +44,87 @@ namespace
         std::array<size_t, 6> key_derivation_order3;
     };
 
-    class KeyDeriver final
+    enum class Opcode : u8
+    {
+        LoadImmediate,
+        LoadParameter,
+        LoadControlBlock,
+        Not,
+        Dec,
+        Neg,
+        Inc,
+        SwapBits,
+        XorImmediate,
+        AddImmediate,
+        SubImmediate,
+        Push,
+        PopShr,
+        PopShl,
+        PopAdd,
+        PopSubFrom,
+        PopMul,
+        PopSub,
+    };
+
+    struct Instruction final
+    {
+        Opcode opcode;
+        u32 operand;
+    };
+
+    // Key derivation routine for a single seed, in evaluation order. Empty
+    // when none of the stages fit.
+    using Program = std::vector<Instruction>;
+
+    // The shape of the generated x86 routine depends only on the seed, so
+    // rather than building and running it for every file, this records
+    // what it would compute once per seed.
+    class KeyDerivationCompiler final
     {
     public:
-        KeyDeriver(const CxdecSettings &settings);
-        u32 derive(u32 seed, u32 parameter);
+        KeyDerivationCompiler(const CxdecSettings &settings);
+        Program compile(u32 seed);
 
     private:
         void add_shellcode(const bstr &bytes_s);
+        void emit(const Opcode opcode, const u32 operand = 0);
         u32 rand();
-        u32 derive_for_stage(size_t stage);
-        u32 run_first_stage();
-        u32 run_stage_strategy_0(size_t stage);
-        u32 run_stage_strategy_1(size_t stage);
+        void compile_stage(size_t stage);
+        void compile_first_stage();
+        void compile_stage_strategy_0(size_t stage);
+        void compile_stage_strategy_1(size_t stage);
 
         const CxdecSettings &settings;
-        bstr shellcode;
+        size_t shellcode_size;
+        Program program;
         u32 seed;
-        size_t parameter;
-        u32 control_block_addr;
+    };
+
+    struct CxdecState final
+    {
+        CxdecSettings settings;
+        std::array<Program, 0x80> programs;
     };
 }
 
+static const size_t max_stack_depth = 8;
+
 static bstr u32_to_string(u32 value)
 {
     return bstr(reinterpret_cast<char*>(&value), 4);
 }
 
-KeyDeriver::KeyDeriver(const CxdecSettings &settings) : settings(settings)
+KeyDerivationCompiler::KeyDerivationCompiler(
+    const CxdecSettings &settings) :
+    settings(settings),
+    shellcode_size(0),
+    seed(0)
 {
-    seed = 0;
-    parameter = 0;
-    control_block_addr = reinterpret_cast<size_t>(&settings.control_block);
 }
 
-u32 KeyDeriver::derive(u32 seed, u32 parameter)
+Program KeyDerivationCompiler::compile(u32 seed)
 {
     this->seed = seed;
-    this->parameter = parameter;
 
     // What we do: we try to run a code a few times for different "stages".
     // The first one to succeed yields the key.
@@ -99,26 +142,32 @@ u32 KeyDeriver::derive(u32 seed, u32 parameter)
     {
         try
         {
-            return derive_for_stage(stage);
+            compile_stage(stage);
+            return program;
         }
-        catch (const KeyDerivationError)
+        catch (const KeyDerivationError &)
         {
             continue;
         }
     }
 
-    throw err::NotSupportedError("Failed to derive the key from the parameter");
+    return Program();
 }
 
-void KeyDeriver::add_shellcode(const bstr &bytes)
+void KeyDerivationCompiler::add_shellcode(const bstr &bytes)
 {
     // The execution for current stage must fail when we run code for too long.
-    shellcode += bytes;
-    if (shellcode.size() > 128)
+    shellcode_size += bytes.size();
+    if (shellcode_size > 128)
         throw KeyDerivationError();
 }
 
-u32 KeyDeriver::rand()
+void KeyDerivationCompiler::emit(const Opcode opcode, const u32 operand)
+{
+    program.push_back({opcode, operand});
+}
+
+u32 KeyDerivationCompiler::rand()
 {
     // This is a modified glibc LCG randomization routine. It is used to make
     // the key as random as possible for each file, which is supposed to
@@ -128,9 +177,10 @@ u32 KeyDeriver::rand()
     return seed ^ (old_seed << 16) ^ (old_seed >> 16);
 }
 
-u32 KeyDeriver::derive_for_stage(size_t stage)
+void KeyDerivationCompiler::compile_stage(size_t stage)
 {
-    shellcode = ""_b;
+    shellcode_size = 0;
+    program.clear();
 
     // push edi, push esi, push ebx, push ecx, push edx
     add_shellcode("\x57\x56\x53\x51\x52"_b);
@@ -138,22 +188,19 @@ u32 KeyDeriver::derive_for_stage(size_t stage)
     // mov edi, dword ptr ss:[esp+18] (esp+18 == parameter)
     add_shellcode("\x86\x7C\x24\x18"_b);
 
-    const auto eax = run_stage_strategy_1(stage);
+    compile_stage_strategy_1(stage);
 
     // pop edx, pop ecx, pop ebx, pop esi, pop edi
     add_shellcode("\x5A\x59\x5B\x5E\x5F"_b);
 
     // retn
     add_shellcode("\xC3"_b);
-
-    return eax;
 }
 
-u32 KeyDeriver::run_first_stage()
+void KeyDerivationCompiler::compile_first_stage()
 {
     const auto routine_number = settings.key_derivation_order1[rand() % 3];
 
-    u32 eax;
     switch (routine_number)
     {
         case 0:
@@ -162,46 +209,50 @@ u32 KeyDeriver::run_first_stage()
             add_shellcode("\xB8"_b);
             const auto tmp = rand();
             add_shellcode(u32_to_string(tmp));
-            eax = tmp;
+            emit(Opcode::LoadImmediate, tmp);
             break;
         }
 
         case 1:
             // mov eax, edi
             add_shellcode("\xB8\xC7"_b);
-            eax = parameter;
+            emit(Opcode::LoadParameter);
             break;
 
         case 2:
         {
             // mov esi, &settings.control_block
             add_shellcode("\xBE"_b);
-            add_shellcode(u32_to_string(control_block_addr));
+            add_shellcode(u32_to_string(0));
 
             // mov eax, dword ptr ds:[esi+((rand() & 0x3FF) * 4]
             add_shellcode("\x8B\x86"_b);
             const auto pos = (rand() & 0x3FF) * 4;
             add_shellcode(u32_to_string(pos));
 
-            eax = *reinterpret_cast<const u32*>(&settings.control_block[pos]);
+            emit(
+                Opcode::LoadImmediate,
+                *reinterpret_cast<const u32*>(&settings.control_block[pos]));
             break;
         }
 
         default:
             throw std::logic_error("Bad routine number");
     }
-
-    return eax;
 }
 
-u32 KeyDeriver::run_stage_strategy_0(size_t stage)
+void KeyDerivationCompiler::compile_stage_strategy_0(size_t stage)
 {
     if (stage == 1)
-        return run_first_stage();
+    {
+        compile_first_stage();
+        return;
+    }
 
-    auto eax = (rand() & 1)
-        ? run_stage_strategy_1(stage - 1)
-        : run_stage_strategy_0(stage - 1);
+    if (rand() & 1)
+        compile_stage_strategy_1(stage - 1);
+    else
+        compile_stage_strategy_0(stage - 1);
 
     const auto routine_number = settings.key_derivation_order2[rand() % 8];
 
@@ -210,31 +261,31 @@ u32 KeyDeriver::run_stage_strategy_0(size_t stage)
         case 0:
             // not eax
             add_shellcode("\xF7\xD0"_b);
-            eax ^= 0xFFFFFFFF;
+            emit(Opcode::Not);
             break;
 
         case 1:
             // dec eax
             add_shellcode("\x48"_b);
-            eax--;
+            emit(Opcode::Dec);
             break;
 
         case 2:
             // neg eax
             add_shellcode("\xF7\xD8"_b);
-            eax = static_cast<u32>(-static_cast<s32>(eax));
+            emit(Opcode::Neg);
             break;
 
         case 3:
             // inc eax
             add_shellcode("\x40"_b);
-            eax++;
+            emit(Opcode::Inc);
             break;
 
         case 4:
             // mov esi, &settings.control_block
             add_shellcode("\xBE"_b);
-            add_shellcode(u32_to_string(control_block_addr));
+            add_shellcode(u32_to_string(0));
 
             // and eax, 3ff
             add_shellcode("\x25\xFF\x03\x00\x00"_b);
@@ -242,12 +293,10 @@ u32 KeyDeriver::run_stage_strategy_0(size_t stage)
             // mov eax, dword ptr ds:[esi+eax*4]
             add_shellcode("\x8B\x04\x86"_b);
 
-            eax = *reinterpret_cast<const u32*>(
-                &settings.control_block[(eax & 0x3FF) * 4]);
+            emit(Opcode::LoadControlBlock);
             break;
 
         case 5:
-        {
             // push ebx
             add_shellcode("\x53"_b);
 
@@ -272,14 +321,8 @@ u32 KeyDeriver::run_stage_strategy_0(size_t stage)
             // pop ebx
             add_shellcode("\x5B"_b);
 
-            auto ebx = eax;
-            ebx &= 0xAAAAAAAA;
-            eax &= 0x55555555;
-            ebx >>= 1;
-            eax <<= 1;
-            eax |= ebx;
+            emit(Opcode::SwapBits);
             break;
-        }
 
         case 6:
         {
@@ -287,8 +330,7 @@ u32 KeyDeriver::run_stage_strategy_0(size_t stage)
             add_shellcode("\x35"_b);
             const auto tmp = rand();
             add_shellcode(u32_to_string(tmp));
-
-            eax ^= tmp;
+            emit(Opcode::XorImmediate, tmp);
             break;
         }
 
@@ -300,8 +342,7 @@ u32 KeyDeriver::run_stage_strategy_0(size_t stage)
                 add_shellcode("\x05"_b);
                 const auto tmp = rand();
                 add_shellcode(u32_to_string(tmp));
-
-                eax += tmp;
+                emit(Opcode::AddImmediate, tmp);
             }
             else
             {
@@ -309,8 +350,7 @@ u32 KeyDeriver::run_stage_strategy_0(size_t stage)
                 add_shellcode("\x2D"_b);
                 const auto tmp = rand();
                 add_shellcode(u32_to_string(tmp));
-
-                eax -= tmp;
+                emit(Opcode::SubImmediate, tmp);
             }
             break;
         }
@@ -318,35 +358,37 @@ u32 KeyDeriver::run_stage_strategy_0(size_t stage)
         default:
             throw std::logic_error("Bad routine number");
     }
-
-    return eax;
 }
 
-u32 KeyDeriver::run_stage_strategy_1(size_t stage)
+void KeyDerivationCompiler::compile_stage_strategy_1(size_t stage)
 {
     if (stage == 1)
-        return run_first_stage();
+    {
+        compile_first_stage();
+        return;
+    }
 
     // push ebx
     add_shellcode("\x53"_b);
 
-    auto eax = (rand() & 1)
-        ? run_stage_strategy_1(stage - 1)
-        : run_stage_strategy_0(stage - 1);
+    if (rand() & 1)
+        compile_stage_strategy_1(stage - 1);
+    else
+        compile_stage_strategy_0(stage - 1);
 
     // mov ebx, eax
     add_shellcode("\x89\xC3"_b);
-    const auto ebx = eax;
+    emit(Opcode::Push);
 
-    eax = (rand() & 1)
-        ? run_stage_strategy_1(stage - 1)
-        : run_stage_strategy_0(stage - 1);
+    if (rand() & 1)
+        compile_stage_strategy_1(stage - 1);
+    else
+        compile_stage_strategy_0(stage - 1);
 
     const auto routine_number = settings.key_derivation_order3[rand() % 6];
     switch (routine_number)
     {
         case 0:
-        {
             // push ecx
             add_shellcode("\x51"_b);
 
@@ -362,13 +404,10 @@ u32 KeyDeriver::run_stage_strategy_1(size_t stage)
             // pop ecx
             add_shellcode("\x59"_b);
 
-            const auto ecx = ebx & 0x0F;
-            eax >>= ecx;
+            emit(Opcode::PopShr);
             break;
-        }
 
         case 1:
-        {
             // push ecx
             add_shellcode("\x51"_b);
 
@@ -384,15 +423,13 @@ u32 KeyDeriver::run_stage_strategy_1(size_t stage)
             // pop ecx
             add_shellcode("\x59"_b);
 
-            const auto ecx = ebx & 0x0F;
-            eax <<= ecx;
+            emit(Opcode::PopShl);
             break;
-        }
 
         case 2:
             // add eax, ebx
             add_shellcode("\x01\xD8"_b);
-            eax += ebx;
+            emit(Opcode::PopAdd);
             break;
 
         case 3:
@@ -400,19 +437,19 @@ u32 KeyDeriver::run_stage_strategy_1(size_t stage)
             add_shellcode("\xF7\xD8"_b);
             // add eax, ebx
             add_shellcode("\x01\xD8"_b);
-            eax = ebx - eax;
+            emit(Opcode::PopSubFrom);
             break;
 
         case 4:
             // imul eax, ebx
             add_shellcode("\x0F\xAF\xC3"_b);
-            eax *= ebx;
+            emit(Opcode::PopMul);
             break;
 
         case 5:
             // sub eax, ebx
             add_shellcode("\x29\xD8"_b);
-            eax -= ebx;
+            emit(Opcode::PopSub);
             break;
 
         default:
@@ -421,21 +458,113 @@ u32 KeyDeriver::run_stage_strategy_1(size_t stage)
 
     // pop ebx
     add_shellcode("\x5B"_b);
+}
+
+static u32 run_program(
+    const Program &program, const bstr &control_block, const u32 parameter)
+{
+    if (program.empty())
+    {
+        throw err::NotSupportedError(
+            "Failed to derive the key from the parameter");
+    }
 
+    u32 stack[max_stack_depth];
+    size_t stack_size = 0;
+    u32 eax = 0;
+    for (const auto &instruction : program)
+    {
+        switch (instruction.opcode)
+        {
+            case Opcode::LoadImmediate:
+                eax = instruction.operand;
+                break;
+
+            case Opcode::LoadParameter:
+                eax = parameter;
+                break;
+
+            case Opcode::LoadControlBlock:
+                eax = *reinterpret_cast<const u32*>(
+                    &control_block[(eax & 0x3FF) * 4]);
+                break;
+
+            case Opcode::Not:
+                eax ^= 0xFFFFFFFF;
+                break;
+
+            case Opcode::Dec:
+                eax--;
+                break;
+
+            case Opcode::Neg:
+                eax = static_cast<u32>(-static_cast<s32>(eax));
+                break;
+
+            case Opcode::Inc:
+                eax++;
+                break;
+
+            case Opcode::SwapBits:
+                eax = ((eax & 0x55555555) << 1) | ((eax & 0xAAAAAAAA) >> 1);
+                break;
+
+            case Opcode::XorImmediate:
+                eax ^= instruction.operand;
+                break;
+
+            case Opcode::AddImmediate:
+                eax += instruction.operand;
+                break;
+
+            case Opcode::SubImmediate:
+                eax -= instruction.operand;
+                break;
+
+            case Opcode::Push:
+                stack[stack_size++] = eax;
+                break;
+
+            case Opcode::PopShr:
+                eax >>= stack[--stack_size] & 0x0F;
+                break;
+
+            case Opcode::PopShl:
+                eax <<= stack[--stack_size] & 0x0F;
+                break;
+
+            case Opcode::PopAdd:
+                eax += stack[--stack_size];
+                break;
+
+            case Opcode::PopSubFrom:
+                eax = stack[--stack_size] - eax;
+                break;
+
+            case Opcode::PopMul:
+                eax *= stack[--stack_size];
+                break;
+
+            case Opcode::PopSub:
+                eax -= stack[--stack_size];
+                break;
+        }
+    }
     return eax;
 }
 
 static void decrypt_chunk(
-    KeyDeriver &key_deriver,
+    const CxdecState &state,
     bstr &data,
     u32 hash,
     size_t base_offset,
     size_t size)
 {
-    const auto seed = hash & 0x7F;
+    const auto &program = state.programs[hash & 0x7F];
     hash >>= 7;
-    const auto ret0 = key_deriver.derive(seed, hash);
-    const auto ret1 = key_deriver.derive(seed, hash ^ 0xFFFFFFFF);
+    const auto &control_block = state.settings.control_block;
+    const auto ret0 = run_program(program, control_block, hash);
+    const auto ret1 = run_program(program, control_block, hash ^ 0xFFFFFFFF);
 
     const auto xor0 = (ret0 >> 8) & 0xFF;
     const auto xor1 = (ret0 >> 16) & 0xFF;
@@ -498,7 +627,8 @@ Xp3Plugin au::dec::kirikiri::create_cxdec_plugin(
     plugin.create_decrypt_func = [=](const io::path &arc_path)
         -> std::function<void(bstr &, u32)> // fixes crash in clang
     {
-        CxdecSettings settings;
+        auto state = std::make_shared<CxdecState>();
+        auto &settings = state->settings;
         settings.control_block = control_block.empty()
             ? find_control_block(arc_path)
             : control_block;
@@ -506,17 +636,20 @@ Xp3Plugin au::dec::kirikiri::create_cxdec_plugin(
         settings.key_derivation_order2 = key_derivation_order2;
         settings.key_derivation_order3 = key_derivation_order3;
 
+        KeyDerivationCompiler compiler(settings);
+        for (const auto seed : algo::range(state->programs.size()))
+            state->programs[seed] = compiler.compile(seed);
+
         return [=](bstr &data, u32 adlr_key)
         {
-            KeyDeriver key_deriver(settings);
             const auto hash1 = adlr_key;
             const auto hash2 = (adlr_key >> 16) ^ adlr_key;
             const auto offset1 = 0;
             const auto offset2 = std::min<size_t>(
                 data.size(), (adlr_key & key1) + key2);
-            decrypt_chunk(key_deriver, data, hash1, offset1, offset2);
+            decrypt_chunk(*state, data, hash1, offset1, offset2);
             decrypt_chunk(
-                key_deriver, data, hash2, offset2, data.size() - offset2);
+                *state, data, hash2, offset2, data.size() - offset2);
         };
     };
     return plugin;
@@ -16,24 +16,39 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "dec/kirikiri/tlg/lzss_decompressor.h"
+#include "algo/pack/lzss_engine.h"
 #include "algo/range.h"
 
 using namespace au;
 using namespace au::dec::kirikiri::tlg;
 
+namespace
+{
+    struct TlgLzssFormat final
+    {
+        static const bool msb_first_flags = false;
+        static const bool literal_flag = false;
+        static const u8 input_mask = 0;
+        static const size_t extended_match_size = 18;
+
+        static inline void decode_match(
+            const u8 lo, const u8 hi, size_t &position, size_t &size)
+        {
+            position = lo | ((hi & 0xF) << 8);
+            size = 3 + ((hi & 0xF0) >> 4);
+        }
+    };
+}
+
 struct LzssDecompressor::Priv final
 {
     Priv();
 
-    u8 dictionary[4096];
-    size_t offset;
+    algo::pack::LzssWindow window;
 };
 
-LzssDecompressor::Priv::Priv()
+LzssDecompressor::Priv::Priv() : window(4096, 0)
 {
-    offset = 0;
-    for (const auto i : algo::range(4096))
-        dictionary[i] = 0;
 }
 
 LzssDecompressor::LzssDecompressor() : p(new Priv)
@@ -47,71 +62,18 @@ LzssDecompressor::~LzssDecompressor()
 void LzssDecompressor::init_dictionary(u8 dictionary[4096])
 {
     for (const auto i : algo::range(4096))
-        p->dictionary[i] = dictionary[i];
+        p->window.data()[i] = dictionary[i];
 }
 
 bstr LzssDecompressor::decompress(const bstr &input, size_t output_size)
 {
     bstr output(output_size);
-    u8 *output_ptr = output.get<u8>();
-    const u8 *input_ptr = input.get<u8>();
-    const u8 *input_end = input_ptr + input.size();
-    const u8 *output_end = output_ptr + output.size();
-
-    int flags = 0;
-    while (input_ptr < input_end)
-    {
-        flags >>= 1;
-        if ((flags & 0x100) != 0x100)
-        {
-            if (input_ptr >= input_end)
-                return output;
-            flags = *input_ptr++ | 0xFF00;
-        }
-
-        if ((flags & 1) == 1)
-        {
-            if (input_ptr >= input_end)
-                return output;
-            u8 x0 = *input_ptr++;
-            if (input_ptr >= input_end)
-                return output;
-            u8 x1 = *input_ptr++;
-            size_t position = x0 | ((x1 & 0xF) << 8);
-            size_t size = 3 + ((x1 & 0xF0) >> 4);
-            if (size == 18)
-            {
-                if (input_ptr >= input_end)
-                    return output;
-                size += *input_ptr++;
-            }
-
-            for (const auto j : algo::range(size))
-            {
-                u8 c = p->dictionary[position];
-                if (output_ptr >= output_end)
-                    return output;
-                *output_ptr++ = c;
-                p->dictionary[p->offset] = c;
-                p->offset++;
-                p->offset &= 0xFFF;
-                position++;
-                position &= 0xFFF;
-            }
-        }
-        else
-        {
-            if (input_ptr >= input_end)
-                return output;
-            u8 c = *input_ptr++;
-            if (output_ptr >= output_end)
-                return output;
-            *output_ptr++ = c;
-            p->dictionary[p->offset] = c;
-            p->offset++;
-            p->offset &= 0xFFF;
-        }
-    }
-
+    auto input_ptr = input.get<const u8>();
+    algo::pack::lzss_decompress_bytewise<TlgLzssFormat>(
+        input_ptr,
+        input.end<const u8>(),
+        output.get<u8>(),
+        output.end<const u8>(),
+        p->window);
     return output;
 }
@@ -16,6 +16,7 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "dec/kirikiri/xp3_archive_decoder.h"
+#include <limits>
 #include "algo/locale.h"
 #include "algo/pack/zlib.h"
 #include "algo/range.h"
@@ -214,6 +215,11 @@ static std::unique_ptr<CustomArchiveEntry> read_file_entry(
     return entry;
 }
 
+dec::DecoderSignature Xp3ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(xp3_magic);
+}
+
 bool Xp3ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(xp3_magic.size()) == xp3_magic;
@@ -234,7 +240,7 @@ std::unique_ptr<dec::ArchiveMeta> Xp3ArchiveDecoder::read_meta_impl(
 
     auto table_data = input_file.stream.read(table_size_comp);
     if (table_is_compressed)
-        table_data = algo::pack::zlib_inflate(table_data);
+        table_data = algo::pack::zlib_inflate(table_data, table_size_orig);
     io::MemoryByteStream table_stream(table_data);
 
     auto meta = std::make_unique<CustomArchiveMeta>();
@@ -261,6 +267,23 @@ std::unique_ptr<dec::ArchiveMeta> Xp3ArchiveDecoder::read_meta_impl(
     return std::move(meta);
 }
 
+// Chunks can't be bigger than the archive and deflate can't expand past
+// algo::pack::max_deflate_ratio, so larger sizes come from corrupt tables.
+static uoff_t get_max_size_orig(
+    const SegmChunk &segm_chunk, const uoff_t archive_size)
+{
+    if (!(segm_chunk.flags & 7))
+        return std::min<uoff_t>(segm_chunk.size_orig, archive_size);
+    const auto size_comp
+        = std::min<uoff_t>(segm_chunk.size_comp, archive_size);
+    const auto max_size_comp = std::numeric_limits<uoff_t>::max()
+        / algo::pack::max_deflate_ratio;
+    if (size_comp > max_size_comp)
+        return segm_chunk.size_orig;
+    return std::min<uoff_t>(
+        segm_chunk.size_orig, size_comp * algo::pack::max_deflate_ratio);
+}
+
 std::unique_ptr<io::File> Xp3ArchiveDecoder::read_file_impl(
     const Logger &logger,
     io::File &input_file,
@@ -270,16 +293,63 @@ std::unique_ptr<io::File> Xp3ArchiveDecoder::read_file_impl(
     const auto meta = static_cast<const CustomArchiveMeta*>(&m);
     const auto entry = static_cast<const CustomArchiveEntry*>(&e);
 
-    bstr data;
+    // the sizes come from the file table, so only preallocate as much as
+    // the chunks can really expand to and grow the output past that
+    const auto archive_size = input_file.stream.size();
+    size_t size_orig = 0;
+    for (const auto &segm_chunk : entry->segm_chunks)
+    {
+        const auto max_size_orig
+            = get_max_size_orig(*segm_chunk, archive_size);
+        if (max_size_orig > std::numeric_limits<size_t>::max() - size_orig)
+        {
+            size_orig = 0;
+            break;
+        }
+        size_orig += max_size_orig;
+    }
+
+    bstr data(size_orig);
+    size_t data_pos = 0;
     for (const auto &segm_chunk : entry->segm_chunks)
     {
         const auto data_is_compressed = segm_chunk->flags & 7;
         input_file.stream.seek(segm_chunk->offset);
-        data += data_is_compressed
-            ? algo::pack::zlib_inflate(
-                input_file.stream.read(segm_chunk->size_comp))
-            : input_file.stream.read(segm_chunk->size_orig);
+        if (data_is_compressed)
+        {
+            if (segm_chunk->size_comp > input_file.stream.left())
+                throw err::EofError();
+            const auto segm_data
+                = input_file.stream.read(segm_chunk->size_comp);
+            if (segm_chunk->size_orig <= data.size() - data_pos)
+            {
+                data_pos += algo::pack::zlib_inflate(
+                    segm_data.get<u8>(),
+                    segm_data.size(),
+                    data.get<u8>() + data_pos,
+                    segm_chunk->size_orig);
+            }
+            else
+            {
+                const auto segm_data_orig = algo::pack::zlib_inflate(
+                    segm_data, segm_chunk->size_orig);
+                data.resize(data_pos);
+                data += segm_data_orig;
+                data_pos = data.size();
+            }
+        }
+        else
+        {
+            if (segm_chunk->size_orig > input_file.stream.left())
+                throw err::EofError();
+            if (data_pos + segm_chunk->size_orig > data.size())
+                data.resize(data_pos + segm_chunk->size_orig);
+            input_file.stream.read(
+                data.get<u8>() + data_pos, segm_chunk->size_orig);
+            data_pos += segm_chunk->size_orig;
+        }
     }
+    data.resize(data_pos);
 
     if (meta->decrypt_func)
         meta->decrypt_func(data, entry->adlr_chunk->key);
@@ -19,10 +19,16 @@
 #include "algo/locale.h"
 #include "algo/range.h"
 #include "err.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::kiss;
 
+dec::DecoderSignature ArcArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("arc");
+}
+
 bool ArcArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("arc"))
@@ -69,8 +75,10 @@ std::unique_ptr<io::File> ArcArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> ArcArchiveDecoder::get_linked_formats() const
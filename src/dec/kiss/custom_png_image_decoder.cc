@@ -25,6 +25,11 @@ using namespace au::dec::kiss;
 
 static const bstr magic = "\x89PNG"_b;
 
+dec::DecoderSignature CustomPngImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool CustomPngImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
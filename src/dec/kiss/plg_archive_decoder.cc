@@ -18,12 +18,18 @@
 #include "dec/kiss/plg_archive_decoder.h"
 #include "algo/range.h"
 #include "err.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::kiss;
 
 static const bstr magic = "LIB\x00\x00\x00\x01\x00"_b;
 
+dec::DecoderSignature PlgArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PlgArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     input_file.stream.seek(0);
@@ -59,8 +65,10 @@ std::unique_ptr<io::File> PlgArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> PlgArchiveDecoder::get_linked_formats() const
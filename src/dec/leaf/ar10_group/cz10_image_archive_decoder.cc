@@ -91,6 +91,11 @@ static bstr decompress(
     return output;
 }
 
+dec::DecoderSignature Cz10ImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Cz10ImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
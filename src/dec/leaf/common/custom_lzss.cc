@@ -16,55 +16,43 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "dec/leaf/common/custom_lzss.h"
-#include <array>
-#include "algo/ptr.h"
-#include "algo/range.h"
+#include "algo/pack/lzss_engine.h"
 
 using namespace au;
 using namespace au::dec::leaf;
 
-// Modified LZSS routine
-// - the bit shifts proceed in opposite direction
-// - input is negated
-bstr common::custom_lzss_decompress(const bstr &input, const size_t output_size)
+namespace
 {
-    std::array<u8, 0x1000> dict = {0};
-    auto dict_ptr = algo::make_cyclic_ptr(dict.data(), dict.size()) + 0xFEE;
-    bstr output(output_size);
-    auto output_ptr = algo::make_ptr(output);
-    auto input_ptr = algo::make_ptr(input);
-    u16 control = 0;
-    while (output_ptr.left() && input_ptr.left())
+    // Modified LZSS routine
+    // - the bit shifts proceed in opposite direction
+    // - input is negated
+    struct LeafLzssFormat final
     {
-        control <<= 1;
-        if (!(control & 0x80))
-            control = (~*input_ptr++ << 8) | 0xFF;
+        static const bool msb_first_flags = true;
+        static const bool literal_flag = true;
+        static const u8 input_mask = 0xFF;
+        static const size_t extended_match_size = 0;
 
-        if ((control >> 15) & 1)
+        static inline void decode_match(
+            const u8 lo, const u8 hi, size_t &position, size_t &size)
         {
-            if (!input_ptr.left()) break;
-            const auto b = ~*input_ptr++;
-            *output_ptr++ = b;
-            *dict_ptr++ = b;
-        }
-        else
-        {
-            if (input_ptr.left() < 2) break;
-            const u8 lo = ~*input_ptr++;
-            const u8 hi = ~*input_ptr++;
             const auto tmp = (hi << 8) | lo;
-            const auto look_behind_pos = tmp >> 4;
-            auto repetitions = (tmp & 0xF) + 3;
-            auto source_ptr
-                = algo::make_cyclic_ptr(dict.data(), dict.size())
-                + look_behind_pos;
-            while (repetitions-- && output_ptr.left())
-            {
-                const auto b = *source_ptr++;
-                *output_ptr++ = b;
-                *dict_ptr++ = b;
-            }
+            position = tmp >> 4;
+            size = (tmp & 0xF) + 3;
         }
-    }
+    };
+}
+
+bstr common::custom_lzss_decompress(const bstr &input, const size_t output_size)
+{
+    algo::pack::LzssWindow window(0x1000, 0xFEE);
+    bstr output(output_size);
+    auto input_ptr = input.get<const u8>();
+    algo::pack::lzss_decompress_bytewise<LeafLzssFormat>(
+        input_ptr,
+        input.end<const u8>(),
+        output.get<u8>(),
+        output.end<const u8>(),
+        window);
     return output;
 }
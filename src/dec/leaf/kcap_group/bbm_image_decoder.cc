@@ -22,6 +22,11 @@
 using namespace au;
 using namespace au::dec::leaf;
 
+dec::DecoderSignature BbmImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("bbm");
+}
+
 bool BbmImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("bbm");
@@ -24,6 +24,11 @@ using namespace au::dec::leaf;
 
 static const bstr magic = "BM"_b;
 
+dec::DecoderSignature BjrImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("bjr");
+}
+
 bool BjrImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("bjr");
@@ -110,6 +110,11 @@ static std::unique_ptr<dec::ArchiveMeta> read_meta_v2(
     return meta;
 }
 
+dec::DecoderSignature KcapArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool KcapArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -23,6 +23,11 @@ using namespace au::dec::leaf;
 
 static const bstr magic = "LEAFC64\x00"_b;
 
+dec::DecoderSignature Lc3ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Lc3ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -48,6 +48,11 @@ LeafpackArchiveDecoder::LeafpackArchiveDecoder()
         });
 }
 
+dec::DecoderSignature LeafpackArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool LeafpackArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
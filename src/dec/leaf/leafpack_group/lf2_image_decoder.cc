@@ -23,6 +23,11 @@ using namespace au::dec::leaf;
 
 static const bstr magic = "LEAF256\x00"_b;
 
+dec::DecoderSignature Lf2ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Lf2ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
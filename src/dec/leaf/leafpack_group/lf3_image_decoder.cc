@@ -23,6 +23,11 @@ using namespace au::dec::leaf;
 
 static const bstr magic = "LEAF64K\x00"_b;
 
+dec::DecoderSignature Lf3ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Lf3ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
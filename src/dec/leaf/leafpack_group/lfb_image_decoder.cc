@@ -22,6 +22,11 @@
 using namespace au;
 using namespace au::dec::leaf;
 
+dec::DecoderSignature LfbImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("lfb");
+}
+
 bool LfbImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("lfb");
@@ -77,6 +77,11 @@ static void move_output_ptr(
     }
 }
 
+dec::DecoderSignature LfgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool LfgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
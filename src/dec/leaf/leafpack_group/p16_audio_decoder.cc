@@ -20,6 +20,11 @@
 using namespace au;
 using namespace au::dec::leaf;
 
+dec::DecoderSignature P16AudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("P16");
+}
+
 bool P16AudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("P16");
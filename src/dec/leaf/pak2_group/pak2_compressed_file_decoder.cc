@@ -73,6 +73,11 @@ static bstr decompress(const bstr &src, const size_t size_orig)
     return output;
 }
 
+dec::DecoderSignature Pak2CompressedFileDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic, 4);
+}
+
 bool Pak2CompressedFileDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(4).read(magic.size()) == magic;
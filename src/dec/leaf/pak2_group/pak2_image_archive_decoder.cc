@@ -38,6 +38,11 @@ namespace
     };
 }
 
+dec::DecoderSignature Pak2ImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic, 4);
+}
+
 bool Pak2ImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(4).read(magic.size()) == magic;
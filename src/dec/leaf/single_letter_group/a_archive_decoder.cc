@@ -79,6 +79,11 @@ static bstr decrypt_3(const bstr &input, const u8 key)
     return output;
 }
 
+dec::DecoderSignature AArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool AArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
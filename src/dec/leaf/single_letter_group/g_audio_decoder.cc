@@ -53,6 +53,11 @@ static void write_page(io::BaseByteStream &output_stream, bstr &page)
     output_stream.write(page);
 }
 
+dec::DecoderSignature GAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("g");
+}
+
 bool GAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("g"))
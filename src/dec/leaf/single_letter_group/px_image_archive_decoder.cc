@@ -465,6 +465,11 @@ static void read_meta(
     ::read_meta(input_stream, meta, known_offsets);
 }
 
+dec::DecoderSignature PxImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("px");
+}
+
 bool PxImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("px");
@@ -23,6 +23,11 @@ using namespace au::dec::leaf;
 
 static const bstr magic = "bw\x20\x20"_b;
 
+dec::DecoderSignature WAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("w");
+}
+
 bool WAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("w"))
@@ -26,6 +26,11 @@ using namespace au::dec::liar_soft;
 
 static const bstr magic = "LM"_b;
 
+dec::DecoderSignature LimImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool LimImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (input_file.stream.read(magic.size()) != magic)
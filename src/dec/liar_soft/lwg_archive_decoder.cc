@@ -19,12 +19,18 @@
 #include "algo/locale.h"
 #include "algo/range.h"
 #include "dec/liar_soft/wcg_image_decoder.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::liar_soft;
 
 static const bstr magic = "LG\x01\x00"_b;
 
+dec::DecoderSignature LwgArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool LwgArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -64,8 +70,10 @@ std::unique_ptr<io::File> LwgArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> LwgArchiveDecoder::get_linked_formats() const
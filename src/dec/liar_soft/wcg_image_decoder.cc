@@ -27,6 +27,11 @@ using namespace au::dec::liar_soft;
 
 static const bstr magic = "WG"_b;
 
+dec::DecoderSignature WcgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool WcgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (input_file.stream.read(magic.size()) != magic)
@@ -33,6 +33,11 @@ namespace
     };
 }
 
+dec::DecoderSignature EgrArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("egr");
+}
+
 bool EgrArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("egr");
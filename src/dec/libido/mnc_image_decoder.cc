@@ -23,6 +23,11 @@ using namespace au::dec::libido;
 
 static const bstr magic = "\x48\x48\x36\x10\x0E\x00\x00\x00\x00\x00"_b;
 
+dec::DecoderSignature MncImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool MncImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
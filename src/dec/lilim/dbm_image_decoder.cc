@@ -25,6 +25,11 @@ using namespace au::dec::lilim;
 
 static const bstr magic = "DM"_b;
 
+dec::DecoderSignature DbmImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool DbmImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     input_file.stream.seek(0);
@@ -18,12 +18,18 @@
 #include "dec/lilim/dpk_archive_decoder.h"
 #include "algo/range.h"
 #include "io/msb_bit_stream.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::lilim;
 
 static const bstr magic = "PA"_b;
 
+dec::DecoderSignature DpkArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool DpkArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     input_file.stream.seek(0);
@@ -60,8 +66,10 @@ std::unique_ptr<io::File> DpkArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> DpkArchiveDecoder::get_linked_formats() const
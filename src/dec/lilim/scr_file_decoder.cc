@@ -16,41 +16,21 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "dec/lilim/scr_file_decoder.h"
-#include "io/msb_bit_stream.h"
+#include "algo/pack/huffman.h"
 
 using namespace au;
 using namespace au::dec::lilim;
 
-static int init_huffman(
-    io::BaseBitStream &bit_stream, u16 nodes[2][512], int &size)
+static bstr decode_huffman(const bstr &input, const size_t target_size)
 {
-    if (!bit_stream.read(1))
-        return bit_stream.read(8);
-    const auto pos = size;
-    if (pos > 511)
-        return -1;
-    size++;
-    nodes[0][pos] = init_huffman(bit_stream, nodes, size);
-    nodes[1][pos] = init_huffman(bit_stream, nodes, size);
-    return pos;
+    io::MsbBitReader input_reader(input);
+    const algo::pack::HuffmanTree huffman_tree(input_reader);
+    return algo::pack::decode_huffman(huffman_tree, input_reader, target_size);
 }
 
-static bstr decode_huffman(const bstr &input, const size_t target_size)
+dec::DecoderSignature ScrFileDecoder::get_signature() const
 {
-    bstr output;
-    output.reserve(input.size() * 2);
-    io::MsbBitStream bit_stream(input);
-    u16 nodes[2][512];
-    auto size = 256;
-    auto root = init_huffman(bit_stream, nodes, size);
-    while (output.size() < target_size && bit_stream.left())
-    {
-        auto byte = root;
-        while (byte >= 256 && byte <= 511)
-            byte = nodes[bit_stream.read(1)][byte];
-        output += static_cast<const u8>(byte);
-    }
-    return output;
+    return DecoderSignature().add_extension("scr");
 }
 
 bool ScrFileDecoder::is_recognized_impl(io::File &input_file) const
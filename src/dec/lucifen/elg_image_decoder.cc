@@ -275,6 +275,11 @@ static bstr read_mono(
     return output;
 }
 
+dec::DecoderSignature ElgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool ElgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -85,6 +85,11 @@ static void decrypt_content_2(bstr &data, const u8 key)
         c = algo::rotr<u8>(c ^ key, 4);
 }
 
+dec::DecoderSignature LpkArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool LpkArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
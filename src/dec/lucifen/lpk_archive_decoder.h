@@ -30,6 +30,7 @@ namespace lucifen {
     public:
         LpkArchiveDecoder();
         std::vector<std::string> get_linked_formats() const override;
+        DecoderSignature get_signature() const override;
 
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
@@ -76,6 +76,11 @@ static bstr uncompress(const bstr &input, size_t width, size_t height)
     return output;
 }
 
+dec::DecoderSignature Rc8ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Rc8ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -141,6 +141,11 @@ RctImageDecoder::RctImageDecoder()
         });
 }
 
+dec::DecoderSignature RctImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool RctImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
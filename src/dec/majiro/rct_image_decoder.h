@@ -27,6 +27,7 @@ namespace majiro {
     {
     public:
         RctImageDecoder();
+        DecoderSignature get_signature() const override;
 
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
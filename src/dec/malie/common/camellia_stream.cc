@@ -17,12 +17,38 @@
 
 #include "dec/malie/common/camellia_stream.h"
 #include <cstring>
+#include "algo/endian.h"
 #include "algo/range.h"
-#include "io/memory_byte_stream.h"
+#include "err.h"
 
 using namespace au;
 using namespace au::dec::malie::common;
 
+static const size_t block_size = 16;
+static const size_t window_size = 4096;
+
+static void decrypt_blocks(
+    const algo::crypt::Camellia &camellia,
+    const uoff_t offset,
+    u8 *data,
+    const size_t block_count)
+{
+    u32 input_block[4];
+    u32 output_block[4];
+    for (const auto i : algo::range(block_count))
+    {
+        auto block = data + i * block_size;
+        std::memcpy(input_block, block, block_size);
+        for (const auto j : algo::range(4))
+            input_block[j] = algo::from_little_endian(input_block[j]);
+        camellia.decrypt_block_128(
+            offset + i * block_size, input_block, output_block);
+        for (const auto j : algo::range(4))
+            output_block[j] = algo::to_big_endian(output_block[j]);
+        std::memcpy(block, output_block, block_size);
+    }
+}
+
 CamelliaStream::CamelliaStream(
     io::BaseByteStream &parent_stream, const std::vector<u32> &key)
         : CamelliaStream(parent_stream, key, 0, parent_stream.size())
@@ -37,7 +63,8 @@ CamelliaStream::CamelliaStream(
         key(key),
         parent_stream(parent_stream.clone()),
         parent_stream_offset(offset),
-        parent_stream_size(size)
+        parent_stream_size(size),
+        window_offset(0)
 {
     if (key.size())
         camellia = std::make_unique<algo::crypt::Camellia>(key);
@@ -52,43 +79,81 @@ void CamelliaStream::seek_impl(const uoff_t offset)
     parent_stream->seek(parent_stream_offset + offset);
 }
 
+void CamelliaStream::fill_window(const uoff_t offset, const size_t size)
+{
+    // blocks are aligned to the parent stream rather than to this view
+    const auto start = offset & ~(block_size - 1);
+    const auto needed = (offset + size - start + block_size - 1)
+        & ~(block_size - 1);
+    const auto parent_size = parent_stream->size();
+    const auto available = parent_size > start
+        ? (parent_size - start) & ~(block_size - 1)
+        : 0;
+
+    window.resize(0);
+    window.resize(
+        std::max<uoff_t>(needed, std::min<uoff_t>(available, window_size)));
+    parent_stream->seek(start).read(window.get<u8>(), window.size());
+    decrypt_blocks(
+        *camellia, start, window.get<u8>(), window.size() / block_size);
+    window_offset = start;
+}
+
 void CamelliaStream::read_impl(void *destination, const size_t size)
 {
     if (!camellia)
     {
-        const auto chunk = parent_stream->read(size);
-        std::memcpy(destination, chunk.get<u8>(), size);
+        parent_stream->read(destination, size);
         return;
     }
 
-    const auto old_pos = parent_stream->pos();
-    const auto offset_pad = parent_stream->pos() & 0xF;
-    const auto offset_start = parent_stream->pos() & ~0xF;
-    const auto aligned_size = (offset_pad + size + 0xF) & ~0xF;
-    const auto block_count = (aligned_size + 0xF) / 0x10;
-    if (block_count == 0)
+    const auto offset = parent_stream->pos();
+    auto output = reinterpret_cast<u8*>(destination);
+
+    if (size < window_size)
+    {
+        if (offset < window_offset
+            || offset + size > window_offset + window.size())
+        {
+            fill_window(offset, size);
+        }
+        std::memcpy(
+            output, window.get<const u8>() + (offset - window_offset), size);
+        parent_stream->seek(offset + size);
         return;
+    }
 
-    parent_stream->seek(parent_stream_offset
-        + ((parent_stream->pos() - parent_stream_offset) - offset_pad));
+    // decrypt big reads in place, going through the window only for the
+    // partial blocks at either end
+    const auto head_size = std::min<size_t>(
+        (block_size - (offset & (block_size - 1))) & (block_size - 1), size);
+    if (head_size)
+    {
+        fill_window(offset, head_size);
+        std::memcpy(
+            output,
+            window.get<const u8>() + (offset - window_offset),
+            head_size);
+    }
 
-    io::MemoryByteStream output_stream;
-    output_stream.resize(block_count * 16);
-    output_stream.seek(0);
-    for (const auto i : algo::range(block_count))
+    const auto body_offset = offset + head_size;
+    const auto body_block_count = (size - head_size) / block_size;
+    const auto body_size = body_block_count * block_size;
+    parent_stream->seek(body_offset).read(output + head_size, body_size);
+    decrypt_blocks(
+        *camellia, body_offset, output + head_size, body_block_count);
+
+    const auto tail_offset = body_offset + body_size;
+    const auto tail_size = size - head_size - body_size;
+    if (tail_size)
     {
-        u32 input_block[4];
-        u32 output_block[4];
-        for (const auto j : algo::range(4))
-            input_block[j] = parent_stream->read_le<u32>();
-        camellia->decrypt_block_128(
-            offset_start + i * 0x10, input_block, output_block);
-        for (const auto j : algo::range(4))
-            output_stream.write_be<u32>(output_block[j]);
+        fill_window(tail_offset, tail_size);
+        std::memcpy(
+            output + head_size + body_size,
+            window.get<const u8>() + (tail_offset - window_offset),
+            tail_size);
     }
-    const auto chunk = output_stream.seek(offset_pad).read(size);
-    std::memcpy(destination, chunk.get<u8>(), size);
-    parent_stream->seek(old_pos + size);
+    parent_stream->seek(offset + size);
 }
 
 void CamelliaStream::write_impl(const void *source, const size_t size)
@@ -108,6 +173,7 @@ uoff_t CamelliaStream::size() const
 
 void CamelliaStream::resize_impl(const uoff_t new_size)
 {
+    window.resize(0);
     parent_stream->resize(new_size);
 }
 
@@ -50,11 +50,18 @@ namespace common {
         void resize_impl(const uoff_t new_size) override;
 
     private:
+        void fill_window(const uoff_t offset, const size_t size);
+
         const std::vector<u32> key;
         std::unique_ptr<algo::crypt::Camellia> camellia;
         std::unique_ptr<io::BaseByteStream> parent_stream;
         const uoff_t parent_stream_offset;
         const uoff_t parent_stream_size;
+
+        // Decrypted copy of the parent stream starting at window_offset, so
+        // that small reads don't decrypt the same blocks over and over
+        bstr window;
+        uoff_t window_offset;
     };
 
 } } } }
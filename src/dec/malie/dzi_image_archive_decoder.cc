@@ -82,6 +82,11 @@ static res::Image get_texture_image(
     throw err::FileNotFoundError("Block texture not found");
 }
 
+dec::DecoderSignature DziImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool DziImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -23,6 +23,11 @@ using namespace au::dec::malie;
 
 static const bstr magic = "MalieGF\x00"_b;
 
+dec::DecoderSignature MgfImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool MgfImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
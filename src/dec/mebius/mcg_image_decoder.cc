@@ -91,6 +91,11 @@ static bstr interleave(
     return output;
 }
 
+dec::DecoderSignature McgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool McgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (input_file.stream.read(magic.size()) != magic)
@@ -294,6 +294,11 @@ static res::Image get_image_without_palette(
     return *image;
 }
 
+dec::DecoderSignature BmpImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool BmpImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     input_file.stream.seek(0);
@@ -60,6 +60,20 @@ namespace
         u32 a_bit_mask;
     };
 
+    enum DxgiFormat : u32
+    {
+        DXGI_FORMAT_BC1_UNORM      = 71,
+        DXGI_FORMAT_BC1_UNORM_SRGB = 72,
+        DXGI_FORMAT_BC2_UNORM      = 74,
+        DXGI_FORMAT_BC2_UNORM_SRGB = 75,
+        DXGI_FORMAT_BC3_UNORM      = 77,
+        DXGI_FORMAT_BC3_UNORM_SRGB = 78,
+        DXGI_FORMAT_BC4_UNORM      = 80,
+        DXGI_FORMAT_BC5_UNORM      = 83,
+        DXGI_FORMAT_BC7_UNORM      = 98,
+        DXGI_FORMAT_BC7_UNORM_SRGB = 99,
+    };
+
     struct DdsHeaderDx10 final
     {
         u32 dxgi_format;
@@ -102,6 +116,10 @@ static const bstr magic_dxt3 = "DXT3"_b;
 static const bstr magic_dxt4 = "DXT4"_b;
 static const bstr magic_dxt5 = "DXT5"_b;
 static const bstr magic_dx10 = "DX10"_b;
+static const bstr magic_ati1 = "ATI1"_b;
+static const bstr magic_bc4u = "BC4U"_b;
+static const bstr magic_ati2 = "ATI2"_b;
+static const bstr magic_bc5u = "BC5U"_b;
 
 static void fill_pixel_format(
     io::BaseByteStream &input_stream, DdsPixelFormat &pixel_format)
@@ -148,6 +166,52 @@ static std::unique_ptr<DdsHeaderDx10> read_header_dx10(
     return header;
 }
 
+static BcnFormat get_bcn_format(const bstr &four_cc)
+{
+    if (four_cc == magic_dxt1)
+        return BcnFormat::Bc1;
+    if (four_cc == magic_dxt3)
+        return BcnFormat::Bc2;
+    if (four_cc == magic_dxt5)
+        return BcnFormat::Bc3;
+    if (four_cc == magic_ati1 || four_cc == magic_bc4u)
+        return BcnFormat::Bc4;
+    if (four_cc == magic_ati2 || four_cc == magic_bc5u)
+        return BcnFormat::Bc5;
+    throw err::NotSupportedError(
+        algo::format("%s textures are not supported", four_cc.c_str()));
+}
+
+static BcnFormat get_bcn_format(const u32 dxgi_format)
+{
+    switch (dxgi_format)
+    {
+        case DXGI_FORMAT_BC1_UNORM:
+        case DXGI_FORMAT_BC1_UNORM_SRGB:
+            return BcnFormat::Bc1;
+        case DXGI_FORMAT_BC2_UNORM:
+        case DXGI_FORMAT_BC2_UNORM_SRGB:
+            return BcnFormat::Bc2;
+        case DXGI_FORMAT_BC3_UNORM:
+        case DXGI_FORMAT_BC3_UNORM_SRGB:
+            return BcnFormat::Bc3;
+        case DXGI_FORMAT_BC4_UNORM:
+            return BcnFormat::Bc4;
+        case DXGI_FORMAT_BC5_UNORM:
+            return BcnFormat::Bc5;
+        case DXGI_FORMAT_BC7_UNORM:
+        case DXGI_FORMAT_BC7_UNORM_SRGB:
+            return BcnFormat::Bc7;
+    }
+    throw err::NotSupportedError(
+        algo::format("DXGI format %d is not supported", dxgi_format));
+}
+
+dec::DecoderSignature DdsImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool DdsImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -159,8 +223,9 @@ res::Image DdsImageDecoder::decode_impl(
     input_file.stream.skip(magic.size());
 
     auto header = read_header(input_file.stream);
+    std::unique_ptr<DdsHeaderDx10> header_dx10;
     if (header->pixel_format.four_cc == magic_dx10)
-        read_header_dx10(input_file.stream);
+        header_dx10 = read_header_dx10(input_file.stream);
 
     const auto width = header->width;
     const auto height = header->height;
@@ -168,18 +233,10 @@ res::Image DdsImageDecoder::decode_impl(
     std::unique_ptr<res::Image> image(nullptr);
     if (header->pixel_format.flags & DDPF_FOURCC)
     {
-        if (header->pixel_format.four_cc == magic_dxt1)
-            image = decode_dxt1(input_file.stream, width, height);
-        else if (header->pixel_format.four_cc == magic_dxt3)
-            image = decode_dxt3(input_file.stream, width, height);
-        else if (header->pixel_format.four_cc == magic_dxt5)
-            image = decode_dxt5(input_file.stream, width, height);
-        else
-        {
-            throw err::NotSupportedError(algo::format(
-                "%s textures are not supported",
-                header->pixel_format.four_cc.c_str()));
-        }
+        const auto fmt = header_dx10
+            ? get_bcn_format(header_dx10->dxgi_format)
+            : get_bcn_format(header->pixel_format.four_cc);
+        image = decode_bcn(input_file.stream, fmt, width, height);
     }
     else if (header->pixel_format.flags & DDPF_RGB)
     {
@@ -193,7 +250,7 @@ res::Image DdsImageDecoder::decode_impl(
     if (image == nullptr)
         throw err::NotSupportedError("Unsupported pixel format");
 
-    return *image;
+    return std::move(*image);
 }
 
 static auto _ = dec::register_decoder<DdsImageDecoder>("microsoft/dds");
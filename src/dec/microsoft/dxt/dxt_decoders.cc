@@ -16,24 +16,158 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "dec/microsoft/dxt/dxt_decoders.h"
+#include <algorithm>
+#include <cstring>
+#include "algo/endian.h"
+#include "algo/parallel.h"
 #include "algo/range.h"
+#include "err.h"
 
 using namespace au;
+using namespace au::dec::microsoft::dxt;
 
-static std::unique_ptr<res::Image> create_image(
-    const size_t width, const size_t height)
+namespace
 {
-    return std::make_unique<res::Image>((width + 3) & ~3, (height + 3) & ~3);
+    using BlockDecoder = void (*)(const u8 *, res::Pixel *, const size_t);
+
+    struct BcnFormatInfo final
+    {
+        size_t block_size;
+        BlockDecoder decode_block;
+    };
+
+    struct Bc7Mode final
+    {
+        size_t subset_count;
+        size_t partition_bits;
+        size_t rotation_bits;
+        size_t index_selection_bits;
+        size_t color_bits;
+        size_t alpha_bits;
+        size_t endpoint_pbits;
+        size_t shared_pbits;
+        size_t index_bits;
+        size_t index_bits2;
+    };
+
+    // Reads the 128 bits of a BC7 block, starting with the least
+    // significant bit of the first byte.
+    class Bc7BitReader final
+    {
+    public:
+        Bc7BitReader(const u8 *input) : pos(0)
+        {
+            std::memcpy(words, input, 16);
+            words[0] = algo::from_little_endian(words[0]);
+            words[1] = algo::from_little_endian(words[1]);
+        }
+
+        u32 get(const size_t bits)
+        {
+            const auto word = pos >> 6;
+            const auto shift = pos & 63;
+            u64 value = words[word] >> shift;
+            if (!word && shift + bits > 64)
+                value |= words[1] << (64 - shift);
+            pos += bits;
+            return value & ((1 << bits) - 1);
+        }
+
+    private:
+        u64 words[2];
+        size_t pos;
+    };
 }
 
-static void decode_dxt1_block(
-    io::BaseByteStream &input_stream, res::Pixel output_colors[4][4])
+// decoding rows of blocks in parallel only pays off for large textures; the
+// bands get extra threads only while the process-wide thread limit has room,
+// so textures decoded by busy unpacker workers are decoded inline
+static const size_t parallel_block_count = 128 * 128;
+static const size_t band_block_rows = 8;
+
+static const Bc7Mode bc7_modes[8] =
+{
+    {3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+    {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+    {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+    {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+    {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+    {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+    {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+    {2, 6, 0, 0, 5, 5, 1, 0, 2, 0},
+};
+
+// bit n tells which subset texel n belongs to
+static const u16 bc7_partitions2[64] =
+{
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+// bits 2n and 2n+1 tell which subset texel n belongs to
+static const u32 bc7_partitions3[64] =
+{
+    0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8,
+    0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+    0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090,
+    0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+    0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0,
+    0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+    0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400,
+    0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+    0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424,
+    0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+    0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0,
+    0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+    0xAA444444, 0x54A854A8, 0x95809580, 0x96969600,
+    0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+    0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000,
+    0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+};
+
+// anchor texels of the second subset in 2-subset partitions
+static const u8 bc7_anchors2[64] =
+{
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+
+// anchor texels of the second and third subset in 3-subset partitions
+static const u8 bc7_anchors3[2][64] =
+{
+    {
+         3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+         3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+         8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+         3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+    },
+    {
+        15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+        15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+        15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+        15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+    },
+};
+
+static const u8 bc7_weights2[4] = {0, 21, 43, 64};
+static const u8 bc7_weights3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+static const u8 bc7_weights4[16] =
+    {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+static void decode_color_block(
+    const u8 *input, res::Pixel *output, const size_t stride)
 {
     res::Pixel colors[4];
-    const auto tmp = input_stream.read(4);
-    const auto *tmp_ptr = tmp.get<const u8>();
-    colors[0] = res::read_pixel<res::PixelFormat::BGR565>(tmp_ptr);
-    colors[1] = res::read_pixel<res::PixelFormat::BGR565>(tmp_ptr);
+    colors[0] = res::read_pixel<res::PixelFormat::BGR565>(input);
+    colors[1] = res::read_pixel<res::PixelFormat::BGR565>(input);
     const auto transparent
         = colors[0].b <= colors[1].b
         && colors[0].g <= colors[1].g
@@ -54,115 +188,376 @@ static void decode_dxt1_block(
         }
     }
 
-    auto lookup = input_stream.read_le<u32>();
+    u32 lookup;
+    std::memcpy(&lookup, input, 4);
+    lookup = algo::from_little_endian(lookup);
     for (const auto y : algo::range(4))
-    for (const auto x : algo::range(4))
     {
-        const auto index = lookup & 3;
-        output_colors[y][x] = colors[index];
-        lookup >>= 2;
+        for (const auto x : algo::range(4))
+        {
+            output[x] = colors[lookup & 3];
+            lookup >>= 2;
+        }
+        output += stride;
     }
 }
 
-static void decode_dxt5_block(
-    io::BaseByteStream &input_stream, u8 output_alpha[4][4])
+// Decodes the 8-byte blocks BC3 uses for alpha and BC4 and BC5 use for
+// their channels.
+static void decode_channel_block(const u8 *input, u8 output[16])
 {
-    u8 alpha[8];
-    alpha[0] = input_stream.read<u8>();
-    alpha[1] = input_stream.read<u8>();
-
-    if (alpha[0] > alpha[1])
+    const u32 value0 = input[0];
+    const u32 value1 = input[1];
+    u8 palette[8];
+    palette[0] = value0;
+    palette[1] = value1;
+    if (value0 > value1)
     {
         for (const auto i : algo::range(2, 8))
-            alpha[i] = ((8. - i) * alpha[0] + ((i - 1.) * alpha[1])) / 7.;
+            palette[i] = ((8 - i) * value0 + (i - 1) * value1) / 7;
     }
     else
     {
         for (const auto i : algo::range(2, 6))
-            alpha[i] = ((6. - i) * alpha[0] + ((i - 1.) * alpha[1])) / 5.;
-        alpha[6] = 0;
-        alpha[7] = 255;
+            palette[i] = ((6 - i) * value0 + (i - 1) * value1) / 5;
+        palette[6] = 0;
+        palette[7] = 0xFF;
     }
 
-    for (const auto i : algo::range(2))
+    u64 lookup = 0;
+    std::memcpy(&lookup, input + 2, 6);
+    lookup = algo::from_little_endian(lookup);
+    for (const auto i : algo::range(16))
     {
-        u32 lookup = input_stream.read<u8>();
-        lookup |= input_stream.read<u8>() << 8;
-        lookup |= input_stream.read<u8>() << 16;
-        for (const auto j : algo::range(8))
+        output[i] = palette[lookup & 7];
+        lookup >>= 3;
+    }
+}
+
+static void decode_bc1_block(
+    const u8 *input, res::Pixel *output, const size_t stride)
+{
+    decode_color_block(input, output, stride);
+}
+
+static void decode_bc2_block(
+    const u8 *input, res::Pixel *output, const size_t stride)
+{
+    decode_color_block(input + 8, output, stride);
+    for (const auto y : algo::range(4))
+    {
+        for (const auto x : algo::range(0, 4, 2))
         {
-            const auto index = lookup & 7;
-            const auto pos = i * 8 + j;
-            const auto x = pos % 4;
-            const auto y = pos / 4;
-            lookup >>= 3;
-            output_alpha[y][x] = alpha[index];
+            const auto b = *input++;
+            output[x + 0].a = b & 0xF0;
+            output[x + 1].a = (b & 0x0F) << 4;
         }
+        output += stride;
     }
 }
 
-std::unique_ptr<res::Image> dec::microsoft::dxt::decode_dxt1(
-    io::BaseByteStream &input_stream, size_t width, size_t height)
+static void decode_bc3_block(
+    const u8 *input, res::Pixel *output, const size_t stride)
 {
-    auto image = create_image(width, height);
-    for (const auto block_y : algo::range(0, height, 4))
-    for (const auto block_x : algo::range(0, width, 4))
+    u8 alpha[16];
+    decode_channel_block(input, alpha);
+    decode_color_block(input + 8, output, stride);
+    for (const auto y : algo::range(4))
     {
-        res::Pixel colors[4][4];
-        decode_dxt1_block(input_stream, colors);
-        for (const auto y : algo::range(4))
         for (const auto x : algo::range(4))
-            image->at(block_x + x, block_y + y) = colors[y][x];
+            output[x].a = alpha[y * 4 + x];
+        output += stride;
     }
-    return image;
 }
 
-std::unique_ptr<res::Image> dec::microsoft::dxt::decode_dxt3(
-    io::BaseByteStream &input_stream, size_t width, size_t height)
+static void decode_bc4_block(
+    const u8 *input, res::Pixel *output, const size_t stride)
 {
-    auto image = create_image(width, height);
-    for (const auto block_y : algo::range(0, height, 4))
-    for (const auto block_x : algo::range(0, width, 4))
+    u8 red[16];
+    decode_channel_block(input, red);
+    for (const auto y : algo::range(4))
     {
-        u8 alpha[4][4];
-        for (const auto y : algo::range(4))
-        for (const auto x : algo::range(0, 4, 2))
+        for (const auto x : algo::range(4))
         {
-            const auto b = input_stream.read<u8>();
-            alpha[y][x + 0] = b & 0xF0;
-            alpha[y][x + 1] = (b & 0x0F) << 4;
+            const auto value = red[y * 4 + x];
+            output[x] = {value, value, value, 0xFF};
         }
+        output += stride;
+    }
+}
 
-        res::Pixel colors[4][4];
-        decode_dxt1_block(input_stream, colors);
-        for (const auto y : algo::range(4))
+static void decode_bc5_block(
+    const u8 *input, res::Pixel *output, const size_t stride)
+{
+    u8 red[16], green[16];
+    decode_channel_block(input, red);
+    decode_channel_block(input + 8, green);
+    for (const auto y : algo::range(4))
+    {
         for (const auto x : algo::range(4))
+            output[x] = {0, green[y * 4 + x], red[y * 4 + x], 0xFF};
+        output += stride;
+    }
+}
+
+static u8 expand_bc7_value(const u32 value, const size_t bits)
+{
+    const auto shifted = value << (8 - bits);
+    return shifted | (shifted >> bits);
+}
+
+static u8 interpolate_bc7_value(
+    const u32 value0, const u32 value1, const size_t index, const size_t bits)
+{
+    const auto weight = bits == 2
+        ? bc7_weights2[index]
+        : bits == 3 ? bc7_weights3[index] : bc7_weights4[index];
+    return ((64 - weight) * value0 + weight * value1 + 32) >> 6;
+}
+
+static size_t get_bc7_subset(
+    const Bc7Mode &mode, const size_t partition, const size_t texel)
+{
+    if (mode.subset_count == 2)
+        return (bc7_partitions2[partition] >> texel) & 1;
+    if (mode.subset_count == 3)
+        return (bc7_partitions3[partition] >> (texel * 2)) & 3;
+    return 0;
+}
+
+static size_t get_bc7_anchor(
+    const Bc7Mode &mode, const size_t partition, const size_t subset)
+{
+    if (!subset)
+        return 0;
+    if (mode.subset_count == 2)
+        return bc7_anchors2[partition];
+    return bc7_anchors3[subset - 1][partition];
+}
+
+static void decode_bc7_block(
+    const u8 *input, res::Pixel *output, const size_t stride)
+{
+    size_t mode_index = 0;
+    while (mode_index < 8 && !(input[0] & (1 << mode_index)))
+        mode_index++;
+    if (mode_index == 8)
+    {
+        // reserved mode, decoders are required to output transparent black
+        for (const auto y : algo::range(4))
+            std::memset(output + y * stride, 0, 4 * sizeof(res::Pixel));
+        return;
+    }
+
+    const auto &mode = bc7_modes[mode_index];
+    Bc7BitReader bit_reader(input);
+    bit_reader.get(mode_index + 1);
+    const auto partition = bit_reader.get(mode.partition_bits);
+    const auto rotation = bit_reader.get(mode.rotation_bits);
+    const auto index_selection = bit_reader.get(mode.index_selection_bits);
+
+    // endpoint pairs of each subset, RGBA
+    const auto endpoint_count = mode.subset_count * 2;
+    u32 endpoints[6][4];
+    for (const auto c : algo::range(3))
+    for (const auto i : algo::range(endpoint_count))
+        endpoints[i][c] = bit_reader.get(mode.color_bits);
+    for (const auto i : algo::range(endpoint_count))
+        endpoints[i][3] = bit_reader.get(mode.alpha_bits);
+
+    size_t color_bits = mode.color_bits;
+    size_t alpha_bits = mode.alpha_bits;
+    if (mode.endpoint_pbits || mode.shared_pbits)
+    {
+        u32 pbits[6];
+        if (mode.endpoint_pbits)
+        {
+            for (const auto i : algo::range(endpoint_count))
+                pbits[i] = bit_reader.get(1);
+        }
+        else
         {
-            colors[y][x].a = alpha[y][x];
-            image->at(block_x + x, block_y + y) = colors[y][x];
+            for (const auto i : algo::range(mode.subset_count))
+                pbits[i * 2] = pbits[i * 2 + 1] = bit_reader.get(1);
         }
+        for (const auto i : algo::range(endpoint_count))
+        for (const auto c : algo::range(4))
+            endpoints[i][c] = (endpoints[i][c] << 1) | pbits[i];
+        color_bits++;
+        if (alpha_bits)
+            alpha_bits++;
+    }
+
+    for (const auto i : algo::range(endpoint_count))
+    {
+        for (const auto c : algo::range(3))
+            endpoints[i][c] = expand_bc7_value(endpoints[i][c], color_bits);
+        endpoints[i][3] = alpha_bits
+            ? expand_bc7_value(endpoints[i][3], alpha_bits)
+            : 0xFF;
+    }
+
+    u8 subsets[16], indices[16], indices2[16];
+    for (const auto i : algo::range(16))
+    {
+        subsets[i] = get_bc7_subset(mode, partition, i);
+        const auto anchor = get_bc7_anchor(mode, partition, subsets[i]);
+        const auto is_anchor = anchor == static_cast<size_t>(i);
+        indices[i] = bit_reader.get(mode.index_bits - is_anchor);
+    }
+    if (mode.index_bits2)
+    {
+        for (const auto i : algo::range(16))
+            indices2[i] = bit_reader.get(mode.index_bits2 - !i);
+    }
+
+    for (const auto i : algo::range(16))
+    {
+        const auto *endpoint0 = endpoints[subsets[i] * 2];
+        const auto *endpoint1 = endpoints[subsets[i] * 2 + 1];
+        auto color_index = indices[i], alpha_index = indices[i];
+        auto color_index_bits = mode.index_bits;
+        auto alpha_index_bits = mode.index_bits;
+        if (mode.index_bits2)
+        {
+            if (index_selection)
+            {
+                color_index = indices2[i];
+                color_index_bits = mode.index_bits2;
+            }
+            else
+            {
+                alpha_index = indices2[i];
+                alpha_index_bits = mode.index_bits2;
+            }
+        }
+
+        u8 rgba[4];
+        for (const auto c : algo::range(3))
+        {
+            rgba[c] = interpolate_bc7_value(
+                endpoint0[c], endpoint1[c], color_index, color_index_bits);
+        }
+        rgba[3] = interpolate_bc7_value(
+            endpoint0[3], endpoint1[3], alpha_index, alpha_index_bits);
+        if (rotation)
+            std::swap(rgba[rotation - 1], rgba[3]);
+
+        auto &pixel = output[(i >> 2) * stride + (i & 3)];
+        pixel.r = rgba[0];
+        pixel.g = rgba[1];
+        pixel.b = rgba[2];
+        pixel.a = rgba[3];
     }
-    return image;
 }
 
-std::unique_ptr<res::Image> dec::microsoft::dxt::decode_dxt5(
-    io::BaseByteStream &input_stream, size_t width, size_t height)
+static const BcnFormatInfo &get_format_info(const BcnFormat fmt)
 {
-    auto image = create_image(width, height);
-    for (const auto block_y : algo::range(0, height, 4))
-    for (const auto block_x : algo::range(0, width, 4))
+    static const BcnFormatInfo bc1 = {8, decode_bc1_block};
+    static const BcnFormatInfo bc2 = {16, decode_bc2_block};
+    static const BcnFormatInfo bc3 = {16, decode_bc3_block};
+    static const BcnFormatInfo bc4 = {8, decode_bc4_block};
+    static const BcnFormatInfo bc5 = {16, decode_bc5_block};
+    static const BcnFormatInfo bc7 = {16, decode_bc7_block};
+    switch (fmt)
     {
-        u8 alpha[4][4];
-        decode_dxt5_block(input_stream, alpha);
+        case BcnFormat::Bc1: return bc1;
+        case BcnFormat::Bc2: return bc2;
+        case BcnFormat::Bc3: return bc3;
+        case BcnFormat::Bc4: return bc4;
+        case BcnFormat::Bc5: return bc5;
+        case BcnFormat::Bc7: return bc7;
+    }
+    throw std::logic_error("Bad BCn format");
+}
 
-        res::Pixel colors[4][4];
-        decode_dxt1_block(input_stream, colors);
-        for (const auto y : algo::range(4))
-        for (const auto x : algo::range(4))
+size_t dec::microsoft::dxt::get_block_size(const BcnFormat fmt)
+{
+    return get_format_info(fmt).block_size;
+}
+
+size_t dec::microsoft::dxt::get_texture_size(
+    const BcnFormat fmt, const size_t width, const size_t height)
+{
+    return ((width + 3) / 4) * ((height + 3) / 4) * get_block_size(fmt);
+}
+
+std::unique_ptr<res::Image> dec::microsoft::dxt::decode_bcn(
+    const u8 *input,
+    const size_t input_size,
+    const BcnFormat fmt,
+    const size_t width,
+    const size_t height)
+{
+    const auto &info = get_format_info(fmt);
+    const auto block_count_x = (width + 3) / 4;
+    const auto block_count_y = (height + 3) / 4;
+    if (input_size < get_texture_size(fmt, width, height))
+        throw err::EofError();
+
+    auto image = std::make_unique<res::Image>(
+        block_count_x * 4, block_count_y * 4);
+    const auto stride = image->width();
+    const auto decode_block_rows = [&](
+        const size_t first_block_y, const size_t last_block_y)
+    {
+        for (const auto block_y : algo::range(first_block_y, last_block_y))
         {
-            colors[y][x].a = alpha[y][x];
-            image->at(block_x + x, block_y + y) = colors[y][x];
+            const auto *input_ptr
+                = input + block_y * block_count_x * info.block_size;
+            auto *output_ptr = &image->at(0, block_y * 4);
+            for (const auto block_x : algo::range(block_count_x))
+            {
+                info.decode_block(input_ptr, output_ptr, stride);
+                input_ptr += info.block_size;
+                output_ptr += 4;
+            }
         }
+    };
+
+    if (block_count_x * block_count_y < parallel_block_count)
+    {
+        decode_block_rows(0, block_count_y);
+        return image;
     }
+
+    const auto band_count
+        = (block_count_y + band_block_rows - 1) / band_block_rows;
+    algo::run_in_parallel(band_count, 0, [&](const size_t band)
+    {
+        const auto first_block_y = band * band_block_rows;
+        decode_block_rows(
+            first_block_y,
+            std::min(first_block_y + band_block_rows, block_count_y));
+    });
     return image;
 }
+
+std::unique_ptr<res::Image> dec::microsoft::dxt::decode_bcn(
+    io::BaseByteStream &input_stream,
+    const BcnFormat fmt,
+    const size_t width,
+    const size_t height)
+{
+    const auto input = input_stream.read(
+        get_texture_size(fmt, width, height));
+    return decode_bcn(input.get<const u8>(), input.size(), fmt, width, height);
+}
+
+std::unique_ptr<res::Image> dec::microsoft::dxt::decode_dxt1(
+    io::BaseByteStream &input_stream, size_t width, size_t height)
+{
+    return decode_bcn(input_stream, BcnFormat::Bc1, width, height);
+}
+
+std::unique_ptr<res::Image> dec::microsoft::dxt::decode_dxt3(
+    io::BaseByteStream &input_stream, size_t width, size_t height)
+{
+    return decode_bcn(input_stream, BcnFormat::Bc2, width, height);
+}
+
+std::unique_ptr<res::Image> dec::microsoft::dxt::decode_dxt5(
+    io::BaseByteStream &input_stream, size_t width, size_t height)
+{
+    return decode_bcn(input_stream, BcnFormat::Bc3, width, height);
+}
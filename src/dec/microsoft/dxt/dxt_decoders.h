@@ -25,6 +25,40 @@ namespace dec {
 namespace microsoft {
 namespace dxt {
 
+    enum class BcnFormat : u8
+    {
+        Bc1, // DXT1
+        Bc2, // DXT3
+        Bc3, // DXT5
+        Bc4, // single channel, ATI1
+        Bc5, // two channels, ATI2
+        Bc7,
+    };
+
+    // Number of bytes a single 4x4 block occupies.
+    size_t get_block_size(const BcnFormat fmt);
+
+    // Number of bytes a texture of given dimensions occupies.
+    size_t get_texture_size(
+        const BcnFormat fmt, const size_t width, const size_t height);
+
+    // Decodes a contiguous span of 4x4 blocks, stored in rows. The image
+    // dimensions are rounded up to the block size. Block rows of large
+    // textures are decoded in parallel, on as many threads as the
+    // process-wide thread limit leaves free.
+    std::unique_ptr<res::Image> decode_bcn(
+        const u8 *input,
+        const size_t input_size,
+        const BcnFormat fmt,
+        const size_t width,
+        const size_t height);
+
+    std::unique_ptr<res::Image> decode_bcn(
+        io::BaseByteStream &input_stream,
+        const BcnFormat fmt,
+        const size_t width,
+        const size_t height);
+
     std::unique_ptr<res::Image> decode_dxt1(
         io::BaseByteStream &input_stream,
         const size_t width,
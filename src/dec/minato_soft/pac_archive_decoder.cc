@@ -67,6 +67,11 @@ static bstr decompress_table(const bstr &input, size_t output_size)
     return output;
 }
 
+dec::DecoderSignature PacArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PacArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -111,7 +116,7 @@ std::unique_ptr<io::File> PacArchiveDecoder::read_file_impl(
     const auto entry = static_cast<const CompressedArchiveEntry*>(&e);
     auto data = input_file.stream.seek(entry->offset).read(entry->size_comp);
     if (entry->size_orig != entry->size_comp)
-        data = algo::pack::zlib_inflate(data);
+        data = algo::pack::zlib_inflate(data, entry->size_orig);
     return std::make_unique<io::File>(entry->path, data);
 }
 
@@ -23,6 +23,11 @@
 using namespace au;
 using namespace au::dec::nekopack;
 
+dec::DecoderSignature MaskedBmpImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("alp");
+}
+
 bool MaskedBmpImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("alp");
@@ -37,6 +37,11 @@ namespace
     };
 }
 
+dec::DecoderSignature Nekopack4ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Nekopack4ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -87,7 +92,7 @@ std::unique_ptr<io::File> Nekopack4ArchiveDecoder::read_file_impl(
             break;
     }
 
-    data = algo::pack::zlib_inflate(data);
+    data = algo::pack::zlib_inflate(data, size_orig);
     return std::make_unique<io::File>(entry->path, data);
 }
 
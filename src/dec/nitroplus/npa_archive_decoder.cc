@@ -89,6 +89,11 @@ static void decrypt_file_data(
         data_ptr[i] = meta.plugin->permutation[data_ptr[i]] - key - i;
 }
 
+dec::DecoderSignature NpaArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool NpaArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -151,7 +156,7 @@ std::unique_ptr<io::File> NpaArchiveDecoder::read_file_impl(
         decrypt_file_data(*meta, *entry, data);
 
     if (meta->files_are_compressed)
-        data = algo::pack::zlib_inflate(data);
+        data = algo::pack::zlib_inflate(data, entry->size_orig);
 
     return std::make_unique<io::File>(entry->path, data);
 }
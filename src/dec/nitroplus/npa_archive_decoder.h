@@ -29,6 +29,7 @@ namespace nitroplus {
     {
     public:
         NpaArchiveDecoder();
+        DecoderSignature get_signature() const override;
 
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
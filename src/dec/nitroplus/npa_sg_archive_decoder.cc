@@ -32,6 +32,11 @@ static void decrypt(bstr &data)
         data[i] ^= key[i % key.size()];
 }
 
+dec::DecoderSignature NpaSgArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("npa");
+}
+
 bool NpaSgArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("npa"))
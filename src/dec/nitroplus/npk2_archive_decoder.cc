@@ -54,6 +54,11 @@ static bstr decrypt(const bstr &input, const CustomArchiveMeta &meta)
     return algo::crypt::aes256_decrypt_cbc(input, meta.iv, meta.key);
 }
 
+dec::DecoderSignature Npk2ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Npk2ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -116,7 +121,9 @@ std::unique_ptr<io::File> Npk2ArchiveDecoder::read_file_impl(
         if (segment.size_orig > segment.size_comp)
         {
             segment_data = algo::pack::zlib_inflate(
-                segment_data, algo::pack::ZlibKind::RawDeflate);
+                segment_data,
+                segment.size_orig,
+                algo::pack::ZlibKind::RawDeflate);
         }
         output_file->stream.write(segment_data);
     }
@@ -39,6 +39,11 @@ namespace
     {
         CompressionType compression_type;
     };
+
+    struct CustomArchiveMeta final : dec::ArchiveMeta
+    {
+        std::shared_ptr<NsaKeystreamCache> keystream_cache;
+    };
 }
 
 NsaArchiveDecoder::NsaArchiveDecoder()
@@ -66,10 +71,13 @@ bool NsaArchiveDecoder::is_recognized_impl(io::File &input_file) const
 std::unique_ptr<dec::ArchiveMeta> NsaArchiveDecoder::read_meta_impl(
     const Logger &logger, io::File &input_file) const
 {
-    NsaEncryptedStream input_stream(input_file.stream, key);
+    auto meta = std::make_unique<CustomArchiveMeta>();
+    if (!key.empty())
+        meta->keystream_cache = std::make_shared<NsaKeystreamCache>(key);
+
+    NsaEncryptedStream input_stream(input_file.stream, meta->keystream_cache);
     input_stream.seek(0);
 
-    auto meta = std::make_unique<ArchiveMeta>();
     const auto file_count = input_stream.read_be<u16>();
     const auto offset_to_data = input_stream.read_be<u32>();
     for (const auto i : algo::range(file_count))
@@ -91,9 +99,10 @@ std::unique_ptr<io::File> NsaArchiveDecoder::read_file_impl(
     const dec::ArchiveMeta &m,
     const dec::ArchiveEntry &e) const
 {
-    NsaEncryptedStream input_stream(input_file.stream, key);
-
+    const auto meta = static_cast<const CustomArchiveMeta*>(&m);
     const auto entry = static_cast<const CustomArchiveEntry*>(&e);
+    NsaEncryptedStream input_stream(input_file.stream, meta->keystream_cache);
+
     const auto data = input_stream
         .seek(entry->offset)
         .read(entry->size_comp);
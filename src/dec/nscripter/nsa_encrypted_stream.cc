@@ -17,20 +17,41 @@
 
 #include "dec/nscripter/nsa_encrypted_stream.h"
 #include <array>
-#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include "algo/binary.h"
 #include "algo/crypt/hmac.h"
 #include "algo/crypt/md5.h"
 #include "algo/crypt/sha1.h"
+#include "algo/parallel.h"
 #include "algo/range.h"
 #include "err.h"
 
 using namespace au;
 using namespace au::dec::nscripter;
 
-static const auto block_size = 1024;
+static const size_t block_size = 1024;
 
-static void transform_block(const bstr &key, size_t block_num, bstr &block)
+// 4 MiB worth of keystreams.
+static const size_t max_cached_block_count = 4096;
+
+// Reads spanning more blocks than this cache only their first and last
+// block, so that a single large read doesn't evict the blocks that small
+// reads keep coming back to.
+static const size_t max_cached_read_blocks = 16;
+
+// Deriving a keystream costs a few hashes, so only reads spanning at least
+// this many blocks are worth spreading over several threads.
+static const size_t min_parallel_read_blocks = 64;
+
+namespace
+{
+    using Keystream = std::array<u8, block_size>;
+    using KeystreamPtr = std::shared_ptr<const Keystream>;
+}
+
+static KeystreamPtr derive_keystream(const bstr &key, uoff_t block_num)
 {
     bstr bn(8);
 
@@ -68,18 +89,134 @@ static void transform_block(const bstr &key, size_t block_num, bstr &block)
         std::swap(box[i0], box[i1]);
     }
 
-    for (const auto i : algo::range(block.size()))
+    auto keystream = std::make_shared<Keystream>();
+    for (const auto i : algo::range(block_size))
     {
         i0++;
         i1 += box[i0];
         std::swap(box[i0], box[i1]);
-        block[i] ^= box[(box[i0] + box[i1]) & 0xFF];
+        (*keystream)[i] = box[(box[i0] + box[i1]) & 0xFF];
+    }
+    return keystream;
+}
+
+struct NsaKeystreamCache::Priv final
+{
+    Priv(const bstr &key);
+
+    KeystreamPtr find(const uoff_t block_num);
+    void insert(const uoff_t block_num, const KeystreamPtr keystream);
+
+    const bstr key;
+    std::mutex mutex;
+    std::list<uoff_t> recent_blocks;
+    std::unordered_map<
+        uoff_t,
+        std::pair<KeystreamPtr, std::list<uoff_t>::iterator>> keystreams;
+};
+
+NsaKeystreamCache::Priv::Priv(const bstr &key) : key(key)
+{
+}
+
+KeystreamPtr NsaKeystreamCache::Priv::find(const uoff_t block_num)
+{
+    const auto it = keystreams.find(block_num);
+    if (it == keystreams.end())
+        return nullptr;
+    recent_blocks.splice(
+        recent_blocks.begin(), recent_blocks, it->second.second);
+    return it->second.first;
+}
+
+void NsaKeystreamCache::Priv::insert(
+    const uoff_t block_num, const KeystreamPtr keystream)
+{
+    if (find(block_num))
+        return;
+    recent_blocks.push_front(block_num);
+    keystreams[block_num] = std::make_pair(keystream, recent_blocks.begin());
+    if (keystreams.size() > max_cached_block_count)
+    {
+        keystreams.erase(recent_blocks.back());
+        recent_blocks.pop_back();
+    }
+}
+
+NsaKeystreamCache::NsaKeystreamCache(const bstr &key)
+    : p(new Priv(key))
+{
+}
+
+NsaKeystreamCache::~NsaKeystreamCache()
+{
+}
+
+void NsaKeystreamCache::apply(const uoff_t offset, u8 *data, const size_t size)
+{
+    if (!size)
+        return;
+
+    const auto first_block = offset / block_size;
+    const auto end_block = (offset + size + block_size - 1) / block_size;
+    const auto block_count = end_block - first_block;
+    const auto cache_all = block_count <= max_cached_read_blocks;
+
+    // every block covers its own part of the data, so they can be handled
+    // by different threads
+    const auto apply_block = [&](const size_t i)
+    {
+        const auto block_num = first_block + i;
+        KeystreamPtr keystream;
+        {
+            std::unique_lock<std::mutex> lock(p->mutex);
+            keystream = p->find(block_num);
+        }
+        if (!keystream)
+        {
+            keystream = derive_keystream(p->key, block_num);
+            if (cache_all
+                || block_num == first_block
+                || block_num == end_block - 1)
+            {
+                std::unique_lock<std::mutex> lock(p->mutex);
+                p->insert(block_num, keystream);
+            }
+        }
+
+        const auto block_offset = block_num * block_size;
+        const auto start = std::max<uoff_t>(block_offset, offset);
+        const auto end
+            = std::min<uoff_t>(block_offset + block_size, offset + size);
+        const auto key_ptr = keystream->data() + (start - block_offset);
+        auto target = data + (start - offset);
+        for (const auto j : algo::range(end - start))
+            target[j] ^= key_ptr[j];
+    };
+
+    if (block_count >= min_parallel_read_blocks)
+    {
+        algo::run_in_parallel(block_count, 0, apply_block);
+    }
+    else
+    {
+        for (const auto i : algo::range(block_count))
+            apply_block(i);
     }
 }
 
 NsaEncryptedStream::NsaEncryptedStream(
     io::BaseByteStream &parent_stream, const bstr &key)
-    : parent_stream(parent_stream.clone()), key(key)
+    : NsaEncryptedStream(
+        parent_stream,
+        key.empty() ? nullptr : std::make_shared<NsaKeystreamCache>(key))
+{
+}
+
+NsaEncryptedStream::NsaEncryptedStream(
+    io::BaseByteStream &parent_stream,
+    const std::shared_ptr<NsaKeystreamCache> keystream_cache)
+    : parent_stream(parent_stream.clone()), keystream_cache(keystream_cache)
 {
 }
 
@@ -94,31 +231,13 @@ void NsaEncryptedStream::seek_impl(const uoff_t offset)
 
 void NsaEncryptedStream::read_impl(void *destination, const size_t size)
 {
-    if (key.empty())
-    {
-        const auto chunk = parent_stream->read(size);
-        std::memcpy(destination, chunk.get<u8>(), size);
-        return;
-    }
-
     const auto orig_pos = parent_stream->pos();
-    const auto padded_pos = orig_pos & ~(block_size - 1);
-    const auto offset_pad = orig_pos % block_size;
-    parent_stream->seek(padded_pos);
-
-    bstr full_buffer;
-    while (full_buffer.size() < size + offset_pad)
+    parent_stream->read(destination, size);
+    if (keystream_cache)
     {
-        const auto block_num = parent_stream->pos() / block_size;
-        auto block = parent_stream->read(
-            std::min<uoff_t>(parent_stream->left(), block_size));
-        transform_block(key, block_num, block);
-        full_buffer += block;
+        keystream_cache->apply(
+            orig_pos, reinterpret_cast<u8*>(destination), size);
     }
-    if (full_buffer.size() < size)
-        throw err::BadDataSizeError();
-    std::memcpy(destination, full_buffer.get<const u8>() + offset_pad, size);
-    parent_stream->seek(orig_pos + size);
 }
 
 void NsaEncryptedStream::write_impl(const void *source, const size_t size)
@@ -143,7 +262,8 @@ void NsaEncryptedStream::resize_impl(const uoff_t new_size)
 
 std::unique_ptr<io::BaseByteStream> NsaEncryptedStream::clone() const
 {
-    auto ret = std::make_unique<NsaEncryptedStream>(*parent_stream, key);
+    auto ret = std::make_unique<NsaEncryptedStream>(
+        *parent_stream, keystream_cache);
     ret->seek(pos());
     return std::move(ret);
 }
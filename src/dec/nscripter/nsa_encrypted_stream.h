@@ -23,10 +23,30 @@ namespace au {
 namespace dec {
 namespace nscripter {
 
+    // Keeps keystreams of the most recently used blocks of an encrypted
+    // archive, so that streams reading the same archive don't need to derive
+    // them again. Safe to share between threads.
+    class NsaKeystreamCache final
+    {
+    public:
+        NsaKeystreamCache(const bstr &key);
+        ~NsaKeystreamCache();
+
+        // Decrypts data that was read from the given archive offset.
+        void apply(const uoff_t offset, u8 *data, const size_t size);
+
+    private:
+        struct Priv;
+        std::unique_ptr<Priv> p;
+    };
+
     class NsaEncryptedStream final : public io::BaseByteStream
     {
     public:
         NsaEncryptedStream(io::BaseByteStream &parent_stream, const bstr &key);
+        NsaEncryptedStream(
+            io::BaseByteStream &parent_stream,
+            const std::shared_ptr<NsaKeystreamCache> keystream_cache);
         ~NsaEncryptedStream();
 
         uoff_t size() const override;
@@ -41,7 +61,7 @@ namespace nscripter {
 
     private:
         std::unique_ptr<io::BaseByteStream> parent_stream;
-        const bstr key;
+        std::shared_ptr<NsaKeystreamCache> keystream_cache;
     };
 
 } } }
@@ -17,10 +17,16 @@
 
 #include "dec/nscripter/sar_archive_decoder.h"
 #include "algo/range.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::nscripter;
 
+dec::DecoderSignature SarArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("sar");
+}
+
 bool SarArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("sar");
@@ -50,8 +56,10 @@ std::unique_ptr<io::File> SarArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 static auto _ = dec::register_decoder<SarArchiveDecoder>("nscripter/sar");
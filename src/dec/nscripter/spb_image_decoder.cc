@@ -82,6 +82,11 @@ static res::Image decode_image(
     return output;
 }
 
+dec::DecoderSignature SpbImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("bmp");
+}
+
 bool SpbImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("bmp"))
@@ -234,6 +234,11 @@ static res::Image read_image(
     throw err::NotSupportedError("Unsupported compression type");
 }
 
+dec::DecoderSignature MgdImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool MgdImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -24,6 +24,11 @@ using namespace au::dec::pajamas;
 
 static const auto magic = "EP"_b;
 
+dec::DecoderSignature EpImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool EpImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
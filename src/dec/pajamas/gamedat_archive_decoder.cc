@@ -34,6 +34,11 @@ static const auto get_version(io::BaseByteStream &input_stream)
     throw err::RecognitionError();
 }
 
+dec::DecoderSignature GamedatArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool GamedatArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -162,6 +162,11 @@ static std::unique_ptr<res::Image> read_image(
     return image;
 }
 
+dec::DecoderSignature GimImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool GimImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -114,6 +114,11 @@ static res::Image decode(
     return res::Image(width, height, data, format);
 }
 
+dec::DecoderSignature PngImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PngImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -34,6 +34,7 @@ namespace png {
             const Logger &logger,
             io::File &input_file,
             ChunkHandler chunk_handler) const;
+        DecoderSignature get_signature() const override;
 
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
@@ -69,6 +69,11 @@ static bstr decompress(const bstr &input, size_t size_orig)
     return output;
 }
 
+dec::DecoderSignature MgrArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("mgr");
+}
+
 bool MgrArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("mgr");
@@ -18,10 +18,16 @@
 #include "dec/propeller/mpk_archive_decoder.h"
 #include "algo/locale.h"
 #include "algo/range.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::propeller;
 
+dec::DecoderSignature MpkArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("mpk");
+}
+
 bool MpkArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("mpk");
@@ -66,8 +72,10 @@ std::unique_ptr<io::File> MpkArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> MpkArchiveDecoder::get_linked_formats() const
@@ -17,10 +17,11 @@
 
 #include "dec/purple_software/jbp1.h"
 #include <array>
+#include "algo/pack/huffman_table.h"
 #include "algo/range.h"
 #include "err.h"
+#include "io/lsb_bit_reader.h"
 #include "io/memory_byte_stream.h"
-#include "io/msb_bit_stream.h"
 
 using namespace au;
 
@@ -54,11 +55,18 @@ namespace
         size_t input_size;
     };
 
-    class CustomBitStream final : public io::BaseBitStream
+    // Takes bits starting from the least significant bit of each byte, but
+    // puts the first bit read at the top of the returned value.
+    class CustomBitReader final
     {
     public:
-        CustomBitStream(const bstr &str);
-        u32 read(const size_t bits) override;
+        CustomBitReader(const bstr &input);
+        u32 read(const size_t bits);
+        u32 decode(const algo::pack::HuffmanTable &table);
+
+    private:
+        const bstr input;
+        io::LsbBitReader reader;
     };
 }
 
@@ -66,26 +74,27 @@ Tree::Tree() : base(), neighbour(), other()
 {
 }
 
-CustomBitStream::CustomBitStream(const bstr &input) : io::BaseBitStream(input)
+CustomBitReader::CustomBitReader(const bstr &input)
+    : input(input), reader(this->input)
 {
 }
 
-u32 CustomBitStream::read(const size_t bits)
+u32 CustomBitReader::read(const size_t bits)
 {
-    u32 ret = 0;
-    for (const auto i : algo::range(bits))
-    {
-        if (!bits_available)
-        {
-            buffer = input_stream->read<u8>();
-            bits_available = 8;
-        }
-        ret <<= 1;
-        ret |= (buffer & 1);
-        buffer >>= 1;
-        bits_available--;
-    }
-    return ret;
+    if (!bits)
+        return 0;
+    auto value = reader.read(bits);
+    value = ((value >> 1) & 0x55555555) | ((value & 0x55555555) << 1);
+    value = ((value >> 2) & 0x33333333) | ((value & 0x33333333) << 2);
+    value = ((value >> 4) & 0x0F0F0F0F) | ((value & 0x0F0F0F0F) << 4);
+    value = ((value >> 8) & 0x00FF00FF) | ((value & 0x00FF00FF) << 8);
+    value = (value >> 16) | (value << 16);
+    return value >> (32 - bits);
+}
+
+u32 CustomBitReader::decode(const algo::pack::HuffmanTable &table)
+{
+    return table.decode(reader);
 }
 
 static Tree make_tree(const bstr &input, std::array<u32, 0x80> &freq)
@@ -149,12 +158,25 @@ static Tree make_tree(const bstr &input, std::array<u32, 0x80> &freq)
     return ret;
 }
 
-static int read_from_tree(const Tree &tree, io::BaseBitStream &bit_stream)
+// Nodes below input_size are leaves, the rest are internal nodes.
+static algo::pack::HuffmanTable get_table(const Tree &tree)
 {
-    size_t ret = tree.root;
-    while (ret >= tree.input_size)
-        ret = tree.neighbour.at((bit_stream.read(1) << 9) + ret);
-    return ret;
+    const auto get_table_node = [&](const u32 node)
+    {
+        return node < tree.input_size
+            ? node | algo::pack::HuffmanTable::leaf_flag
+            : node - tree.input_size;
+    };
+    std::vector<u32> children;
+    for (const auto node : algo::range(tree.input_size, tree.root + 1))
+    {
+        children.push_back(get_table_node(tree.neighbour.at(node)));
+        children.push_back(get_table_node(tree.neighbour.at(node + 0x200)));
+    }
+    return algo::pack::HuffmanTable(
+        children,
+        get_table_node(tree.root),
+        algo::pack::HuffmanBitOrder::LsbFirst);
 }
 
 static void dct(
@@ -355,22 +377,22 @@ static void ycc2rgb(u8 *dc, u8 *ac, short *iy, short *cbcr, const size_t stride)
 static bstr decode_blocks(
     const BasicInfo &info,
     const bstr &tree_input,
-    io::BaseBitStream &bit_stream_1,
-    io::BaseBitStream &bit_stream_2,
+    CustomBitReader &bit_reader_1,
+    CustomBitReader &bit_reader_2,
     std::array<u32, 0x80> &freq_dc,
     std::array<u32, 0x80> &freq_ac,
     const std::array<s16, 64> &quant_y,
     const std::array<s16, 64> &quant_c)
 {
-    const auto tree_dc = make_tree(tree_input, freq_dc);
-    const auto tree_ac = make_tree(tree_input, freq_ac);
+    const auto table_dc = get_table(make_tree(tree_input, freq_dc));
+    const auto table_ac = get_table(make_tree(tree_input, freq_ac));
 
     std::vector<u32> tmp(info.x_block_count * info.y_block_count * 3 * 2);
 
     for (const auto i : algo::range(tmp.size()))
     {
-        const auto bit_count = read_from_tree(tree_dc, bit_stream_1);
-        u32 x = bit_stream_1.read(bit_count);
+        const auto bit_count = bit_reader_1.decode(table_dc);
+        u32 x = bit_reader_1.read(bit_count);
         if (x < (1u << (bit_count - 1)))
             x = x - (1 << bit_count) + 1;
 
@@ -408,8 +430,7 @@ static bstr decode_blocks(
 
                 for (int i = 0; i < 63;)
                 {
-                    const auto bit_count
-                        = read_from_tree(tree_ac, bit_stream_2);
+                    const auto bit_count = bit_reader_2.decode(table_ac);
 
                     if (bit_count == 15)
                         break;
@@ -417,13 +438,13 @@ static bstr decode_blocks(
                     if (!bit_count)
                     {
                         auto tree_input_pos = 0;
-                        while (bit_stream_2.read(1))
+                        while (bit_reader_2.read(1))
                             tree_input_pos++;
                         i += tree_input.at(tree_input_pos);
                     }
                     else
                     {
-                        u32 x = bit_stream_2.read(bit_count);
+                        u32 x = bit_reader_2.read(bit_count);
                         if (x < (1u << (bit_count - 1)))
                             x = x - (1 << bit_count) + 1;
                         dct_table[n][original_order[i]] = x;
@@ -545,13 +566,13 @@ bstr dec::purple_software::jbp1_decompress(const bstr &input)
             quant_c[i] =  input_stream.read<u8>();
     }
 
-    CustomBitStream bit_stream_1(input_stream.read(info.bit_pool_1_size));
-    CustomBitStream bit_stream_2(input_stream.read(info.bit_pool_2_size));
+    CustomBitReader bit_reader_1(input_stream.read(info.bit_pool_1_size));
+    CustomBitReader bit_reader_2(input_stream.read(info.bit_pool_2_size));
     const auto block_output = decode_blocks(
         info,
         tree_input,
-        bit_stream_1,
-        bit_stream_2,
+        bit_reader_1,
+        bit_reader_2,
         freq_dc,
         freq_ac,
         quant_y,
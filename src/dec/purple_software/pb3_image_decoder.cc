@@ -412,6 +412,11 @@ static Header read_header(io::BaseByteStream &input_stream)
     return header;
 }
 
+dec::DecoderSignature Pb3ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Pb3ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
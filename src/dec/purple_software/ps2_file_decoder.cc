@@ -76,6 +76,11 @@ static bstr custom_lzss_decompress(const bstr &input, const size_t size_orig)
     return output;
 }
 
+dec::DecoderSignature Ps2FileDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Ps2FileDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (input_file.stream.read(magic.size()) != magic)
@@ -17,12 +17,18 @@
 
 #include "dec/qlie/abmp7_archive_decoder.h"
 #include "algo/locale.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::qlie;
 
 static const bstr magic = "ABMP7"_b;
 
+dec::DecoderSignature Abmp7ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Abmp7ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -68,8 +74,10 @@ std::unique_ptr<io::File> Abmp7ArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    auto output_file = std::make_unique<io::File>(entry->path, data);
+    auto output_file = std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
     output_file->guess_extension();
     return output_file;
 }
@@ -25,6 +25,11 @@ using namespace au::dec::qlie;
 
 static const bstr magic = "DPNG"_b;
 
+dec::DecoderSignature DpngImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool DpngImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -173,6 +173,11 @@ static res::Image decode_v2(
     return image;
 }
 
+dec::DecoderSignature G00ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("g00");
+}
+
 bool G00ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("g00");
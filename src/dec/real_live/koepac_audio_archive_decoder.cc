@@ -106,6 +106,11 @@ static s8 koe_ad_trans_tbl[256] =
     0x7C, -0x7D, 0x7D, -0x7E, 0x7E, -0x7F, 0x7F, -0x80,
 };
 
+dec::DecoderSignature KoepacAudioArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool KoepacAudioArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -199,6 +199,11 @@ static bstr read_uncompressed_samples(
     return input_stream.read(header.size_orig);
 }
 
+dec::DecoderSignature NwaAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("nwa");
+}
+
 bool NwaAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("nwa");
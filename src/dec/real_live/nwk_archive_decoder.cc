@@ -22,6 +22,11 @@
 using namespace au;
 using namespace au::dec::real_live;
 
+dec::DecoderSignature NwkArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("nwk");
+}
+
 bool NwkArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("nwk");
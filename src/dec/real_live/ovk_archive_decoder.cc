@@ -18,10 +18,16 @@
 #include "dec/real_live/ovk_archive_decoder.h"
 #include "algo/format.h"
 #include "algo/range.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::real_live;
 
+dec::DecoderSignature OvkArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("ovk");
+}
+
 bool OvkArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("ovk");
@@ -52,8 +58,10 @@ std::unique_ptr<io::File> OvkArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    auto output_file = std::make_unique<io::File>(entry->path, data);
+    auto output_file = std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
     output_file->guess_extension();
     return output_file;
 }
@@ -27,6 +27,11 @@ using namespace au::dec::real_live;
 
 static const bstr magic = "PDT10\x00\x00\x00"_b;
 
+dec::DecoderSignature Pdt10ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Pdt10ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
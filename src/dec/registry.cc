@@ -18,14 +18,109 @@
 #include "dec/registry.h"
 #include <algorithm>
 #include <map>
+#include <mutex>
+#include <stack>
+#include <unordered_map>
 #include "dec/idecoder.h"
 #include "err.h"
 
+using namespace au;
 using namespace au::dec;
 
+namespace
+{
+    // Maps header fragments to decoders that declared them as their magic.
+    // Fragments are grouped by their offset and size, so that recognizing
+    // a file costs one hash lookup per distinct (offset, size) pair rather
+    // than one decoder instantiation per registered decoder.
+    struct SignatureIndex final
+    {
+        SignatureIndex(const Registry &registry);
+
+        std::vector<DecoderSignature> signatures;
+        std::map<std::string, size_t> ids;
+        std::map<
+            std::pair<uoff_t, size_t>,
+            std::unordered_map<std::string, std::vector<size_t>>> magics;
+        std::vector<size_t> magicless_ids;
+        uoff_t header_size;
+    };
+
+    // Transitive closure of the linked formats of every decoder, so that
+    // nested decoding doesn't need to instantiate decoders just to find out
+    // which ones to try next.
+    struct LinkageIndex final
+    {
+        LinkageIndex(const Registry &registry);
+
+        std::map<std::string, std::shared_ptr<const std::set<std::string>>>
+            linked_decoders;
+    };
+}
+
+SignatureIndex::SignatureIndex(const Registry &registry) : header_size(0)
+{
+    for (const auto &name : registry.get_decoder_names())
+    {
+        auto signature = registry.get_decoder(name)->get_signature();
+        if (signature.empty())
+            continue;
+
+        const auto id = signatures.size();
+        ids[name] = id;
+        for (const auto &magic : signature.magics)
+        {
+            const auto key = std::make_pair(magic.offset, magic.bytes.size());
+            magics[key][magic.bytes.str()].push_back(id);
+            header_size = std::max<uoff_t>(
+                header_size, magic.offset + magic.bytes.size());
+        }
+        if (signature.magics.empty())
+            magicless_ids.push_back(id);
+        signatures.push_back(std::move(signature));
+    }
+}
+
+LinkageIndex::LinkageIndex(const Registry &registry)
+{
+    std::map<std::string, std::vector<std::string>> linked_formats;
+    for (const auto &name : registry.get_decoder_names())
+    {
+        linked_formats[name]
+            = registry.get_decoder(name)->get_linked_formats();
+    }
+
+    for (const auto &it : linked_formats)
+    {
+        std::set<std::string> known_formats;
+        std::stack<std::string> formats_to_inspect;
+        formats_to_inspect.push(it.first);
+        while (!formats_to_inspect.empty())
+        {
+            const auto links_it = linked_formats.find(formats_to_inspect.top());
+            formats_to_inspect.pop();
+            if (links_it == linked_formats.end())
+                continue;
+            for (const auto &format : links_it->second)
+                if (known_formats.insert(format).second)
+                    formats_to_inspect.push(format);
+        }
+        linked_decoders[it.first]
+            = std::make_shared<const std::set<std::string>>(
+                std::move(known_formats));
+    }
+}
+
 struct Registry::Priv final
 {
     std::map<std::string, DecoderCreator> decoder_map;
+
+    std::mutex index_mutex;
+    std::shared_ptr<const SignatureIndex> index;
+    std::shared_ptr<const LinkageIndex> linkage_index;
+
+    std::mutex instances_mutex;
+    std::map<std::string, std::shared_ptr<const IDecoder>> instances;
 };
 
 Registry::Registry() : p(new Priv)
@@ -58,6 +153,23 @@ std::shared_ptr<IDecoder>
     return p->decoder_map[name]();
 }
 
+std::shared_ptr<const IDecoder>
+    Registry::get_decoder(const std::string &name) const
+{
+    {
+        std::unique_lock<std::mutex> lock(p->instances_mutex);
+        const auto it = p->instances.find(name);
+        if (it != p->instances.end())
+            return it->second;
+    }
+
+    // created outside the lock, since some decoders take a while to build
+    // their plugin tables; if two threads race here, the first one wins
+    std::shared_ptr<const IDecoder> instance = create_decoder(name);
+    std::unique_lock<std::mutex> lock(p->instances_mutex);
+    return p->instances.emplace(name, instance).first->second;
+}
+
 void Registry::add_decoder(const std::string &name, DecoderCreator creator)
 {
     if (has_decoder(name))
@@ -66,6 +178,80 @@ void Registry::add_decoder(const std::string &name, DecoderCreator creator)
             "Decoder with name " + name + " was already registered.");
     }
     p->decoder_map[name] = creator;
+
+    std::unique_lock<std::mutex> lock(p->index_mutex);
+    p->index.reset();
+    p->linkage_index.reset();
+}
+
+std::vector<std::string> Registry::get_recognition_candidates(
+    io::File &input_file, const std::set<std::string> &decoder_names) const
+{
+    std::shared_ptr<const SignatureIndex> index;
+    {
+        std::unique_lock<std::mutex> lock(p->index_mutex);
+        if (!p->index)
+            p->index = std::make_shared<const SignatureIndex>(*this);
+        index = p->index;
+    }
+
+    const auto file_size = input_file.stream.size();
+    const auto header = input_file.stream.seek(0).read(
+        std::min<uoff_t>(file_size, index->header_size));
+    input_file.stream.seek(0);
+
+    std::vector<bool> matched(index->signatures.size(), false);
+    for (const auto &it : index->magics)
+    {
+        const auto offset = it.first.first;
+        const auto size = it.first.second;
+        if (offset + size > header.size())
+            continue;
+        const auto fragment = std::string(header.get<char>() + offset, size);
+        const auto decoder_ids_it = it.second.find(fragment);
+        if (decoder_ids_it == it.second.end())
+            continue;
+        for (const auto id : decoder_ids_it->second)
+            matched[id] = true;
+    }
+    for (const auto id : index->magicless_ids)
+        matched[id] = true;
+
+    std::vector<std::string> candidates;
+    for (const auto &name : decoder_names)
+    {
+        const auto id_it = index->ids.find(name);
+        if (id_it == index->ids.end())
+        {
+            candidates.push_back(name);
+            continue;
+        }
+        const auto id = id_it->second;
+        const auto &signature = index->signatures[id];
+        if (matched[id]
+            && file_size >= signature.min_size
+            && signature.matches_extension(input_file.path))
+        {
+            candidates.push_back(name);
+        }
+    }
+    return candidates;
+}
+
+std::shared_ptr<const std::set<std::string>> Registry::get_linked_decoders(
+    const std::string &name) const
+{
+    if (!has_decoder(name))
+        throw err::UsageError("Unknown decoder: " + name);
+
+    std::shared_ptr<const LinkageIndex> linkage_index;
+    {
+        std::unique_lock<std::mutex> lock(p->index_mutex);
+        if (!p->linkage_index)
+            p->linkage_index = std::make_shared<const LinkageIndex>(*this);
+        linkage_index = p->linkage_index;
+    }
+    return linkage_index->linked_decoders.at(name);
 }
 
 Registry &Registry::instance()
@@ -19,7 +19,9 @@
 
 #include <functional>
 #include <memory>
+#include <set>
 #include <vector>
+#include "io/file.h"
 
 namespace au {
 namespace dec {
@@ -42,6 +44,26 @@ namespace dec {
         void add_decoder(const std::string &name, DecoderCreator creator);
         std::shared_ptr<IDecoder> create_decoder(const std::string &name) const;
 
+        // Returns an instance of the given decoder that is created once and
+        // then shared by all callers, including other threads. It must not
+        // be configured through its arg parser decorators; use
+        // create_decoder for that.
+        std::shared_ptr<const IDecoder> get_decoder(
+            const std::string &name) const;
+
+        // Narrows down the given decoder names to the ones whose declared
+        // signatures match the file. Decoders that don't declare any
+        // signature are always returned.
+        std::vector<std::string> get_recognition_candidates(
+            io::File &input_file,
+            const std::set<std::string> &decoder_names) const;
+
+        // Returns the decoders to try on files produced by the given
+        // decoder, i.e. its linked formats, their linked formats and so on.
+        // Computed once for all decoders; the result is shared.
+        std::shared_ptr<const std::set<std::string>> get_linked_decoders(
+            const std::string &name) const;
+
     private:
         Registry();
 
@@ -24,6 +24,11 @@ using namespace au::dec::riddle_soft;
 
 static const bstr magic = "CMP1"_b;
 
+dec::DecoderSignature CmpImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool CmpImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
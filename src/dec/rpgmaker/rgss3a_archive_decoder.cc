@@ -24,6 +24,11 @@ using namespace au::dec::rpgmaker;
 
 static const bstr magic = "RGSSAD\x00\x03"_b;
 
+dec::DecoderSignature Rgss3aArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Rgss3aArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -25,6 +25,11 @@ using namespace au::dec::rpgmaker;
 static const bstr magic = "RGSSAD\x00\x01"_b;
 static const u32 initial_key = 0xDEADCAFE;
 
+dec::DecoderSignature RgssadArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool RgssadArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -25,6 +25,11 @@ using namespace au::dec::rpgmaker;
 
 static const bstr magic = "XYZ1"_b;
 
+dec::DecoderSignature XyzImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool XyzImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
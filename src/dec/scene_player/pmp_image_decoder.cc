@@ -23,6 +23,11 @@
 using namespace au;
 using namespace au::dec::scene_player;
 
+dec::DecoderSignature PmpImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("pmp");
+}
+
 bool PmpImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("pmp");
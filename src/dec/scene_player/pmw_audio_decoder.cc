@@ -22,6 +22,11 @@
 using namespace au;
 using namespace au::dec::scene_player;
 
+dec::DecoderSignature PmwAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("pmw");
+}
+
 bool PmwAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("pmw");
@@ -24,6 +24,11 @@ using namespace au::dec::shiina_rio;
 
 static const bstr magic = "OGV\x00"_b;
 
+dec::DecoderSignature OgvAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool OgvAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -202,6 +202,11 @@ static bstr read_incremental(
     return data;
 }
 
+dec::DecoderSignature S25ImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool S25ImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
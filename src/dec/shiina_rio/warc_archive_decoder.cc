@@ -54,6 +54,11 @@ CustomArchiveMeta::CustomArchiveMeta(
 {
 }
 
+dec::DecoderSignature WarcArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool WarcArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
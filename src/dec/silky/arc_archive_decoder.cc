@@ -24,6 +24,11 @@
 using namespace au;
 using namespace au::dec::silky;
 
+dec::DecoderSignature ArcArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("arc");
+}
+
 bool ArcArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("arc"))
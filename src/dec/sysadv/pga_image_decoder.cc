@@ -23,6 +23,11 @@ using namespace au::dec::sysadv;
 
 static const bstr magic = "PGAPGAH\x0A"_b;
 
+dec::DecoderSignature PgaImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PgaImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -17,10 +17,16 @@
 
 #include "dec/tabito/dat_archive_decoder.h"
 #include "algo/range.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::tabito;
 
+dec::DecoderSignature DatArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("dat");
+}
+
 bool DatArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("dat"))
@@ -66,8 +72,10 @@ std::unique_ptr<io::File> DatArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    auto ret = std::make_unique<io::File>(entry->path, data);
+    auto ret = std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
     ret->guess_extension();
     return ret;
 }
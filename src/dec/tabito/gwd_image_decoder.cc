@@ -27,6 +27,11 @@ using namespace au::dec::tabito;
 static const bstr magic = "GWD"_b;
 static u8 transform_table[256][256];
 
+dec::DecoderSignature GwdImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic, 4);
+}
+
 bool GwdImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(4).read(magic.size()) == magic;
@@ -214,6 +214,11 @@ ArcArchiveDecoder::ArcArchiveDecoder()
             }));
 }
 
+dec::DecoderSignature ArcArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool ArcArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
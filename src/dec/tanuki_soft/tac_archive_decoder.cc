@@ -142,7 +142,7 @@ std::unique_ptr<io::File> TacArchiveDecoder::read_file_impl(
         .seek(entry->offset)
         .read(entry->size_comp);
     if (entry->compressed)
-        data = algo::pack::zlib_inflate(data);
+        data = algo::pack::zlib_inflate(data, entry->size_orig);
 
     if (!entry->compressed)
     {
@@ -196,6 +196,11 @@ algo::NamingStrategy AnmArchiveDecoder::naming_strategy() const
     return algo::NamingStrategy::Root;
 }
 
+dec::DecoderSignature AnmArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("anm");
+}
+
 bool AnmArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("anm");
@@ -25,6 +25,9 @@ namespace team_shanghai_alice {
 
     class AnmArchiveDecoder final : public BaseArchiveDecoder
     {
+    public:
+        DecoderSignature get_signature() const override;
+
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
 
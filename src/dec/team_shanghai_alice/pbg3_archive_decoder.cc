@@ -40,6 +40,11 @@ static unsigned int read_integer(io::BaseBitStream &bit_stream)
     return bit_stream.read(integer_size << 3);
 }
 
+dec::DecoderSignature Pbg3ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Pbg3ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -35,6 +35,11 @@ static bstr decompress(const bstr &data, size_t size_orig)
     return algo::pack::lzss_decompress(data, size_orig, settings);
 }
 
+dec::DecoderSignature Pbg4ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool Pbg4ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -111,6 +111,11 @@ static size_t detect_encryption_version(
     throw err::NotSupportedError("No means to detect the encryption version");
 }
 
+dec::DecoderSignature PbgzArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool PbgzArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -117,6 +117,11 @@ static int detect_encryption_version(io::File &input_file)
     return -1;
 }
 
+dec::DecoderSignature Tha1ArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("dat");
+}
+
 bool Tha1ArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("dat"))
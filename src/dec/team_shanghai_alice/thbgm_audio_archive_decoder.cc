@@ -79,6 +79,11 @@ static std::unique_ptr<io::File> grab_definitions_file(
     return nullptr;
 }
 
+dec::DecoderSignature ThbgmAudioArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool ThbgmAudioArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -37,6 +37,8 @@ namespace team_shanghai_alice {
             io::File &input_file,
             const ArchiveMeta &m,
             const ArchiveEntry &e) const override;
+
+        DecoderSignature get_signature() const override;
     };
 
 } } }
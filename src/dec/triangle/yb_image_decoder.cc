@@ -25,6 +25,11 @@ using namespace au::dec::triangle;
 
 static const bstr magic = "YB"_b;
 
+dec::DecoderSignature YbImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool YbImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
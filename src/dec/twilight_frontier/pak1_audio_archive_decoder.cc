@@ -36,6 +36,11 @@ namespace
     };
 }
 
+dec::DecoderSignature Pak1AudioArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("dat");
+}
+
 bool Pak1AudioArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("dat"))
@@ -40,6 +40,11 @@ namespace
     };
 }
 
+dec::DecoderSignature Pak1ImageArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("dat");
+}
+
 bool Pak1ImageArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("dat"))
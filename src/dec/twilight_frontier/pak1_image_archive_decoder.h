@@ -25,6 +25,9 @@ namespace twilight_frontier {
 
     class Pak1ImageArchiveDecoder final : public BaseArchiveDecoder
     {
+    public:
+        DecoderSignature get_signature() const override;
+
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
 
@@ -20,6 +20,11 @@
 using namespace au;
 using namespace au::dec::twilight_frontier;
 
+dec::DecoderSignature Pak2AudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("cv3");
+}
+
 bool Pak2AudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("cv3");
@@ -26,6 +26,11 @@
 using namespace au;
 using namespace au::dec::twilight_frontier;
 
+dec::DecoderSignature Pak2ImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("cv2");
+}
+
 bool Pak2ImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("cv2");
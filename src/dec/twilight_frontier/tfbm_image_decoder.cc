@@ -29,6 +29,11 @@ using namespace au::dec::twilight_frontier;
 static const bstr pal_magic = "TFPA\x00"_b;
 static const bstr magic = "TFBM\x00"_b;
 
+dec::DecoderSignature TfbmImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool TfbmImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
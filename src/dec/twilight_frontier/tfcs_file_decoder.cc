@@ -35,6 +35,11 @@ static void write_cell(io::BaseByteStream &output_stream, std::string cell)
     output_stream.write(algo::sjis_to_utf8(cell));
 }
 
+dec::DecoderSignature TfcsFileDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool TfcsFileDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -47,7 +52,7 @@ std::unique_ptr<io::File> TfcsFileDecoder::decode_impl(
     const auto size_comp = input_file.stream.read_le<u32>();
     const auto size_orig = input_file.stream.read_le<u32>();
     io::MemoryByteStream uncompressed_stream(
-        algo::pack::zlib_inflate(input_file.stream.read_to_eof()));
+        algo::pack::zlib_inflate(input_file.stream.read_to_eof(), size_orig));
 
     auto output_file = std::make_unique<io::File>();
     output_file->path = input_file.path;
@@ -370,6 +370,11 @@ TfpkArchiveDecoder::TfpkArchiveDecoder()
         });
 }
 
+dec::DecoderSignature TfpkArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool TfpkArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (input_file.stream.read(magic.size()) != magic)
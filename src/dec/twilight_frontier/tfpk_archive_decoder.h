@@ -29,6 +29,7 @@ namespace twilight_frontier {
     public:
         TfpkArchiveDecoder();
         std::vector<std::string> get_linked_formats() const override;
+        DecoderSignature get_signature() const override;
 
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
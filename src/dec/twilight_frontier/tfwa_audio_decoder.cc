@@ -22,6 +22,11 @@ using namespace au::dec::twilight_frontier;
 
 static const bstr magic = "TFWA\x00"_b;
 
+dec::DecoderSignature TfwaAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool TfwaAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
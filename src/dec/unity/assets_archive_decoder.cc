@@ -18,6 +18,7 @@
 #include "dec/unity/assets_archive_decoder.h"
 #include "dec/unity/assets_archive_decoder/meta.h"
 #include "err.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::unity;
@@ -94,8 +95,10 @@ std::unique_ptr<io::File> AssetsArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 static auto _ = dec::register_decoder<AssetsArchiveDecoder>("unity/assets");
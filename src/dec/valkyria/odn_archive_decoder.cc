@@ -57,6 +57,11 @@ static size_t hex_to_int(const bstr &input)
     return ret;
 }
 
+dec::DecoderSignature OdnArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("odn");
+}
+
 bool OdnArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.path.has_extension("odn");
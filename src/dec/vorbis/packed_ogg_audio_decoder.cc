@@ -73,6 +73,11 @@ static void write_ogg_page(
         output_stream.write(page_segment);
 }
 
+dec::DecoderSignature PackedOggAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("wav");
+}
+
 bool PackedOggAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("wav"))
@@ -22,6 +22,11 @@ using namespace au::dec::west_vision;
 
 static const bstr magic = "$SYG"_b;
 
+dec::DecoderSignature SygImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool SygImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -243,6 +243,11 @@ void DatArchiveDecoder::add_file_name(const std::string &file_name)
     file_names_map[crc64(file_name_sjis)] = file_name_sjis;
 }
 
+dec::DecoderSignature DatArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_extension("dat");
+}
+
 bool DatArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     if (!input_file.path.has_extension("dat"))
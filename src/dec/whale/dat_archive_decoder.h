@@ -31,6 +31,7 @@ namespace whale {
         void set_game_title(const std::string &game_title);
         void add_file_name(const std::string &file_name);
         std::vector<std::string> get_linked_formats() const override;
+        DecoderSignature get_signature() const override;
 
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
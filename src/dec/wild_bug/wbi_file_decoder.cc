@@ -24,6 +24,11 @@ using namespace au::dec::wild_bug;
 
 static const bstr magic = "WPX\x1A""EX2\x00"_b;
 
+dec::DecoderSignature WbiFileDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool WbiFileDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -25,6 +25,9 @@ namespace wild_bug {
 
     class WbiFileDecoder final : public BaseFileDecoder
     {
+    public:
+        DecoderSignature get_signature() const override;
+
     protected:
         bool is_recognized_impl(io::File &input_file) const override;
 
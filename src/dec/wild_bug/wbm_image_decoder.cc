@@ -81,6 +81,11 @@ static res::Image get_image(
         throw err::UnsupportedChannelCountError(channels);
 }
 
+dec::DecoderSignature WbmImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool WbmImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
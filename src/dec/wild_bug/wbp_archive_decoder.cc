@@ -18,12 +18,18 @@
 #include "dec/wild_bug/wbp_archive_decoder.h"
 #include <map>
 #include "algo/range.h"
+#include "io/slice_byte_stream.h"
 
 using namespace au;
 using namespace au::dec::wild_bug;
 
 static const bstr magic = "ARCFORM4\x20WBUG\x20"_b;
 
+dec::DecoderSignature WbpArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool WbpArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -102,8 +108,10 @@ std::unique_ptr<io::File> WbpArchiveDecoder::read_file_impl(
     const dec::ArchiveEntry &e) const
 {
     const auto entry = static_cast<const PlainArchiveEntry*>(&e);
-    const auto data = input_file.stream.seek(entry->offset).read(entry->size);
-    return std::make_unique<io::File>(entry->path, data);
+    return std::make_unique<io::File>(
+        entry->path,
+        std::make_unique<io::SliceByteStream>(
+            input_file.stream, entry->offset, entry->size));
 }
 
 std::vector<std::string> WbpArchiveDecoder::get_linked_formats() const
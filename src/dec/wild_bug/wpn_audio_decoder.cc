@@ -35,6 +35,11 @@ namespace
     };
 }
 
+dec::DecoderSignature WpnAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool WpnAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
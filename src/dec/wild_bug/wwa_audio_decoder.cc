@@ -24,6 +24,11 @@ using namespace au::dec::wild_bug;
 
 static const bstr magic = "WPX\x1AWAV\x00"_b;
 
+dec::DecoderSignature WwaAudioDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool WwaAudioDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
@@ -101,6 +101,11 @@ static res::Image decode_png(
     return png_image_decoder.decode(logger, png_file);
 }
 
+dec::DecoderSignature YkgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool YkgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
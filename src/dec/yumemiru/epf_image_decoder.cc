@@ -24,6 +24,11 @@ using namespace au::dec::yumemiru;
 
 static const bstr magic = "yga\x00"_b;
 
+dec::DecoderSignature EpfImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool EpfImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
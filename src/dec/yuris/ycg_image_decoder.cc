@@ -24,6 +24,11 @@ using namespace au::dec::yuris;
 
 static const bstr magic = "YCG\x00"_b;
 
+dec::DecoderSignature YcgImageDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool YcgImageDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.read(magic.size()) == magic;
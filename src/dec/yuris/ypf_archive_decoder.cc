@@ -140,6 +140,11 @@ static u8 guess_key(const std::vector<bstr> &names)
     throw err::NotSupportedError("Failed to guess the key");
 }
 
+dec::DecoderSignature YpfArchiveDecoder::get_signature() const
+{
+    return DecoderSignature().add_magic(magic);
+}
+
 bool YpfArchiveDecoder::is_recognized_impl(io::File &input_file) const
 {
     return input_file.stream.seek(0).read(magic.size()) == magic;
@@ -198,7 +203,7 @@ std::unique_ptr<io::File> YpfArchiveDecoder::read_file_impl(
     const auto entry = static_cast<const CustomArchiveEntry*>(&e);
     auto data = input_file.stream.seek(entry->offset).read(entry->size_comp);
     if (entry->compressed)
-        data = algo::pack::zlib_inflate(data);
+        data = algo::pack::zlib_inflate(data, entry->size_orig);
     return std::make_unique<io::File>(entry->path, data);
 }
 
@@ -16,7 +16,14 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "enc/png/png_image_encoder.h"
-#include <png.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include <zlib.h>
+#include "algo/parallel.h"
 #include "algo/range.h"
 #include "err.h"
 #include "io/memory_byte_stream.h"
@@ -24,61 +31,356 @@
 using namespace au;
 using namespace au::enc::png;
 
-static void write_handler(
-    png_structp png_ptr, png_bytep input, png_size_t size)
+namespace
+{
+    enum Filter : u8
+    {
+        None    = 0,
+        Sub     = 1,
+        Up      = 2,
+        Average = 3,
+        Paeth   = 4,
+    };
+
+    struct Band final
+    {
+        size_t first_row;
+        size_t row_count;
+        uLong adler;
+        bstr data;
+    };
+}
+
+static const bstr magic = "\x89PNG\x0D\x0A\x1A\x0A"_b;
+static const int bpp = 4;
+static const size_t band_size = 256 * 1024;
+static const size_t window_size = 32 * 1024;
+
+static std::atomic<PngCompression> default_compression(
+    PngCompression::Fastest);
+
+static int get_level(const PngCompression compression)
+{
+    switch (compression)
+    {
+        case PngCompression::Store:
+            return 0;
+        case PngCompression::Fastest:
+        case PngCompression::Fast:
+            return 1;
+        case PngCompression::Best:
+            return 9;
+    }
+    throw std::logic_error("Bad PNG compression");
+}
+
+static bool uses_adaptive_filtering(const PngCompression compression)
+{
+    return compression == PngCompression::Fast
+        || compression == PngCompression::Best;
+}
+
+static void read_row(const res::Image &image, const size_t y, u8 *output)
+{
+    const auto *pixel = &image.at(0, y);
+    for (const auto x : algo::range(image.width()))
+    {
+        *output++ = pixel->r;
+        *output++ = pixel->g;
+        *output++ = pixel->b;
+        *output++ = pixel->a;
+        pixel++;
+    }
+}
+
+static u8 get_paeth_predictor(const u8 left, const u8 up, const u8 up_left)
+{
+    const int p = left + up - up_left;
+    const int p_left = std::abs(p - left);
+    const int p_up = std::abs(p - up);
+    const int p_up_left = std::abs(p - up_left);
+    if (p_left <= p_up && p_left <= p_up_left)
+        return left;
+    if (p_up <= p_up_left)
+        return up;
+    return up_left;
+}
+
+static void apply_filter(
+    const Filter filter,
+    const u8 *row,
+    const u8 *prev_row,
+    const size_t size,
+    u8 *output)
+{
+    switch (filter)
+    {
+        case Filter::None:
+            std::memcpy(output, row, size);
+            break;
+
+        case Filter::Sub:
+            for (const auto i : algo::range(size))
+                output[i] = row[i] - (i >= bpp ? row[i - bpp] : 0);
+            break;
+
+        case Filter::Up:
+            for (const auto i : algo::range(size))
+                output[i] = row[i] - prev_row[i];
+            break;
+
+        case Filter::Average:
+            for (const auto i : algo::range(size))
+            {
+                const auto left = i >= bpp ? row[i - bpp] : 0;
+                output[i] = row[i] - ((left + prev_row[i]) >> 1);
+            }
+            break;
+
+        case Filter::Paeth:
+            for (const auto i : algo::range(size))
+            {
+                output[i] = row[i] - get_paeth_predictor(
+                    i >= bpp ? row[i - bpp] : 0,
+                    prev_row[i],
+                    i >= bpp ? prev_row[i - bpp] : 0);
+            }
+            break;
+    }
+}
+
+// Same heuristic as libpng: prefers the filter whose output, treated as
+// signed bytes, sums up to the smallest absolute value.
+static size_t get_filter_cost(const u8 *data, const size_t size)
+{
+    size_t cost = 0;
+    for (const auto i : algo::range(size))
+        cost += std::abs(static_cast<s8>(data[i]));
+    return cost;
+}
+
+static void filter_band(
+    const res::Image &image,
+    const Band &band,
+    const PngCompression compression,
+    u8 *output)
+{
+    const auto stride = image.width() * bpp;
+    std::vector<u8> prev_row(stride), row(stride);
+    std::vector<u8> candidate(stride), best_candidate(stride);
+    if (band.first_row)
+        read_row(image, band.first_row - 1, prev_row.data());
+
+    for (const auto y : algo::range(band.row_count))
+    {
+        read_row(image, band.first_row + y, row.data());
+        auto best_filter = Filter::None;
+        if (uses_adaptive_filtering(compression))
+        {
+            size_t best_cost = std::numeric_limits<size_t>::max();
+            for (const auto filter : {
+                Filter::None,
+                Filter::Sub,
+                Filter::Up,
+                Filter::Average,
+                Filter::Paeth})
+            {
+                apply_filter(
+                    filter,
+                    row.data(),
+                    prev_row.data(),
+                    stride,
+                    candidate.data());
+                const auto cost = get_filter_cost(candidate.data(), stride);
+                if (cost < best_cost)
+                {
+                    best_cost = cost;
+                    best_filter = filter;
+                    candidate.swap(best_candidate);
+                }
+            }
+            *output++ = best_filter;
+            std::memcpy(output, best_candidate.data(), stride);
+        }
+        else
+        {
+            *output++ = best_filter;
+            std::memcpy(output, row.data(), stride);
+        }
+        output += stride;
+        row.swap(prev_row);
+    }
+}
+
+// Deflates a band as a part of one raw deflate stream: the band is primed
+// with the tail of the previous band so that matches can cross bands, and
+// every band except the last one ends with a sync flush so that the bands
+// can be simply concatenated.
+static void deflate_band(
+    const bstr &filtered,
+    const size_t offset,
+    const size_t size,
+    const PngCompression compression,
+    const bool is_first,
+    const bool is_last,
+    Band &band)
+{
+    const auto level = get_level(compression);
+    z_stream s;
+    std::memset(&s, 0, sizeof(s));
+    const auto ret = deflateInit2(
+        &s,
+        level,
+        Z_DEFLATED,
+        -MAX_WBITS,
+        8,
+        uses_adaptive_filtering(compression)
+            ? Z_FILTERED
+            : Z_DEFAULT_STRATEGY);
+    if (ret != Z_OK)
+        throw std::logic_error("Failed to initialize zlib stream");
+
+    if (offset && level)
+    {
+        const auto dictionary_size = std::min(offset, window_size);
+        deflateSetDictionary(
+            &s,
+            filtered.get<const Bytef>() + offset - dictionary_size,
+            dictionary_size);
+    }
+
+    // Leave room for the zlib header in the first band.
+    const size_t header_size = is_first ? 2 : 0;
+    band.data.resize(header_size + deflateBound(&s, size) + 16);
+    s.next_in = const_cast<Bytef*>(filtered.get<const Bytef>() + offset);
+    s.avail_in = size;
+    s.next_out = band.data.get<Bytef>() + header_size;
+    s.avail_out = band.data.size() - header_size;
+    while (true)
+    {
+        const auto ret = deflate(&s, is_last ? Z_FINISH : Z_SYNC_FLUSH);
+        if (ret == Z_STREAM_ERROR)
+        {
+            deflateEnd(&s);
+            throw std::logic_error("Failed to deflate PNG data");
+        }
+        if (is_last ? ret == Z_STREAM_END : s.avail_out != 0)
+            break;
+        const auto written = s.next_out - band.data.get<Bytef>();
+        band.data.resize(band.data.size() * 2);
+        s.next_out = band.data.get<Bytef>() + written;
+        s.avail_out = band.data.size() - written;
+    }
+    band.data.resize(s.next_out - band.data.get<Bytef>());
+    deflateEnd(&s);
+
+    band.adler = adler32(
+        adler32(0, nullptr, 0),
+        filtered.get<const Bytef>() + offset,
+        size);
+}
+
+static void write_chunk(
+    io::BaseByteStream &output_stream, const bstr &type, const bstr &data)
+{
+    auto crc = crc32(0, nullptr, 0);
+    crc = crc32(crc, type.get<const Bytef>(), type.size());
+    if (data.size())
+        crc = crc32(crc, data.get<const Bytef>(), data.size());
+    output_stream.write_be<u32>(data.size());
+    output_stream.write(type);
+    output_stream.write(data);
+    output_stream.write_be<u32>(crc);
+}
+
+PngImageEncoder::PngImageEncoder()
+    : PngImageEncoder(default_compression)
 {
-    auto output_stream
-        = reinterpret_cast<io::BaseByteStream*>(png_get_io_ptr(png_ptr));
-    output_stream->write(bstr(input, size));
 }
 
-static void flush_handler(png_structp)
+PngImageEncoder::PngImageEncoder(
+    const PngCompression compression, const size_t thread_count)
+    : compression(compression), thread_count(thread_count)
 {
 }
 
+void PngImageEncoder::set_default_compression(
+    const PngCompression compression)
+{
+    default_compression = compression;
+}
+
 void PngImageEncoder::encode_impl(
     const Logger &logger,
     const res::Image &input_image,
     io::File &output_file) const
 {
-    png_structp png_ptr = png_create_write_struct(
-        PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
-    if (!png_ptr)
-        throw std::logic_error("Failed to create PNG write structure");
-
-    png_infop info_ptr = png_create_info_struct(png_ptr);
-    if (!info_ptr)
-        throw std::logic_error("Failed to create PNG info structure");
-
     const auto width = input_image.width();
     const auto height = input_image.height();
     if (!width || !height)
         throw err::BadDataSizeError();
-    const auto bpp = 4;
-    const auto color_type = PNG_COLOR_TYPE_RGBA;
-    int transformations = PNG_TRANSFORM_BGR;
-
-    png_set_IHDR(
-        png_ptr, info_ptr, width, height, 8, color_type,
-        PNG_INTERLACE_NONE,
-        PNG_COMPRESSION_TYPE_BASE,
-        PNG_FILTER_TYPE_BASE);
-
-    // 0 = no compression, 9 = max compression
-    // 1 produces good file size and is still fast.
-    png_set_filter(png_ptr, 0, PNG_FILTER_NONE);
-    png_set_compression_level(png_ptr, 1);
-
-    png_set_write_fn(
-        png_ptr, &output_file.stream, &write_handler, &flush_handler);
-    png_write_info(png_ptr, info_ptr);
-
-    auto rows = std::make_unique<const u8*[]>(height);
-    for (const auto y : algo::range(height))
-        rows.get()[y] = reinterpret_cast<const u8*>(&input_image.at(0, y));
-    png_set_rows(png_ptr, info_ptr, const_cast<u8**>(rows.get()));
-    png_write_png(png_ptr, info_ptr, transformations, nullptr);
-    png_destroy_write_struct(&png_ptr, &info_ptr);
+
+    const auto stride = width * bpp + 1;
+    const auto rows_per_band = std::max<size_t>(1, band_size / stride);
+    std::vector<Band> bands((height + rows_per_band - 1) / rows_per_band);
+    for (const auto i : algo::range(bands.size()))
+    {
+        bands[i].first_row = i * rows_per_band;
+        bands[i].row_count = std::min(
+            rows_per_band, height - bands[i].first_row);
+    }
+
+    bstr filtered(height * stride);
+    algo::run_in_parallel(bands.size(), thread_count, [&](const size_t i)
+    {
+        filter_band(
+            input_image,
+            bands[i],
+            compression,
+            filtered.get<u8>() + bands[i].first_row * stride);
+    });
+    algo::run_in_parallel(bands.size(), thread_count, [&](const size_t i)
+    {
+        deflate_band(
+            filtered,
+            bands[i].first_row * stride,
+            bands[i].row_count * stride,
+            compression,
+            i == 0,
+            i == bands.size() - 1,
+            bands[i]);
+    });
+
+    const auto level = get_level(compression);
+    const u8 flevel = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+    const u16 zlib_header = (0x78 << 8) | (flevel << 6);
+    bands.front().data[0] = 0x78;
+    bands.front().data[1] = (zlib_header + 31 - zlib_header % 31) & 0xFF;
+
+    auto adler = bands.front().adler;
+    for (const auto i : algo::range(1, bands.size()))
+    {
+        adler = adler32_combine(
+            adler, bands[i].adler, bands[i].row_count * stride);
+    }
+    for (const auto shift : {24, 16, 8, 0})
+        bands.back().data += bstr(1, (adler >> shift) & 0xFF);
+
+    io::MemoryByteStream header_stream;
+    header_stream.write_be<u32>(width);
+    header_stream.write_be<u32>(height);
+    header_stream.write<u8>(8); // bit depth
+    header_stream.write<u8>(6); // RGBA
+    header_stream.write<u8>(0); // deflate
+    header_stream.write<u8>(0); // adaptive filtering
+    header_stream.write<u8>(0); // no interlacing
+
+    output_file.stream.write(magic);
+    write_chunk(
+        output_file.stream, "IHDR"_b, header_stream.seek(0).read_to_eof());
+    for (const auto &band : bands)
+        write_chunk(output_file.stream, "IDAT"_b, band.data);
+    write_chunk(output_file.stream, "IEND"_b, ""_b);
 
     output_file.path.change_extension("png");
 }
@@ -23,13 +23,35 @@ namespace au {
 namespace enc {
 namespace png {
 
+    enum class PngCompression : u8
+    {
+        Store,   // no filtering, stored deflate blocks
+        Fastest, // no filtering, zlib level 1
+        Fast,    // adaptive filtering, zlib level 1
+        Best,    // adaptive filtering, zlib level 9
+    };
+
+    // Splits the image into bands of rows that are filtered and deflated
+    // independently on worker threads, then stitched into a single zlib
+    // stream the same way pigz does.
     class PngImageEncoder final : public BaseImageEncoder
     {
+    public:
+        PngImageEncoder();
+        PngImageEncoder(
+            const PngCompression compression, const size_t thread_count = 0);
+
+        static void set_default_compression(const PngCompression compression);
+
     protected:
         void encode_impl(
             const Logger &logger,
             const res::Image &input_image,
             io::File &output_file) const override;
+
+    private:
+        PngCompression compression;
+        size_t thread_count;
     };
 
 } } }
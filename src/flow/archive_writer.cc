@@ -0,0 +1,117 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/archive_writer.h"
+#include <algorithm>
+#include <cstring>
+#include "algo/format.h"
+#include "algo/str.h"
+
+using namespace au;
+using namespace au::flow;
+
+ArchiveWriter::ArchiveWriter(
+    const io::path &output_path, const size_t buffer_size) :
+        output_stream(output_path, io::FileMode::Write),
+        buffer(buffer_size),
+        buffer_pos(0),
+        flushed_size(0),
+        written_size(0)
+{
+}
+
+ArchiveWriter::~ArchiveWriter()
+{
+}
+
+std::string ArchiveWriter::reserve_name(const io::path &path)
+{
+    auto name = algo::replace_all(path.str(), "\\", "/");
+    while (name.find("./") == 0)
+        name = name.substr(2);
+    while (!name.empty() && name[0] == '/')
+        name = name.substr(1);
+
+    const io::path base_path = name;
+    auto new_path = base_path;
+    int i = 1;
+    while (names.find(new_path.str()) != names.end())
+        new_path.change_stem(base_path.stem() + algo::format("(%d)", i++));
+    name = algo::replace_all(new_path.str(), "\\", "/");
+    names.insert(name);
+    return name;
+}
+
+uoff_t ArchiveWriter::pos() const
+{
+    return flushed_size + buffer_pos;
+}
+
+uoff_t ArchiveWriter::size() const
+{
+    return std::max(written_size, pos());
+}
+
+void ArchiveWriter::write(const bstr &data)
+{
+    if (buffer_pos + data.size() > buffer.size())
+        flush();
+    if (data.size() >= buffer.size())
+    {
+        output_stream.write(data);
+        flushed_size += data.size();
+        written_size = std::max(written_size, flushed_size);
+        return;
+    }
+    std::memcpy(buffer.get<u8>() + buffer_pos, data.get<u8>(), data.size());
+    buffer_pos += data.size();
+}
+
+void ArchiveWriter::write(io::BaseByteStream &input_stream)
+{
+    while (input_stream.left())
+    {
+        if (buffer_pos == buffer.size())
+            flush();
+        const auto chunk_size = std::min<uoff_t>(
+            input_stream.left(), buffer.size() - buffer_pos);
+        input_stream.read(buffer.get<u8>() + buffer_pos, chunk_size);
+        buffer_pos += chunk_size;
+    }
+}
+
+void ArchiveWriter::flush()
+{
+    if (!buffer_pos)
+        return;
+    output_stream.write(buffer.get<u8>(), buffer_pos);
+    flushed_size += buffer_pos;
+    written_size = std::max(written_size, flushed_size);
+    buffer_pos = 0;
+}
+
+void ArchiveWriter::rollback(const uoff_t pos)
+{
+    if (pos >= flushed_size)
+    {
+        buffer_pos = std::min<uoff_t>(buffer_pos, pos - flushed_size);
+        return;
+    }
+    output_stream.seek(pos);
+    flushed_size = pos;
+    buffer_pos = 0;
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include "io/file_byte_stream.h"
+#include "io/path.h"
+#include "types.h"
+
+namespace au {
+namespace flow {
+
+    // Shared back end of savers that pack everything into one container
+    // file. Entries reach the disk in large sequential writes instead of
+    // one small write per field. Not thread safe - the savers serialize
+    // access to it themselves.
+    class ArchiveWriter final
+    {
+    public:
+        ArchiveWriter(
+            const io::path &output_path,
+            const size_t buffer_size = 4 * 1024 * 1024);
+        ~ArchiveWriter();
+
+        // Returns a '/'-separated relative entry name that wasn't used yet.
+        std::string reserve_name(const io::path &path);
+
+        uoff_t pos() const;
+
+        // Returns the end of everything written so far, which lies past
+        // pos() after a rollback.
+        uoff_t size() const;
+
+        void write(const bstr &data);
+        void write(io::BaseByteStream &input_stream);
+        void flush();
+
+        // Discards everything written past the given position. Data that
+        // already reached the disk isn't truncated, only overwritten by the
+        // writes that follow.
+        void rollback(const uoff_t pos);
+
+    private:
+        io::FileByteStream output_stream;
+        std::set<std::string> names;
+        bstr buffer;
+        size_t buffer_pos;
+        uoff_t flushed_size;
+        uoff_t written_size;
+    };
+
+} }
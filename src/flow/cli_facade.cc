@@ -23,8 +23,15 @@
 #include "arg_parser.h"
 #include "dec/idecoder.h"
 #include "dec/registry.h"
+#include "enc/png/png_image_encoder.h"
+#include "err.h"
 #include "flow/file_saver_hdd.h"
+#include "flow/file_saver_null.h"
+#include "flow/file_saver_tar.h"
+#include "flow/file_saver_zip.h"
 #include "flow/parallel_unpacker.h"
+#include "flow/task_tracer.h"
+#include "io/file_byte_stream.h"
 #include "io/file_system.h"
 #include "version.h"
 #include "virtual_file_system.h"
@@ -34,10 +41,20 @@ using namespace au::flow;
 
 namespace
 {
+    enum class SinkType : u8
+    {
+        Directory,
+        Tar,
+        Zip,
+        Null,
+    };
+
     struct Options final
     {
         std::string decoder;
+        SinkType sink_type = SinkType::Directory;
         io::path output_dir;
+        io::path trace_path;
         std::vector<io::path> input_paths;
         bool overwrite;
         bool enable_nested_decoding;
@@ -47,6 +64,8 @@ namespace
         bool should_list_decoders;
         int verbosity = 3;
         unsigned int thread_count;
+        enc::png::PngCompression png_compression
+            = enc::png::PngCompression::Fastest;
     };
 }
 
@@ -61,6 +80,7 @@ private:
     void print_decoder_list() const;
     void print_cli_help() const;
     void parse_cli_options();
+    std::unique_ptr<IFileSaver> create_file_saver() const;
 
     Logger &logger;
     const std::vector<std::string> arguments;
@@ -175,6 +195,22 @@ void CliFacade::Priv::register_cli_options()
     arg_parser.register_flag({"-l", "--list-decoders"})
         ->set_description("Lists available DECODER values.");
 
+    arg_parser.register_switch({"--sink"})
+        ->set_value_name("TYPE")
+        ->set_description(
+            "Specifies where the output files go (defaults to dir). "
+            "For tar and zip, --out names the output archive.")
+        ->add_possible_value("dir", "write to a directory tree")
+        ->add_possible_value("tar", "write to a single tar archive")
+        ->add_possible_value("zip", "write to a single uncompressed zip")
+        ->add_possible_value("null", "discard the output");
+
+    arg_parser.register_switch({"--trace"})
+        ->set_value_name("FILE")
+        ->set_description(
+            "Records timings of every decoding phase to FILE in Chrome "
+            "trace format and prints a per-decoder summary at exit.");
+
     arg_parser.register_switch({"-t", "--threads"})
         ->set_value_name("NUM")
         ->set_description("Sets worker thread count.");
@@ -196,6 +232,15 @@ void CliFacade::Priv::register_cli_options()
             ->hide_possible_values();
     }
 
+    arg_parser.register_switch({"--png-compression"})
+        ->set_value_name("PRESET")
+        ->set_description(
+            "Sets speed/size trade-off of PNG images (defaults to fastest).")
+        ->add_possible_value("store", "don't compress at all")
+        ->add_possible_value("fastest", "compress without filtering")
+        ->add_possible_value("fast", "compress with adaptive filtering")
+        ->add_possible_value("best", "same as fast, but at max zlib level");
+
     arg_parser.register_flag({"--no-color", "--no-colors"})
         ->set_description("Disables colors in console output.");
 
@@ -244,16 +289,55 @@ void CliFacade::Priv::parse_cli_options()
     else
         options.thread_count = 0;
 
+    if (arg_parser.has_switch("--png-compression"))
+    {
+        const auto preset = arg_parser.get_switch("--png-compression");
+        if (preset == "store")
+            options.png_compression = enc::png::PngCompression::Store;
+        else if (preset == "fastest")
+            options.png_compression = enc::png::PngCompression::Fastest;
+        else if (preset == "fast")
+            options.png_compression = enc::png::PngCompression::Fast;
+        else if (preset == "best")
+            options.png_compression = enc::png::PngCompression::Best;
+        else
+            throw err::UsageError("Unknown PNG compression: " + preset);
+        enc::png::PngImageEncoder::set_default_compression(
+            options.png_compression);
+    }
+
     if (arg_parser.has_flag("--no-vfs"))
         VirtualFileSystem::disable();
 
+    if (arg_parser.has_switch("--sink"))
+    {
+        const auto sink = arg_parser.get_switch("--sink");
+        if (sink == "dir")
+            options.sink_type = SinkType::Directory;
+        else if (sink == "tar")
+            options.sink_type = SinkType::Tar;
+        else if (sink == "zip")
+            options.sink_type = SinkType::Zip;
+        else if (sink == "null")
+            options.sink_type = SinkType::Null;
+        else
+            throw err::UsageError("Unknown sink: " + sink);
+    }
+
     if (arg_parser.has_switch("-o"))
         options.output_dir = arg_parser.get_switch("-o");
     else if (arg_parser.has_switch("--out"))
         options.output_dir = arg_parser.get_switch("--out");
+    else if (options.sink_type == SinkType::Tar)
+        options.output_dir = "./output.tar";
+    else if (options.sink_type == SinkType::Zip)
+        options.output_dir = "./output.zip";
     else
         options.output_dir = "./";
 
+    if (arg_parser.has_switch("--trace"))
+        options.trace_path = arg_parser.get_switch("--trace");
+
     if (arg_parser.has_switch("-d"))
         options.decoder = arg_parser.get_switch("-d");
     if (arg_parser.has_switch("--dec"))
@@ -274,6 +358,23 @@ void CliFacade::Priv::parse_cli_options()
     }
 }
 
+std::unique_ptr<IFileSaver> CliFacade::Priv::create_file_saver() const
+{
+    switch (options.sink_type)
+    {
+        case SinkType::Tar:
+            return std::make_unique<FileSaverTar>(options.output_dir);
+        case SinkType::Zip:
+            return std::make_unique<FileSaverZip>(options.output_dir);
+        case SinkType::Null:
+            return std::make_unique<FileSaverNull>();
+        case SinkType::Directory:
+        default:
+            return std::make_unique<FileSaverHdd>(
+                options.output_dir, options.overwrite);
+    }
+}
+
 int CliFacade::Priv::run() const
 {
     if (options.should_show_help)
@@ -306,14 +407,19 @@ int CliFacade::Priv::run() const
         ? std::set<std::string>(name_list.begin(), name_list.end())
         : std::set<std::string>{options.decoder};
 
-    FileSaverHdd file_saver(options.output_dir, options.overwrite);
+    std::unique_ptr<TaskTracer> tracer;
+    if (!options.trace_path.str().empty())
+        tracer = std::make_unique<TaskTracer>();
+
+    const auto file_saver = create_file_saver();
     ParallelUnpackerContext context(
         logger,
-        file_saver,
+        *file_saver,
         registry,
         options.enable_nested_decoding,
         arguments,
-        available_decoders);
+        available_decoders,
+        tracer.get());
 
     ParallelUnpacker unpacker(context);
     for (const auto &input_path : options.input_paths)
@@ -328,7 +434,54 @@ int CliFacade::Priv::run() const
                     io::absolute(input_path), io::FileMode::Read);
             });
     }
-    return unpacker.run(options.thread_count) ? 0 : 1;
+    auto result = unpacker.run(options.thread_count);
+
+    try
+    {
+        if (options.sink_type == SinkType::Tar)
+            static_cast<const FileSaverTar&>(*file_saver).finish();
+        else if (options.sink_type == SinkType::Zip)
+            static_cast<const FileSaverZip&>(*file_saver).finish();
+    }
+    catch (const err::IoError &e)
+    {
+        logger.err("Error finishing archive (%s)\n", e.what());
+        result = false;
+    }
+
+    if (options.sink_type == SinkType::Directory)
+    {
+        const auto stats
+            = static_cast<const FileSaverHdd&>(*file_saver).get_stats();
+        logger.info(
+            "Wrote %llu bytes, peak queue size: %llu bytes, "
+            "average write latency: %.03fs, max write latency: %.03fs\n",
+            static_cast<unsigned long long>(stats.written_bytes),
+            static_cast<unsigned long long>(stats.peak_queued_bytes),
+            stats.written_file_count
+                ? stats.total_write_latency / stats.written_file_count
+                : 0.0,
+            stats.max_write_latency);
+    }
+    else if (options.sink_type == SinkType::Null)
+    {
+        logger.info(
+            "Discarded %llu bytes in %d files\n",
+            static_cast<unsigned long long>(
+                static_cast<const FileSaverNull&>(*file_saver)
+                    .get_saved_byte_count()),
+            static_cast<int>(file_saver->get_saved_file_count()));
+    }
+
+    if (tracer)
+    {
+        io::FileByteStream trace_stream(
+            options.trace_path, io::FileMode::Write);
+        tracer->write_chrome_trace(trace_stream);
+        tracer->print_summary(logger);
+    }
+
+    return result ? 0 : 1;
 }
 
 CliFacade::CliFacade(Logger &logger, const std::vector<std::string> &arguments)
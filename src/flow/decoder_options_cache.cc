@@ -0,0 +1,85 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/decoder_options_cache.h"
+#include <map>
+#include <mutex>
+#include "arg_parser.h"
+
+using namespace au;
+using namespace au::flow;
+
+struct DecoderOptionsCache::Priv final
+{
+    Priv(const std::vector<std::string> &arguments);
+
+    std::shared_ptr<const ArgParser> get_arg_parser(
+        const std::string &decoder_name,
+        const std::vector<ArgParserDecorator> &decorators);
+
+    const std::vector<std::string> arguments;
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<const ArgParser>> arg_parsers;
+};
+
+DecoderOptionsCache::Priv::Priv(const std::vector<std::string> &arguments)
+    : arguments(arguments)
+{
+}
+
+std::shared_ptr<const ArgParser> DecoderOptionsCache::Priv::get_arg_parser(
+    const std::string &decoder_name,
+    const std::vector<ArgParserDecorator> &decorators)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        const auto it = arg_parsers.find(decoder_name);
+        if (it != arg_parsers.end())
+            return it->second;
+    }
+
+    // parsed outside the lock; if two threads race here, the first one to
+    // finish wins and both results are equivalent anyway
+    auto arg_parser = std::make_shared<ArgParser>();
+    for (const auto &decorator : decorators)
+        decorator.register_cli_options(*arg_parser);
+    arg_parser->parse(arguments);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    return arg_parsers.emplace(decoder_name, arg_parser).first->second;
+}
+
+DecoderOptionsCache::DecoderOptionsCache(
+    const std::vector<std::string> &arguments)
+        : p(new Priv(arguments))
+{
+}
+
+DecoderOptionsCache::~DecoderOptionsCache()
+{
+}
+
+void DecoderOptionsCache::apply(
+    const std::string &decoder_name, const dec::IDecoder &decoder) const
+{
+    const auto decorators = decoder.get_arg_parser_decorators();
+    if (decorators.empty())
+        return;
+    const auto arg_parser = p->get_arg_parser(decoder_name, decorators);
+    for (const auto &decorator : decorators)
+        decorator.parse_cli_options(*arg_parser);
+}
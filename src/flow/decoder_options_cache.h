@@ -0,0 +1,46 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "dec/idecoder.h"
+
+namespace au {
+namespace flow {
+
+    // Parses the command line options of every decoder type only once, on
+    // first use, and hands the parsed options to decoder instances of that
+    // type. Safe to use from multiple threads.
+    class DecoderOptionsCache final
+    {
+    public:
+        DecoderOptionsCache(const std::vector<std::string> &arguments);
+        ~DecoderOptionsCache();
+
+        void apply(
+            const std::string &decoder_name,
+            const dec::IDecoder &decoder) const;
+
+    private:
+        struct Priv;
+        std::unique_ptr<Priv> p;
+    };
+
+} }
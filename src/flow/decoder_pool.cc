@@ -0,0 +1,74 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/decoder_pool.h"
+#include <map>
+#include <mutex>
+
+using namespace au;
+using namespace au::flow;
+
+struct DecoderPool::Priv final
+{
+    Priv(
+        const dec::Registry &registry,
+        const DecoderOptionsCache &decoder_options);
+
+    const dec::Registry &registry;
+    const DecoderOptionsCache &decoder_options;
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<const dec::IDecoder>> decoders;
+};
+
+DecoderPool::Priv::Priv(
+    const dec::Registry &registry,
+    const DecoderOptionsCache &decoder_options) :
+        registry(registry),
+        decoder_options(decoder_options)
+{
+}
+
+DecoderPool::DecoderPool(
+    const dec::Registry &registry,
+    const DecoderOptionsCache &decoder_options)
+        : p(new Priv(registry, decoder_options))
+{
+}
+
+DecoderPool::~DecoderPool()
+{
+}
+
+std::shared_ptr<const dec::IDecoder> DecoderPool::get(
+    const std::string &decoder_name) const
+{
+    {
+        std::unique_lock<std::mutex> lock(p->mutex);
+        const auto it = p->decoders.find(decoder_name);
+        if (it != p->decoders.end())
+            return it->second;
+    }
+
+    // configured before being shared, so that other threads never see a
+    // half-configured decoder; bad options throw here and aren't cached
+    std::shared_ptr<dec::IDecoder> decoder
+        = p->registry.create_decoder(decoder_name);
+    p->decoder_options.apply(decoder_name, *decoder);
+
+    std::unique_lock<std::mutex> lock(p->mutex);
+    return p->decoders.emplace(decoder_name, decoder).first->second;
+}
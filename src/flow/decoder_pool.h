@@ -0,0 +1,48 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "dec/idecoder.h"
+#include "dec/registry.h"
+#include "flow/decoder_options_cache.h"
+
+namespace au {
+namespace flow {
+
+    // Keeps one decoder instance per decoder name, configured with the
+    // command line options on first use and shared by all tasks afterwards.
+    // Safe to use from multiple threads.
+    class DecoderPool final
+    {
+    public:
+        DecoderPool(
+            const dec::Registry &registry,
+            const DecoderOptionsCache &decoder_options);
+        ~DecoderPool();
+
+        std::shared_ptr<const dec::IDecoder> get(
+            const std::string &decoder_name) const;
+
+    private:
+        struct Priv;
+        std::unique_ptr<Priv> p;
+    };
+
+} }
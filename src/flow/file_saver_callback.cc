@@ -62,3 +62,7 @@ size_t FileSaverCallback::get_saved_file_count() const
 {
     return p->saved_file_count;
 }
+
+void FileSaverCallback::flush() const
+{
+}
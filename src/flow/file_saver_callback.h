@@ -35,6 +35,7 @@ namespace flow {
         void set_callback(FileSaveCallback callback);
         io::path save(std::shared_ptr<io::File> file) const override;
         size_t get_saved_file_count() const override;
+        void flush() const override;
 
     private:
         struct Priv;
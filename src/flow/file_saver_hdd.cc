@@ -16,34 +16,97 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "flow/file_saver_hdd.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <set>
+#include <thread>
 #include "algo/format.h"
+#include "err.h"
 #include "io/file_byte_stream.h"
 #include "io/file_system.h"
 
 using namespace au;
 using namespace au::flow;
 
-static std::mutex mutex;
+// guards path reservation across all savers, so that two savers writing to
+// the same directory never pick the same name
+static std::mutex path_mutex;
+
+namespace
+{
+    struct WriteJob final
+    {
+        std::unique_ptr<io::File> source_file;
+        io::path path;
+        uoff_t size;
+        std::chrono::steady_clock::time_point queue_time;
+        FileWriteCallback on_written;
+    };
+}
 
 struct FileSaverHdd::Priv final
 {
     Priv(
         const io::path &output_dir,
-        const bool overwrite);
+        const bool overwrite,
+        const uoff_t max_queued_bytes,
+        const size_t max_queued_files);
+    ~Priv();
 
     io::path make_path_unique(const io::path &path);
+    void create_directories(const io::path &path);
+    void enqueue(std::unique_ptr<WriteJob> job);
+    void write_loop();
 
     io::path output_dir;
     bool overwrite;
-    size_t saved_file_count;
+    uoff_t max_queued_bytes;
+    size_t max_queued_files;
+
+    // guarded by path_mutex
     std::set<io::path> paths;
+    std::set<io::path> known_directories;
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_not_empty;
+    std::condition_variable queue_not_full;
+    std::condition_variable queue_drained;
+    std::deque<std::unique_ptr<WriteJob>> queue;
+    bool writing;
+    bool stopping;
+    FileSaverHddStats stats;
+    std::vector<std::string> failed_paths;
+
+    std::thread writer;
 };
 
-FileSaverHdd::Priv::Priv(const io::path &output_dir, const bool overwrite)
-    : output_dir(output_dir), overwrite(overwrite), saved_file_count(0)
+FileSaverHdd::Priv::Priv(
+    const io::path &output_dir,
+    const bool overwrite,
+    const uoff_t max_queued_bytes,
+    const size_t max_queued_files) :
+        output_dir(output_dir),
+        overwrite(overwrite),
+        max_queued_bytes(max_queued_bytes),
+        max_queued_files(std::max<size_t>(1, max_queued_files)),
+        writing(false),
+        stopping(false),
+        stats()
+{
+    writer = std::thread([&]() { write_loop(); });
+}
+
+FileSaverHdd::Priv::~Priv()
 {
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        stopping = true;
+    }
+    queue_not_empty.notify_all();
+    writer.join();
 }
 
 io::path FileSaverHdd::Priv::make_path_unique(const io::path &path)
@@ -59,9 +122,118 @@ io::path FileSaverHdd::Priv::make_path_unique(const io::path &path)
     return new_path;
 }
 
+void FileSaverHdd::Priv::create_directories(const io::path &path)
+{
+    if (known_directories.find(path) != known_directories.end())
+        return;
+    io::create_directories(path);
+    known_directories.insert(path);
+}
+
+void FileSaverHdd::Priv::enqueue(std::unique_ptr<WriteJob> job)
+{
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        queue_not_full.wait(lock, [&]()
+        {
+            return stats.queued_file_count < max_queued_files
+                && (stats.queued_bytes == 0
+                    || stats.queued_bytes + job->size <= max_queued_bytes);
+        });
+        stats.queued_bytes += job->size;
+        stats.peak_queued_bytes
+            = std::max(stats.peak_queued_bytes, stats.queued_bytes);
+        ++stats.queued_file_count;
+        stats.peak_queued_file_count = std::max(
+            stats.peak_queued_file_count, stats.queued_file_count);
+        queue.push_back(std::move(job));
+    }
+    queue_not_empty.notify_one();
+}
+
+void FileSaverHdd::Priv::write_loop()
+{
+    while (true)
+    {
+        std::unique_ptr<WriteJob> job;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_not_empty.wait(lock, [&]()
+            {
+                return stopping || !queue.empty();
+            });
+            if (queue.empty())
+                break;
+            job = std::move(queue.front());
+            queue.pop_front();
+            writing = true;
+        }
+
+        std::string error;
+        try
+        {
+            io::FileByteStream output_stream(job->path, io::FileMode::Write);
+            job->source_file->stream.seek(0);
+            output_stream.write(job->source_file->stream);
+        }
+        catch (const std::exception &e)
+        {
+            error = e.what();
+            if (error.empty())
+                error = "unknown error";
+        }
+        catch (...)
+        {
+            error = "unknown error";
+        }
+        const auto success = error.empty();
+        const auto latency = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - job->queue_time).count();
+
+        // reported before the job counts as done, so that flush() returns
+        // only after every outcome is known
+        if (job->on_written)
+        {
+            try
+            {
+                job->on_written(job->path, error);
+            }
+            catch (...)
+            {
+            }
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            stats.queued_bytes -= job->size;
+            --stats.queued_file_count;
+            if (success)
+            {
+                stats.written_bytes += job->size;
+                ++stats.written_file_count;
+                stats.total_write_latency += latency;
+                stats.max_write_latency
+                    = std::max(stats.max_write_latency, latency);
+            }
+            else
+            {
+                ++stats.failed_file_count;
+                if (!job->on_written)
+                    failed_paths.push_back(job->path.str());
+            }
+            writing = false;
+        }
+        queue_not_full.notify_all();
+        queue_drained.notify_all();
+    }
+}
+
 FileSaverHdd::FileSaverHdd(
-    const io::path &output_dir, const bool overwrite)
-    : p(new Priv(output_dir, overwrite))
+    const io::path &output_dir,
+    const bool overwrite,
+    const uoff_t max_queued_bytes,
+    const size_t max_queued_files)
+    : p(new Priv(output_dir, overwrite, max_queued_bytes, max_queued_files))
 {
 }
 
@@ -71,17 +243,66 @@ FileSaverHdd::~FileSaverHdd()
 
 io::path FileSaverHdd::save(std::shared_ptr<io::File> file) const
 {
-    std::unique_lock<std::mutex> lock(mutex);
-    const auto full_path = p->make_path_unique(p->output_dir / file->path);
-    io::create_directories(full_path.parent());
-    io::FileByteStream output_stream(full_path, io::FileMode::Write);
-    file->stream.seek(0);
-    output_stream.write(file->stream);
-    ++p->saved_file_count;
+    return save_async(file, nullptr);
+}
+
+io::path FileSaverHdd::save_async(
+    std::shared_ptr<io::File> file, const FileWriteCallback &on_written) const
+{
+    auto job = std::make_unique<WriteJob>();
+    {
+        std::unique_lock<std::mutex> lock(path_mutex);
+        job->path = p->make_path_unique(p->output_dir / file->path);
+        p->create_directories(job->path.parent());
+        // claims the name on the disk right away, so that other savers
+        // that don't overwrite files see it, but keeps the descriptor
+        // closed until the writer thread gets to the job
+        io::FileByteStream(job->path, io::FileMode::Write);
+    }
+
+    // the writer works on its own copy, so that the caller is free to keep
+    // using the original stream
+    job->source_file = std::make_unique<io::File>(*file);
+    job->size = job->source_file->stream.size();
+    job->queue_time = std::chrono::steady_clock::now();
+    job->on_written = on_written;
+
+    const auto full_path = job->path;
+    p->enqueue(std::move(job));
     return full_path;
 }
 
 size_t FileSaverHdd::get_saved_file_count() const
 {
-    return p->saved_file_count;
+    std::unique_lock<std::mutex> lock(p->queue_mutex);
+    return p->stats.written_file_count;
+}
+
+void FileSaverHdd::flush() const
+{
+    std::vector<std::string> failed_paths;
+    {
+        std::unique_lock<std::mutex> lock(p->queue_mutex);
+        p->queue_drained.wait(lock, [&]()
+        {
+            return p->queue.empty() && !p->writing;
+        });
+        failed_paths.swap(p->failed_paths);
+    }
+    if (failed_paths.empty())
+        return;
+    std::string message = "Could not write ";
+    for (const auto &path : failed_paths)
+    {
+        if (&path != &failed_paths.front())
+            message += ", ";
+        message += path;
+    }
+    throw err::IoError(message);
+}
+
+FileSaverHddStats FileSaverHdd::get_stats() const
+{
+    std::unique_lock<std::mutex> lock(p->queue_mutex);
+    return p->stats;
 }
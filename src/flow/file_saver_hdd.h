@@ -19,18 +19,48 @@
 
 #include <memory>
 #include "flow/ifile_saver.h"
+#include "types.h"
 
 namespace au {
 namespace flow {
 
+    struct FileSaverHddStats final
+    {
+        uoff_t queued_bytes;
+        uoff_t peak_queued_bytes;
+        size_t queued_file_count;
+        size_t peak_queued_file_count;
+        uoff_t written_bytes;
+        size_t written_file_count;
+        size_t failed_file_count;
+        // time between save() and the file being fully written, in seconds
+        double total_write_latency;
+        double max_write_latency;
+    };
+
+    // Reserves output paths synchronously, but leaves writing the content
+    // to a dedicated writer thread. save() blocks only when the files
+    // waiting to be written exceed max_queued_bytes or max_queued_files.
+    // Failed writes are reported by the callback given to save_async(), or
+    // by flush() for files that came without one.
     class FileSaverHdd final : public IFileSaver
     {
     public:
-        FileSaverHdd(const io::path &output_dir, const bool overwrite);
+        FileSaverHdd(
+            const io::path &output_dir,
+            const bool overwrite,
+            const uoff_t max_queued_bytes = 64 * 1024 * 1024,
+            const size_t max_queued_files = 1024);
         ~FileSaverHdd();
 
         io::path save(std::shared_ptr<io::File> file) const override;
+        io::path save_async(
+            std::shared_ptr<io::File> file,
+            const FileWriteCallback &on_written) const override;
         size_t get_saved_file_count() const override;
+        void flush() const override;
+
+        FileSaverHddStats get_stats() const;
 
     private:
         struct Priv;
@@ -0,0 +1,70 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/file_saver_null.h"
+#include <algorithm>
+#include <atomic>
+
+using namespace au;
+using namespace au::flow;
+
+struct FileSaverNull::Priv final
+{
+    std::atomic<size_t> saved_file_count;
+    std::atomic<uoff_t> saved_byte_count;
+};
+
+FileSaverNull::FileSaverNull() : p(new Priv())
+{
+    p->saved_file_count = 0;
+    p->saved_byte_count = 0;
+}
+
+FileSaverNull::~FileSaverNull()
+{
+}
+
+io::path FileSaverNull::save(std::shared_ptr<io::File> file) const
+{
+    // entries of some archives are only decoded as they're read, so the
+    // content has to be read in full for the timings to mean anything
+    const auto stream = file->stream.clone();
+    bstr chunk(std::min<uoff_t>(stream->size(), 0x10000));
+    stream->seek(0);
+    while (stream->left())
+    {
+        const auto chunk_size = std::min<uoff_t>(stream->left(), chunk.size());
+        stream->read(chunk.get<u8>(), chunk_size);
+        p->saved_byte_count += chunk_size;
+    }
+    ++p->saved_file_count;
+    return file->path;
+}
+
+size_t FileSaverNull::get_saved_file_count() const
+{
+    return p->saved_file_count;
+}
+
+void FileSaverNull::flush() const
+{
+}
+
+uoff_t FileSaverNull::get_saved_byte_count() const
+{
+    return p->saved_byte_count;
+}
@@ -0,0 +1,248 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/file_saver_tar.h"
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include "algo/format.h"
+#include "algo/range.h"
+#include "err.h"
+#include "flow/archive_writer.h"
+
+using namespace au;
+using namespace au::flow;
+
+static const size_t block_size = 512;
+static const size_t record_size = 20 * block_size;
+static const size_t max_name_size = 100;
+static const size_t max_prefix_size = 155;
+
+struct FileSaverTar::Priv final
+{
+    Priv(const io::path &output_path);
+    ~Priv();
+
+    void write_header(
+        const std::string &name,
+        const std::string &prefix,
+        const uoff_t size,
+        const char type);
+    void write_entry_header(const std::string &name, const uoff_t size);
+    void write_padding(const uoff_t size, const size_t alignment);
+    void write_end_of_archive();
+
+    std::mutex mutex;
+    ArchiveWriter writer;
+    std::time_t mtime;
+    size_t saved_file_count;
+    bool finished;
+};
+
+static void write_octal(
+    bstr &header, const size_t offset, const size_t size, uoff_t value)
+{
+    const auto str = algo::format(
+        "%0*llo", static_cast<int>(size - 1),
+        static_cast<unsigned long long>(value));
+    if (str.size() < size)
+    {
+        std::memcpy(header.get<char>() + offset, str.c_str(), str.size());
+        return;
+    }
+
+    // GNU extension for numbers that don't fit: big endian base-256
+    for (const auto i : algo::range(size - 1, 0, -1))
+    {
+        header[offset + i] = value & 0xFF;
+        value >>= 8;
+    }
+    header[offset] = 0x80;
+}
+
+static void write_string(
+    bstr &header, const size_t offset, const std::string &str)
+{
+    std::memcpy(header.get<char>() + offset, str.c_str(), str.size());
+}
+
+FileSaverTar::Priv::Priv(const io::path &output_path) :
+    writer(output_path),
+    mtime(std::time(nullptr)),
+    saved_file_count(0),
+    finished(false)
+{
+}
+
+FileSaverTar::Priv::~Priv()
+{
+    // best effort for callers that never call finish(); they have no way
+    // to learn about errors anyway
+    if (finished)
+        return;
+    try
+    {
+        write_end_of_archive();
+    }
+    catch (...)
+    {
+    }
+}
+
+void FileSaverTar::Priv::write_header(
+    const std::string &name,
+    const std::string &prefix,
+    const uoff_t size,
+    const char type)
+{
+    bstr header(block_size);
+    write_string(header, 0, name);
+    write_octal(header, 100, 8, 0644);
+    write_octal(header, 108, 8, 0);
+    write_octal(header, 116, 8, 0);
+    write_octal(header, 124, 12, size);
+    write_octal(header, 136, 12, mtime);
+    write_string(header, 148, "        ");
+    header[156] = type;
+    write_string(header, 257, "ustar");
+    write_string(header, 263, "00");
+    write_string(header, 345, prefix);
+
+    u32 checksum = 0;
+    for (const auto c : header)
+        checksum += c;
+    write_octal(header, 148, 7, checksum);
+    header[154] = '\0';
+    writer.write(header);
+}
+
+// Long names are split into ustar's prefix and name fields where possible;
+// anything else falls back to GNU long name entries.
+void FileSaverTar::Priv::write_entry_header(
+    const std::string &name, const uoff_t size)
+{
+    if (name.size() <= max_name_size)
+    {
+        write_header(name, "", size, '0');
+        return;
+    }
+
+    for (auto pos = name.find('/');
+        pos != name.npos && pos <= max_prefix_size;
+        pos = name.find('/', pos + 1))
+    {
+        const auto suffix_size = name.size() - pos - 1;
+        if (suffix_size && suffix_size <= max_name_size)
+        {
+            write_header(
+                name.substr(pos + 1), name.substr(0, pos), size, '0');
+            return;
+        }
+    }
+
+    write_header("././@LongLink", "", name.size() + 1, 'L');
+    writer.write(bstr(name) + "\x00"_b);
+    write_padding(name.size() + 1, block_size);
+    write_header(name.substr(0, max_name_size), "", size, '0');
+}
+
+void FileSaverTar::Priv::write_padding(
+    const uoff_t size, const size_t alignment)
+{
+    if (size % alignment)
+        writer.write(bstr(alignment - size % alignment));
+}
+
+void FileSaverTar::Priv::write_end_of_archive()
+{
+    writer.write(bstr(block_size * 2));
+
+    // entries rolled back after a failed read can leave data past the end,
+    // which readers would take for garbage records unless it's zeroed
+    while (writer.pos() < writer.size())
+    {
+        writer.write(bstr(
+            std::min<uoff_t>(writer.size() - writer.pos(), record_size)));
+    }
+
+    write_padding(writer.pos(), record_size);
+    writer.flush();
+}
+
+FileSaverTar::FileSaverTar(const io::path &output_path)
+    : p(new Priv(output_path))
+{
+}
+
+FileSaverTar::~FileSaverTar()
+{
+}
+
+io::path FileSaverTar::save(std::shared_ptr<io::File> file) const
+{
+    std::unique_lock<std::mutex> lock(p->mutex);
+    const auto name = p->writer.reserve_name(file->path);
+    const auto size = file->stream.size();
+    const auto old_pos = file->stream.pos();
+
+    // the header announces the full size, so an entry cut short by a failing
+    // stream would misalign everything after it - take it back instead
+    const auto entry_pos = p->writer.pos();
+    try
+    {
+        p->write_entry_header(name, size);
+        p->writer.write(file->stream.seek(0));
+    }
+    catch (...)
+    {
+        p->writer.rollback(entry_pos);
+        throw;
+    }
+    file->stream.seek(old_pos);
+    p->write_padding(size, block_size);
+    ++p->saved_file_count;
+    return name;
+}
+
+size_t FileSaverTar::get_saved_file_count() const
+{
+    std::unique_lock<std::mutex> lock(p->mutex);
+    return p->saved_file_count;
+}
+
+void FileSaverTar::flush() const
+{
+    std::unique_lock<std::mutex> lock(p->mutex);
+    p->writer.flush();
+}
+
+void FileSaverTar::finish() const
+{
+    std::unique_lock<std::mutex> lock(p->mutex);
+    if (p->finished)
+        return;
+    try
+    {
+        p->write_end_of_archive();
+    }
+    catch (const std::exception &e)
+    {
+        throw err::IoError(
+            std::string("Could not finish tar archive: ") + e.what());
+    }
+    p->finished = true;
+}
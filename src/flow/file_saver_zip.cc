@@ -0,0 +1,266 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/file_saver_zip.h"
+#include <ctime>
+#include <mutex>
+#include <vector>
+#include <zlib.h>
+#include "err.h"
+#include "flow/archive_writer.h"
+#include "io/memory_byte_stream.h"
+
+using namespace au;
+using namespace au::flow;
+
+namespace
+{
+    struct CentralDirectoryEntry final
+    {
+        std::string name;
+        u32 crc;
+        uoff_t size;
+        uoff_t offset;
+    };
+}
+
+static const uoff_t max_u16 = 0xFFFF;
+static const uoff_t max_u32 = 0xFFFFFFFF;
+static const u16 zip_version = 20;
+static const u16 zip64_version = 45;
+static const u16 utf8_flag = 0x800;
+
+struct FileSaverZip::Priv final
+{
+    Priv(const io::path &output_path);
+
+    void write_local_header(const CentralDirectoryEntry &entry);
+    void write_central_directory_header(const CentralDirectoryEntry &entry);
+    void write_central_directory();
+
+    std::mutex mutex;
+    ArchiveWriter writer;
+    u16 dos_time;
+    u16 dos_date;
+    std::vector<CentralDirectoryEntry> entries;
+    bool finished;
+};
+
+static void write_header(ArchiveWriter &writer, io::MemoryByteStream &stream)
+{
+    writer.write(stream.seek(0).read_to_eof());
+}
+
+static u32 get_crc(io::BaseByteStream &input_stream)
+{
+    bstr chunk(std::min<uoff_t>(input_stream.size(), 0x10000));
+    auto crc = crc32(0, nullptr, 0);
+    input_stream.seek(0);
+    while (input_stream.left())
+    {
+        const auto chunk_size
+            = std::min<uoff_t>(input_stream.left(), chunk.size());
+        input_stream.read(chunk.get<u8>(), chunk_size);
+        crc = crc32(crc, chunk.get<const Bytef>(), chunk_size);
+    }
+    return crc;
+}
+
+FileSaverZip::Priv::Priv(const io::path &output_path) :
+    writer(output_path),
+    finished(false)
+{
+    const auto now = std::time(nullptr);
+    const auto tm = std::localtime(&now);
+    dos_time = (tm->tm_hour << 11) | (tm->tm_min << 5) | (tm->tm_sec / 2);
+    dos_date = ((tm->tm_year - 80) << 9)
+        | ((tm->tm_mon + 1) << 5)
+        | tm->tm_mday;
+}
+
+void FileSaverZip::Priv::write_local_header(
+    const CentralDirectoryEntry &entry)
+{
+    const auto is_zip64 = entry.size >= max_u32;
+    io::MemoryByteStream header_stream;
+    header_stream.write("PK\x03\x04"_b);
+    header_stream.write_le<u16>(is_zip64 ? zip64_version : zip_version);
+    header_stream.write_le<u16>(utf8_flag);
+    header_stream.write_le<u16>(0); // stored
+    header_stream.write_le<u16>(dos_time);
+    header_stream.write_le<u16>(dos_date);
+    header_stream.write_le<u32>(entry.crc);
+    header_stream.write_le<u32>(is_zip64 ? max_u32 : entry.size);
+    header_stream.write_le<u32>(is_zip64 ? max_u32 : entry.size);
+    header_stream.write_le<u16>(entry.name.size());
+    header_stream.write_le<u16>(is_zip64 ? 20 : 0);
+    header_stream.write(entry.name);
+    if (is_zip64)
+    {
+        header_stream.write_le<u16>(1);
+        header_stream.write_le<u16>(16);
+        header_stream.write_le<u64>(entry.size);
+        header_stream.write_le<u64>(entry.size);
+    }
+    write_header(writer, header_stream);
+}
+
+void FileSaverZip::Priv::write_central_directory_header(
+    const CentralDirectoryEntry &entry)
+{
+    const auto size_is_zip64 = entry.size >= max_u32;
+    const auto offset_is_zip64 = entry.offset >= max_u32;
+    io::MemoryByteStream extra_stream;
+    if (size_is_zip64 || offset_is_zip64)
+    {
+        extra_stream.write_le<u16>(1);
+        extra_stream.write_le<u16>(
+            (size_is_zip64 ? 16 : 0) + (offset_is_zip64 ? 8 : 0));
+        if (size_is_zip64)
+        {
+            extra_stream.write_le<u64>(entry.size);
+            extra_stream.write_le<u64>(entry.size);
+        }
+        if (offset_is_zip64)
+            extra_stream.write_le<u64>(entry.offset);
+    }
+
+    io::MemoryByteStream header_stream;
+    header_stream.write("PK\x01\x02"_b);
+    header_stream.write_le<u16>(zip64_version);
+    header_stream.write_le<u16>(
+        extra_stream.size() ? zip64_version : zip_version);
+    header_stream.write_le<u16>(utf8_flag);
+    header_stream.write_le<u16>(0); // stored
+    header_stream.write_le<u16>(dos_time);
+    header_stream.write_le<u16>(dos_date);
+    header_stream.write_le<u32>(entry.crc);
+    header_stream.write_le<u32>(size_is_zip64 ? max_u32 : entry.size);
+    header_stream.write_le<u32>(size_is_zip64 ? max_u32 : entry.size);
+    header_stream.write_le<u16>(entry.name.size());
+    header_stream.write_le<u16>(extra_stream.size());
+    header_stream.write_le<u16>(0); // comment size
+    header_stream.write_le<u16>(0); // disk number
+    header_stream.write_le<u16>(0); // internal attributes
+    header_stream.write_le<u32>(0); // external attributes
+    header_stream.write_le<u32>(offset_is_zip64 ? max_u32 : entry.offset);
+    header_stream.write(entry.name);
+    header_stream.write(extra_stream.seek(0).read_to_eof());
+    write_header(writer, header_stream);
+}
+
+void FileSaverZip::Priv::write_central_directory()
+{
+    const auto directory_offset = writer.pos();
+    for (const auto &entry : entries)
+        write_central_directory_header(entry);
+    const auto directory_size = writer.pos() - directory_offset;
+    const auto entry_count = entries.size();
+
+    io::MemoryByteStream footer_stream;
+    if (entry_count >= max_u16
+        || directory_offset >= max_u32
+        || directory_size >= max_u32)
+    {
+        const auto zip64_footer_offset = writer.pos();
+        footer_stream.write("PK\x06\x06"_b);
+        footer_stream.write_le<u64>(44);
+        footer_stream.write_le<u16>(zip64_version);
+        footer_stream.write_le<u16>(zip64_version);
+        footer_stream.write_le<u32>(0);
+        footer_stream.write_le<u32>(0);
+        footer_stream.write_le<u64>(entry_count);
+        footer_stream.write_le<u64>(entry_count);
+        footer_stream.write_le<u64>(directory_size);
+        footer_stream.write_le<u64>(directory_offset);
+
+        footer_stream.write("PK\x06\x07"_b);
+        footer_stream.write_le<u32>(0);
+        footer_stream.write_le<u64>(zip64_footer_offset);
+        footer_stream.write_le<u32>(1);
+    }
+
+    footer_stream.write("PK\x05\x06"_b);
+    footer_stream.write_le<u16>(0);
+    footer_stream.write_le<u16>(0);
+    footer_stream.write_le<u16>(std::min<uoff_t>(entry_count, max_u16));
+    footer_stream.write_le<u16>(std::min<uoff_t>(entry_count, max_u16));
+    footer_stream.write_le<u32>(std::min<uoff_t>(directory_size, max_u32));
+    footer_stream.write_le<u32>(std::min<uoff_t>(directory_offset, max_u32));
+    footer_stream.write_le<u16>(0); // comment size
+    write_header(writer, footer_stream);
+    writer.flush();
+}
+
+FileSaverZip::FileSaverZip(const io::path &output_path)
+    : p(new Priv(output_path))
+{
+}
+
+FileSaverZip::~FileSaverZip()
+{
+}
+
+io::path FileSaverZip::save(std::shared_ptr<io::File> file) const
+{
+    // the local header needs the checksum up front; computing it doesn't
+    // touch the archive, so other saves can go on in the meantime
+    CentralDirectoryEntry entry;
+    entry.size = file->stream.size();
+    const auto old_pos = file->stream.pos();
+    entry.crc = get_crc(file->stream);
+
+    std::unique_lock<std::mutex> lock(p->mutex);
+    entry.name = p->writer.reserve_name(file->path);
+    entry.offset = p->writer.pos();
+    p->write_local_header(entry);
+    p->writer.write(file->stream.seek(0));
+    file->stream.seek(old_pos);
+
+    p->entries.push_back(entry);
+    return entry.name;
+}
+
+size_t FileSaverZip::get_saved_file_count() const
+{
+    std::unique_lock<std::mutex> lock(p->mutex);
+    return p->entries.size();
+}
+
+void FileSaverZip::flush() const
+{
+    std::unique_lock<std::mutex> lock(p->mutex);
+    p->writer.flush();
+}
+
+void FileSaverZip::finish() const
+{
+    std::unique_lock<std::mutex> lock(p->mutex);
+    if (p->finished)
+        return;
+    try
+    {
+        p->write_central_directory();
+    }
+    catch (const std::exception &e)
+    {
+        throw err::IoError(
+            std::string("Could not write zip central directory: ")
+            + e.what());
+    }
+    p->finished = true;
+}
@@ -17,17 +17,40 @@
 
 #pragma once
 
+#include <functional>
 #include "io/file.h"
 
 namespace au {
 namespace flow {
 
+    // Receives the path of a saved file once its content is fully written,
+    // or the reason it couldn't be (empty on success).
+    using FileWriteCallback = std::function<void(
+        const io::path &path, const std::string &error)>;
+
     class IFileSaver
     {
     public:
         virtual ~IFileSaver() {}
         virtual io::path save(std::shared_ptr<io::File> file) const = 0;
+
+        // Same as save(), but savers that write in the background may
+        // return early and report the outcome of the write through
+        // on_written instead of flush(). Errors found before that still
+        // throw.
+        virtual io::path save_async(
+            std::shared_ptr<io::File> file,
+            const FileWriteCallback &on_written) const
+        {
+            const auto path = save(file);
+            on_written(path, "");
+            return path;
+        }
+
         virtual size_t get_saved_file_count() const = 0;
+
+        // blocks until every file passed to save() is fully written
+        virtual void flush() const = 0;
     };
 
 } }
@@ -38,8 +38,14 @@ ParallelDecoderAdapter::~ParallelDecoderAdapter()
 void ParallelDecoderAdapter::visit(const dec::BaseArchiveDecoder &decoder)
 {
     auto input_file = this->input_file;
+    const auto tracer = parent_task->task_context.unpacker_context.tracer;
+    const auto decoder_name = parent_task->decoder_name;
+    TraceSpan span(
+        tracer, "read_meta", decoder_name, parent_task->base_name.str());
+    span.set_bytes_in(input_file->stream.size());
     auto meta = std::shared_ptr<dec::ArchiveMeta>(
         decoder.read_meta(parent_task->logger, *input_file));
+    span.finish();
     parent_task->logger.info(
         "archive contains %d files.\n", meta->entries.size());
 
@@ -54,11 +60,16 @@ void ParallelDecoderAdapter::visit(const dec::BaseArchiveDecoder &decoder)
     {
         parent_task->save_file(
             input_file,
-            [meta, &entry, &decoder, vfs_bridge]
+            [meta, &entry, &decoder, vfs_bridge, tracer, decoder_name]
             (io::File &input_file_copy, const Logger &logger)
             {
-                return decoder.read_file(
+                TraceSpan span(
+                    tracer, "read_file", decoder_name, entry->path.str());
+                auto output_file = decoder.read_file(
                     logger, input_file_copy, *meta, *entry);
+                if (output_file)
+                    span.set_bytes_out(output_file->stream.size());
+                return output_file;
             },
             decoder,
             entry->path.str());
@@ -67,37 +78,75 @@ void ParallelDecoderAdapter::visit(const dec::BaseArchiveDecoder &decoder)
 
 void ParallelDecoderAdapter::visit(const dec::BaseFileDecoder &decoder)
 {
+    const auto tracer = parent_task->task_context.unpacker_context.tracer;
+    const auto decoder_name = parent_task->decoder_name;
     parent_task->save_file(
         input_file,
-        [&decoder](io::File &input_file_copy, const Logger &logger)
+        [&decoder, tracer, decoder_name]
+        (io::File &input_file_copy, const Logger &logger)
         {
-            return decoder.decode(logger, input_file_copy);
+            TraceSpan span(
+                tracer,
+                "decode",
+                decoder_name,
+                input_file_copy.path.str());
+            span.set_bytes_in(input_file_copy.stream.size());
+            auto output_file = decoder.decode(logger, input_file_copy);
+            if (output_file)
+                span.set_bytes_out(output_file->stream.size());
+            return output_file;
         },
         decoder);
 }
 
 void ParallelDecoderAdapter::visit(const dec::BaseImageDecoder &decoder)
 {
+    const auto tracer = parent_task->task_context.unpacker_context.tracer;
+    const auto decoder_name = parent_task->decoder_name;
     parent_task->save_file(
         input_file,
-        [&decoder](io::File &input_file_copy, const Logger &logger)
+        [&decoder, tracer, decoder_name]
+        (io::File &input_file_copy, const Logger &logger)
         {
+            const auto file_name = input_file_copy.path.str();
+            TraceSpan decode_span(tracer, "decode", decoder_name, file_name);
+            decode_span.set_bytes_in(input_file_copy.stream.size());
             auto output_file = decoder.decode(logger, input_file_copy);
+            decode_span.finish();
+
+            TraceSpan encode_span(tracer, "encode", decoder_name, file_name);
             const auto encoder = enc::png::PngImageEncoder();
-            return encoder.encode(logger, output_file, input_file_copy.path);
+            auto encoded_file = encoder.encode(
+                logger, output_file, input_file_copy.path);
+            if (encoded_file)
+                encode_span.set_bytes_out(encoded_file->stream.size());
+            return encoded_file;
         },
         decoder);
 }
 
 void ParallelDecoderAdapter::visit(const dec::BaseAudioDecoder &decoder)
 {
+    const auto tracer = parent_task->task_context.unpacker_context.tracer;
+    const auto decoder_name = parent_task->decoder_name;
     parent_task->save_file(
         input_file,
-        [&decoder](io::File &input_file_copy, const Logger &logger)
+        [&decoder, tracer, decoder_name]
+        (io::File &input_file_copy, const Logger &logger)
         {
+            const auto file_name = input_file_copy.path.str();
+            TraceSpan decode_span(tracer, "decode", decoder_name, file_name);
+            decode_span.set_bytes_in(input_file_copy.stream.size());
             auto output_file = decoder.decode(logger, input_file_copy);
+            decode_span.finish();
+
+            TraceSpan encode_span(tracer, "encode", decoder_name, file_name);
             const auto encoder = enc::microsoft::WavAudioEncoder();
-            return encoder.encode(logger, output_file, input_file_copy.path);
+            auto encoded_file = encoder.encode(
+                logger, output_file, input_file_copy.path);
+            if (encoded_file)
+                encode_span.set_bytes_out(encoded_file->stream.size());
+            return encoded_file;
         },
         decoder);
 }
@@ -16,10 +16,12 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "flow/parallel_unpacker.h"
+#include <algorithm>
 #include <chrono>
+#include <mutex>
 #include <set>
-#include <stack>
 #include "algo/format.h"
+#include "algo/parallel.h"
 #include "dec/idecoder.h"
 #include "err.h"
 #include "flow/parallel_decoder_adapter.h"
@@ -40,7 +42,7 @@ namespace
             const TaskSourceType source_type,
             const io::path &base_name,
             const std::shared_ptr<const BaseParallelUnpackingTask> parent_task,
-            const std::set<std::string> &decoders_to_check,
+            const DecoderNames decoders_to_check,
             const InputFileFactory file_factory);
 
         bool work() const override;
@@ -55,7 +57,7 @@ namespace
             const TaskSourceType source_type,
             const io::path &base_name,
             const std::shared_ptr<const BaseParallelUnpackingTask> parent_task,
-            const std::set<std::string> &decoders_to_check,
+            const DecoderNames decoders_to_check,
             const std::shared_ptr<io::File> input_file,
             const DecoderFileFactory file_factory,
             const std::shared_ptr<const dec::IDecoder> origin_decoder,
@@ -73,12 +75,37 @@ namespace
 static bool save(
     const BaseParallelUnpackingTask &task, std::shared_ptr<io::File> file)
 {
+    TraceSpan span(
+        task.task_context.unpacker_context.tracer,
+        "save",
+        task.decoder_name,
+        file->path.str());
+    span.set_bytes_in(file->stream.size());
     try
     {
-        const auto full_path
-            = task.task_context.unpacker_context.file_saver.save(file);
-        task.logger.success("saved to %s\n", full_path.c_str());
-        task.logger.flush();
+        // the saver may still be writing the file when this returns, so
+        // the outcome is logged by whichever thread gets to know it
+        const auto logger = task.logger;
+        auto &failed_write_count = task.task_context.failed_write_count;
+        task.task_context.unpacker_context.file_saver.save_async(
+            file,
+            [logger, &failed_write_count](
+                const io::path &path, const std::string &error)
+            {
+                if (error.empty())
+                {
+                    logger.success("saved to %s\n", path.c_str());
+                }
+                else
+                {
+                    logger.err(
+                        "error saving to %s (%s)\n",
+                        path.c_str(),
+                        error.c_str());
+                    ++failed_write_count;
+                }
+                logger.flush();
+            });
         return true;
     }
     catch (const err::IoError &e)
@@ -90,31 +117,21 @@ static bool save(
     }
 }
 
-static std::set<std::string> collect_linked_decoders(
-    const dec::IDecoder &base_decoder, const dec::Registry &registry)
+// Returns the union of both sets, reusing either of them when possible.
+static DecoderNames merge(const DecoderNames &a, const DecoderNames &b)
 {
-    std::set<std::string> known_formats;
-    std::vector<std::shared_ptr<dec::IDecoder>> linked_decoders;
-    std::stack<const dec::IDecoder*> decoders_to_inspect;
-    decoders_to_inspect.push(&base_decoder);
-    while (!decoders_to_inspect.empty())
-    {
-        const auto decoder_to_inspect = decoders_to_inspect.top();
-        decoders_to_inspect.pop();
-        for (const auto &format : decoder_to_inspect->get_linked_formats())
-        {
-            if (known_formats.find(format) != known_formats.end())
-                continue;
-            known_formats.insert(format);
-            auto linked_decoder = registry.create_decoder(format);
-            decoders_to_inspect.push(linked_decoder.get());
-            linked_decoders.push_back(std::move(linked_decoder));
-        }
-    }
-    return std::set<std::string>(known_formats.begin(), known_formats.end());
+    if (std::includes(a->begin(), a->end(), b->begin(), b->end()))
+        return a;
+    if (std::includes(b->begin(), b->end(), a->begin(), a->end()))
+        return b;
+    auto ret = std::make_shared<std::set<std::string>>(*a);
+    ret->insert(b->begin(), b->end());
+    return ret;
 }
 
-static std::shared_ptr<dec::IDecoder> guess_decoder(
+// Returns the name of the only decoder that recognizes the file, or an empty
+// string if there's no such decoder.
+static std::string guess_decoder(
     const BaseParallelUnpackingTask &task,
     const std::set<std::string> &decoders_to_check,
     io::File &file,
@@ -123,20 +140,20 @@ static std::shared_ptr<dec::IDecoder> guess_decoder(
     task.logger.info(
         "guessing decoder among %d decoders...\n", decoders_to_check.size());
 
-    std::map<std::string, std::shared_ptr<dec::IDecoder>> matching_decoders;
-    for (const auto &name : decoders_to_check)
-    {
-        const auto current_decoder
-            = task.task_context.unpacker_context.registry.create_decoder(name);
-        if (current_decoder->is_recognized(file))
-            matching_decoders[name] = std::move(current_decoder);
-    }
+    const auto &registry = task.task_context.unpacker_context.registry;
+    const auto candidates
+        = registry.get_recognition_candidates(file, decoders_to_check);
+
+    std::set<std::string> matching_decoders;
+    for (const auto &name : candidates)
+        if (registry.get_decoder(name)->is_recognized(file))
+            matching_decoders.insert(name);
 
     if (matching_decoders.size() == 1)
     {
-        task.logger.success(
-            "recognized as %s.\n", matching_decoders.begin()->first.c_str());
-        return matching_decoders.begin()->second;
+        const auto decoder_name = *matching_decoders.begin();
+        task.logger.success("recognized as %s.\n", decoder_name.c_str());
+        return decoder_name;
     }
 
     if (matching_decoders.empty())
@@ -149,7 +166,7 @@ static std::shared_ptr<dec::IDecoder> guess_decoder(
         {
             task.logger.err("not recognized by any decoder.\n");
         }
-        return nullptr;
+        return "";
     }
 
     if (source_type == TaskSourceType::NestedDecoding)
@@ -159,11 +176,11 @@ static std::shared_ptr<dec::IDecoder> guess_decoder(
     else
     {
         task.logger.warn("file was recognized by multiple decoders.\n");
-        for (const auto &it : matching_decoders)
-            task.logger.warn("- " + it.first + "\n");
+        for (const auto &name : matching_decoders)
+            task.logger.warn("- " + name + "\n");
         task.logger.warn("Please provide --dec and proceed manually.\n");
     }
-    return nullptr;
+    return "";
 }
 
 ParallelUnpackerContext::ParallelUnpackerContext(
@@ -172,13 +189,17 @@ ParallelUnpackerContext::ParallelUnpackerContext(
     const dec::Registry &registry,
     const bool enable_nested_decoding,
     const std::vector<std::string> &arguments,
-    const std::set<std::string> &decoders_to_check) :
+    const std::set<std::string> &decoders_to_check,
+    TaskTracer *tracer) :
         logger(logger),
         file_saver(file_saver),
         registry(registry),
         enable_nested_decoding(enable_nested_decoding),
         arguments(arguments),
-        decoders_to_check(decoders_to_check)
+        decoders_to_check(decoders_to_check),
+        tracer(tracer),
+        decoder_options(std::make_shared<DecoderOptionsCache>(arguments)),
+        decoder_pool(std::make_shared<DecoderPool>(registry, *decoder_options))
 {
 }
 
@@ -188,7 +209,8 @@ ParallelTaskContext::ParallelTaskContext(
     TaskScheduler &task_scheduler) :
         unpacker(unpacker),
         unpacker_context(unpacker_context),
-        task_scheduler(task_scheduler)
+        task_scheduler(task_scheduler),
+        failed_write_count(0)
 {
 }
 
@@ -197,13 +219,14 @@ BaseParallelUnpackingTask::BaseParallelUnpackingTask(
     const TaskSourceType source_type,
     const io::path &base_name,
     const std::shared_ptr<const BaseParallelUnpackingTask> parent_task,
-    const std::set<std::string> &decoders_to_check) :
+    const DecoderNames decoders_to_check) :
         logger(task_context.unpacker_context.logger),
         task_context(task_context),
         source_type(source_type),
         base_name(base_name),
         parent_task(parent_task),
-        decoders_to_check(decoders_to_check)
+        decoders_to_check(decoders_to_check),
+        decoder_name(parent_task ? parent_task->decoder_name : "")
 {
     mutex.lock();
     const auto task_id = task_count++;
@@ -237,7 +260,8 @@ void BaseParallelUnpackingTask::save_file(
             base_name,
             shared_from_this(),
             source_type == TaskSourceType::InitialUserInput
-                ? std::set<std::string>() : decoders_to_check,
+                ? std::make_shared<const std::set<std::string>>()
+                : decoders_to_check,
             input_file,
             file_factory,
             origin_decoder.shared_from_this(),
@@ -249,7 +273,7 @@ DecodeInputFileTask::DecodeInputFileTask(
     const TaskSourceType source_type,
     const io::path &base_name,
     const std::shared_ptr<const BaseParallelUnpackingTask> parent_task,
-    const std::set<std::string> &decoders_to_check,
+    const DecoderNames decoders_to_check,
     const InputFileFactory file_factory) :
         BaseParallelUnpackingTask(
             task_context,
@@ -283,23 +307,27 @@ bool DecodeInputFileTask::work() const
     {
         logger.info("initial recognition...\n");
 
-        const auto decoder = guess_decoder(
-            *this, decoders_to_check, *input_file, source_type);
-
-        if (!decoder)
+        TraceSpan span(
+            task_context.unpacker_context.tracer,
+            "recognize",
+            "",
+            base_name.str());
+        span.set_bytes_in(input_file->stream.size());
+        const auto recognized_name = guess_decoder(
+            *this, *decoders_to_check, *input_file, source_type);
+        span.set_decoder_name(recognized_name);
+        span.finish();
+
+        if (recognized_name.empty())
         {
             return source_type == TaskSourceType::NestedDecoding
                 ? save(*this, input_file)
                 : false;
         }
 
-        ArgParser decoder_arg_parser;
-        const auto decorators = decoder->get_arg_parser_decorators();
-        for (const auto &decorator : decorators)
-            decorator.register_cli_options(decoder_arg_parser);
-        decoder_arg_parser.parse(task_context.unpacker_context.arguments);
-        for (const auto &decorator : decorators)
-            decorator.parse_cli_options(decoder_arg_parser);
+        decoder_name = recognized_name;
+        const auto decoder
+            = task_context.unpacker_context.decoder_pool->get(decoder_name);
 
         ParallelDecoderAdapter adapter(shared_from_this(), input_file);
         decoder->accept(adapter);
@@ -319,7 +347,7 @@ ProcessOutputFileTask::ProcessOutputFileTask(
     const TaskSourceType source_type,
     const io::path &base_name,
     const std::shared_ptr<const BaseParallelUnpackingTask> parent_task,
-    const std::set<std::string> &decoders_to_check,
+    const DecoderNames decoders_to_check,
     const std::shared_ptr<io::File> input_file,
     const DecoderFileFactory file_factory,
     const std::shared_ptr<const dec::IDecoder> origin_decoder,
@@ -394,12 +422,12 @@ bool ProcessOutputFileTask::work() const
     if (!task_context.unpacker_context.enable_nested_decoding)
         return save(*this, output_file);
 
-    auto linked_decoders = collect_linked_decoders(
-        *origin_decoder, task_context.unpacker_context.registry);
-    linked_decoders.insert(
-        decoders_to_check.begin(), decoders_to_check.end());
+    const auto linked_decoders = merge(
+        task_context.unpacker_context.registry.get_linked_decoders(
+            decoder_name),
+        decoders_to_check);
 
-    if (linked_decoders.empty())
+    if (linked_decoders->empty())
         return save(*this, output_file);
 
     if (get_depth() >= max_depth)
@@ -458,20 +486,35 @@ void ParallelUnpacker::add_input_file(
             TaskSourceType::InitialUserInput,
             base_name,
             nullptr,
-            p->unpacker_context.decoders_to_check,
+            std::make_shared<const std::set<std::string>>(
+                p->unpacker_context.decoders_to_check),
             file_factory));
 }
 
 bool ParallelUnpacker::run(const size_t thread_count)
 {
+    Logger logger(p->unpacker_context.logger);
+
+    // keeps the decoders' own helper threads within --threads as well
+    algo::set_thread_limit(thread_count);
+
     const auto begin = std::chrono::steady_clock::now();
-    const auto results = p->task_scheduler.run(thread_count);
+    p->task_context.failed_write_count = 0;
+    auto results = p->task_scheduler.run(thread_count);
+    try
+    {
+        p->unpacker_context.file_saver.flush();
+    }
+    catch (const err::IoError &e)
+    {
+        logger.err("error saving (%s)\n", e.what());
+        ++results.error_count;
+    }
+    results.error_count += p->task_context.failed_write_count;
     const auto end = std::chrono::steady_clock::now();
     const auto diff
         = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin);
 
-    Logger logger(p->unpacker_context.logger);
-
     logger.log(
         Logger::MessageType::Summary,
         "Executed %d tasks in %.02fs (",
@@ -17,13 +17,17 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
 #include "dec/base_decoder.h"
 #include "dec/registry.h"
+#include "flow/decoder_options_cache.h"
+#include "flow/decoder_pool.h"
 #include "flow/ifile_saver.h"
 #include "flow/task_scheduler.h"
+#include "flow/task_tracer.h"
 #include "logger.h"
 
 namespace au {
@@ -38,6 +42,7 @@ namespace flow {
     class ParallelUnpacker;
 
     using InputFileFactory = std::function<std::shared_ptr<io::File>()>;
+    using DecoderNames = std::shared_ptr<const std::set<std::string>>;
     using DecoderFileFactory
         = std::function<std::shared_ptr<io::File>(io::File &, const Logger &)>;
 
@@ -49,7 +54,8 @@ namespace flow {
             const dec::Registry &registry,
             const bool enable_nested_decoding,
             const std::vector<std::string> &arguments,
-            const std::set<std::string> &decoders_to_check);
+            const std::set<std::string> &decoders_to_check,
+            TaskTracer *tracer = nullptr);
 
         const Logger &logger;
         const IFileSaver &file_saver;
@@ -57,6 +63,11 @@ namespace flow {
         const bool enable_nested_decoding;
         const std::vector<std::string> arguments;
         const std::set<std::string> decoders_to_check;
+        TaskTracer *tracer;
+
+        // parsed from arguments once per decoder type
+        const std::shared_ptr<const DecoderOptionsCache> decoder_options;
+        const std::shared_ptr<const DecoderPool> decoder_pool;
     };
 
     struct ParallelTaskContext final
@@ -69,6 +80,9 @@ namespace flow {
         ParallelUnpacker &unpacker;
         const ParallelUnpackerContext &unpacker_context;
         TaskScheduler &task_scheduler;
+
+        // writes that failed after the saving task had already finished
+        std::atomic<int> failed_write_count;
     };
 
     struct BaseParallelUnpackingTask :
@@ -80,7 +94,7 @@ namespace flow {
             const TaskSourceType source_type,
             const io::path &base_name,
             const std::shared_ptr<const BaseParallelUnpackingTask> parent_task,
-            const std::set<std::string> &decoders_to_check);
+            const DecoderNames decoders_to_check);
 
         virtual ~BaseParallelUnpackingTask() {}
 
@@ -97,7 +111,14 @@ namespace flow {
         const TaskSourceType source_type;
         const io::path base_name;
         const std::shared_ptr<const BaseParallelUnpackingTask> parent_task;
-        const std::set<std::string> decoders_to_check;
+
+        // shared between tasks rather than copied, as nested decoding
+        // spawns a task for every output file
+        const DecoderNames decoders_to_check;
+
+        // name of the decoder that produced the files of this task, set
+        // once the input file is recognized
+        mutable std::string decoder_name;
     };
 
     class ParallelUnpacker final
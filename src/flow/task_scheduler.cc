@@ -16,21 +16,176 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "flow/task_scheduler.h"
-#include <chrono>
+#include <atomic>
+#include <condition_variable>
 #include <deque>
+#include <mutex>
 #include <thread>
 #include <vector>
+#include "algo/parallel.h"
 #include "algo/range.h"
 
 using namespace au;
 using namespace au::flow;
 
+namespace
+{
+    struct TaskQueue final
+    {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<ITask>> tasks;
+    };
+
+    // identifies the scheduler and the deque owned by the current thread
+    thread_local const void *current_scheduler = nullptr;
+    thread_local size_t current_worker = 0;
+}
+
 struct TaskScheduler::Priv final
 {
-    std::deque<std::shared_ptr<ITask>> tasks;
-    std::vector<std::unique_ptr<std::thread>> threads;
+    Priv();
+
+    void push(std::shared_ptr<ITask> task, const bool front);
+    std::shared_ptr<ITask> pop(const size_t worker);
+    void finish_task();
+    void park();
+    void work(const size_t worker);
+
+    TaskQueue shared_queue;
+    std::vector<std::unique_ptr<TaskQueue>> worker_queues;
+
+    // tasks that were pushed, but are yet to be picked up by a worker
+    std::atomic<size_t> queued_count;
+    // tasks that were pushed, but are yet to finish
+    std::atomic<size_t> pending_count;
+    std::atomic<size_t> parked_count;
+    std::atomic<int> success_count;
+    std::atomic<int> error_count;
+
+    std::mutex park_mutex;
+    std::condition_variable park_cv;
 };
 
+TaskScheduler::Priv::Priv() :
+    queued_count(0),
+    pending_count(0),
+    parked_count(0),
+    success_count(0),
+    error_count(0)
+{
+}
+
+void TaskScheduler::Priv::push(std::shared_ptr<ITask> task, const bool front)
+{
+    auto &queue = front && current_scheduler == this
+        ? *worker_queues.at(current_worker)
+        : shared_queue;
+
+    ++pending_count;
+    {
+        std::unique_lock<std::mutex> lock(queue.mutex);
+        if (front)
+            queue.tasks.push_front(task);
+        else
+            queue.tasks.push_back(task);
+    }
+    ++queued_count;
+
+    // The increment above and the one in park() are both sequentially
+    // consistent, so either the parked worker sees the new task, or we see
+    // the parked worker.
+    if (parked_count)
+    {
+        std::unique_lock<std::mutex> lock(park_mutex);
+        park_cv.notify_one();
+    }
+}
+
+std::shared_ptr<ITask> TaskScheduler::Priv::pop(const size_t worker)
+{
+    std::shared_ptr<ITask> task;
+
+    const auto try_take = [&](TaskQueue &queue, const bool front)
+    {
+        std::unique_lock<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            return false;
+        if (front)
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        else
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        --queued_count;
+        return true;
+    };
+
+    if (try_take(*worker_queues[worker], true))
+        return task;
+    if (try_take(shared_queue, true))
+        return task;
+
+    // steal the oldest work from other workers, starting with the neighbor
+    for (const auto i : algo::range(1, worker_queues.size()))
+    {
+        const auto victim = (worker + i) % worker_queues.size();
+        if (try_take(*worker_queues[victim], false))
+            return task;
+    }
+
+    return nullptr;
+}
+
+void TaskScheduler::Priv::finish_task()
+{
+    if (--pending_count == 0)
+    {
+        std::unique_lock<std::mutex> lock(park_mutex);
+        park_cv.notify_all();
+    }
+}
+
+void TaskScheduler::Priv::park()
+{
+    std::unique_lock<std::mutex> lock(park_mutex);
+    ++parked_count;
+    park_cv.wait(lock, [&]()
+    {
+        return queued_count > 0 || pending_count == 0;
+    });
+    --parked_count;
+}
+
+void TaskScheduler::Priv::work(const size_t worker)
+{
+    current_scheduler = this;
+    current_worker = worker;
+
+    while (pending_count)
+    {
+        const auto task = pop(worker);
+        if (!task)
+        {
+            park();
+            continue;
+        }
+
+        const algo::BusyThreadScope busy_scope;
+        const auto local_success = task->work();
+        if (local_success)
+            ++success_count;
+        else
+            ++error_count;
+        finish_task();
+    }
+
+    current_scheduler = nullptr;
+}
+
 TaskScheduler::TaskScheduler() : p(new Priv())
 {
 }
@@ -41,14 +196,12 @@ TaskScheduler::~TaskScheduler()
 
 void TaskScheduler::push_front(std::shared_ptr<ITask> task)
 {
-    std::unique_lock<std::mutex> lock(mutex);
-    p->tasks.push_front(task);
+    p->push(task, true);
 }
 
 void TaskScheduler::push_back(std::shared_ptr<ITask> task)
 {
-    std::unique_lock<std::mutex> lock(mutex);
-    p->tasks.push_back(task);
+    p->push(task, false);
 }
 
 TaskSchedulerResult TaskScheduler::run(size_t number_of_threads)
@@ -58,50 +211,20 @@ TaskSchedulerResult TaskScheduler::run(size_t number_of_threads)
     if (!number_of_threads)
         number_of_threads = 1;
 
-    TaskSchedulerResult result;
-    result.success_count = 0;
-    result.error_count = 0;
-    bool still_running = true;
-
+    p->worker_queues.clear();
     for (const auto i : algo::range(number_of_threads))
-    {
-        p->threads.push_back(std::make_unique<std::thread>([&]()
-        {
-            while (true)
-            {
-                std::shared_ptr<ITask> task;
-
-                {
-                    std::unique_lock<std::mutex> lock(mutex);
-                    if (p->tasks.empty())
-                    {
-                        if (still_running && number_of_threads > 1)
-                        {
-                            lock.unlock();
-                            std::this_thread::sleep_for(
-                                std::chrono::milliseconds(10));
-                            continue;
-                        }
-                        break;
-                    }
-                    task = p->tasks.front();
-                    p->tasks.pop_front();
-                }
-
-                const auto local_success = task->work();
-
-                {
-                    std::unique_lock<std::mutex> lock(mutex);
-                    result.success_count += local_success;
-                    result.error_count += !local_success;
-                    still_running = !p->tasks.empty();
-                }
-            }
-        }));
-    }
+        p->worker_queues.push_back(std::make_unique<TaskQueue>());
+    p->success_count = 0;
+    p->error_count = 0;
 
-    for (auto &t : p->threads)
-        t->join();
+    std::vector<std::thread> threads;
+    for (const auto i : algo::range(number_of_threads))
+        threads.emplace_back([&, i]() { p->work(i); });
+    for (auto &t : threads)
+        t.join();
 
+    TaskSchedulerResult result;
+    result.success_count = p->success_count;
+    result.error_count = p->error_count;
     return result;
 }
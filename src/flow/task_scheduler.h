@@ -18,7 +18,6 @@
 #pragma once
 
 #include <memory>
-#include <mutex>
 
 namespace au {
 namespace flow {
@@ -36,6 +35,14 @@ namespace flow {
         int error_count;
     };
 
+    // Work-stealing scheduler. Every worker owns a deque; tasks pushed with
+    // push_front() from within a running task land at the front of the
+    // current worker's deque and are executed next (depth-first), while
+    // push_back() appends to a shared FIFO that is consulted once the local
+    // deque runs dry. Idle workers steal from the back of other deques and
+    // park on a condition variable once there is nothing left to steal.
+    // run() returns when every pushed task, including the ones spawned by
+    // other tasks, has finished.
     class TaskScheduler final
     {
     public:
@@ -44,8 +51,6 @@ namespace flow {
         TaskSchedulerResult run(const size_t number_of_threads = 0);
         void push_front(std::shared_ptr<ITask> task);
         void push_back(std::shared_ptr<ITask> task);
-        void join();
-        std::mutex mutex;
     private:
         struct Priv;
         std::unique_ptr<Priv> p;
@@ -0,0 +1,237 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/task_tracer.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include "algo/format.h"
+
+using namespace au;
+using namespace au::flow;
+
+namespace
+{
+    struct ThreadBuffer final
+    {
+        size_t thread_id;
+        std::vector<TraceEvent> events;
+    };
+
+    struct Summary final
+    {
+        size_t count;
+        double seconds;
+        uoff_t bytes_in;
+        uoff_t bytes_out;
+    };
+
+    // identifies the tracer and the buffer owned by the current thread
+    thread_local u64 current_tracer_id = 0;
+    thread_local ThreadBuffer *current_buffer = nullptr;
+}
+
+static std::atomic<u64> last_tracer_id(0);
+
+struct TaskTracer::Priv final
+{
+    Priv();
+
+    const u64 id;
+    const std::chrono::steady_clock::time_point begin;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+TaskTracer::Priv::Priv()
+    : id(++last_tracer_id), begin(std::chrono::steady_clock::now())
+{
+}
+
+static std::string escape_json(const std::string &input)
+{
+    std::string output;
+    for (const auto c : input)
+    {
+        if (c == '"' || c == '\\')
+            output += std::string("\\") + c;
+        else if (static_cast<u8>(c) < 0x20)
+            output += algo::format("\\u%04x", c);
+        else
+            output += c;
+    }
+    return output;
+}
+
+static long long get_microseconds(
+    const std::chrono::steady_clock::time_point begin,
+    const std::chrono::steady_clock::time_point end)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        end - begin).count();
+}
+
+TaskTracer::TaskTracer() : p(new Priv())
+{
+}
+
+TaskTracer::~TaskTracer()
+{
+}
+
+void TaskTracer::record(TraceEvent &event)
+{
+    if (current_tracer_id != p->id)
+    {
+        std::unique_lock<std::mutex> lock(p->mutex);
+        p->buffers.push_back(std::make_unique<ThreadBuffer>());
+        p->buffers.back()->thread_id = p->buffers.size();
+        current_buffer = p->buffers.back().get();
+        current_tracer_id = p->id;
+    }
+    event.thread_id = current_buffer->thread_id;
+    current_buffer->events.push_back(std::move(event));
+}
+
+std::vector<TraceEvent> TaskTracer::get_events() const
+{
+    std::vector<TraceEvent> events;
+    for (const auto &buffer : p->buffers)
+    {
+        events.insert(
+            events.end(), buffer->events.begin(), buffer->events.end());
+    }
+    std::sort(
+        events.begin(),
+        events.end(),
+        [](const TraceEvent &a, const TraceEvent &b)
+        {
+            return a.begin < b.begin;
+        });
+    return events;
+}
+
+void TaskTracer::write_chrome_trace(io::BaseByteStream &output_stream) const
+{
+    output_stream.write("{\"traceEvents\":[\n");
+    for (const auto &buffer : p->buffers)
+    {
+        output_stream.write(algo::format(
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":\"worker %d\"}},\n",
+            static_cast<int>(buffer->thread_id),
+            static_cast<int>(buffer->thread_id)));
+    }
+
+    const auto events = get_events();
+    for (const auto &event : events)
+    {
+        output_stream.write(algo::format(
+            "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+            "\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"decoder\":\"%s\",\"file\":\"%s\","
+            "\"bytes_in\":%llu,\"bytes_out\":%llu}}%s\n",
+            escape_json(event.name).c_str(),
+            escape_json(event.decoder_name).c_str(),
+            get_microseconds(p->begin, event.begin),
+            get_microseconds(event.begin, event.end),
+            static_cast<int>(event.thread_id),
+            escape_json(event.decoder_name).c_str(),
+            escape_json(event.file_name).c_str(),
+            static_cast<unsigned long long>(event.bytes_in),
+            static_cast<unsigned long long>(event.bytes_out),
+            &event == &events.back() ? "" : ","));
+    }
+    output_stream.write("]}\n");
+}
+
+void TaskTracer::print_summary(const Logger &logger) const
+{
+    std::map<std::pair<std::string, std::string>, Summary> summaries;
+    for (const auto &buffer : p->buffers)
+    for (const auto &event : buffer->events)
+    {
+        auto &summary = summaries[{event.decoder_name, event.name}];
+        ++summary.count;
+        summary.seconds
+            += get_microseconds(event.begin, event.end) / 1000000.0;
+        summary.bytes_in += event.bytes_in;
+        summary.bytes_out += event.bytes_out;
+    }
+
+    logger.info(
+        "%-24s %-10s %8s %10s %12s %12s\n",
+        "decoder", "phase", "count", "time", "bytes in", "bytes out");
+    for (const auto &it : summaries)
+    {
+        logger.info(
+            "%-24s %-10s %8d %9.03fs %12llu %12llu\n",
+            it.first.first.empty() ? "-" : it.first.first.c_str(),
+            it.first.second.c_str(),
+            static_cast<int>(it.second.count),
+            it.second.seconds,
+            static_cast<unsigned long long>(it.second.bytes_in),
+            static_cast<unsigned long long>(it.second.bytes_out));
+    }
+}
+
+TraceSpan::TraceSpan(
+    TaskTracer *tracer,
+    const std::string &name,
+    const std::string &decoder_name,
+    const std::string &file_name) : tracer(tracer)
+{
+    if (!tracer)
+        return;
+    event.name = name;
+    event.decoder_name = decoder_name;
+    event.file_name = file_name;
+    event.bytes_in = 0;
+    event.bytes_out = 0;
+    event.begin = std::chrono::steady_clock::now();
+}
+
+TraceSpan::~TraceSpan()
+{
+    finish();
+}
+
+void TraceSpan::set_decoder_name(const std::string &decoder_name)
+{
+    if (tracer)
+        event.decoder_name = decoder_name;
+}
+
+void TraceSpan::set_bytes_in(const uoff_t bytes_in)
+{
+    event.bytes_in = bytes_in;
+}
+
+void TraceSpan::set_bytes_out(const uoff_t bytes_out)
+{
+    event.bytes_out = bytes_out;
+}
+
+void TraceSpan::finish()
+{
+    if (!tracer)
+        return;
+    event.end = std::chrono::steady_clock::now();
+    tracer->record(event);
+    tracer = nullptr;
+}
@@ -0,0 +1,86 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "io/base_byte_stream.h"
+#include "logger.h"
+#include "types.h"
+
+namespace au {
+namespace flow {
+
+    struct TraceEvent final
+    {
+        std::string name;
+        std::string decoder_name;
+        std::string file_name;
+        std::chrono::steady_clock::time_point begin;
+        std::chrono::steady_clock::time_point end;
+        uoff_t bytes_in;
+        uoff_t bytes_out;
+        size_t thread_id;
+    };
+
+    // Collects timings of the unpacking phases. Every thread appends to its
+    // own buffer, so recording takes a lock only for the first event of
+    // each thread.
+    class TaskTracer final
+    {
+    public:
+        TaskTracer();
+        ~TaskTracer();
+
+        void record(TraceEvent &event);
+
+        // These must not run concurrently with record().
+        std::vector<TraceEvent> get_events() const;
+        void write_chrome_trace(io::BaseByteStream &output_stream) const;
+        void print_summary(const Logger &logger) const;
+
+    private:
+        struct Priv;
+        std::unique_ptr<Priv> p;
+    };
+
+    // Records the time between its construction and finish() or its
+    // destruction, whichever comes first. Does nothing without a tracer.
+    class TraceSpan final
+    {
+    public:
+        TraceSpan(
+            TaskTracer *tracer,
+            const std::string &name,
+            const std::string &decoder_name,
+            const std::string &file_name);
+        ~TraceSpan();
+
+        void set_decoder_name(const std::string &decoder_name);
+        void set_bytes_in(const uoff_t bytes_in);
+        void set_bytes_out(const uoff_t bytes_out);
+        void finish();
+
+    private:
+        TaskTracer *tracer;
+        TraceEvent event;
+    };
+
+} }
@@ -42,6 +42,9 @@ namespace io {
         virtual void write(const size_t bits, const u32 value);
 
     protected:
+        // for subclasses that don't read through input_stream
+        BaseBitStream();
+
         u64 buffer;
         size_t bits_available;
         size_t position;
@@ -73,12 +73,16 @@ BaseByteStream &BaseByteStream::write(io::BaseByteStream &other_stream)
 BaseByteStream &BaseByteStream::write(
     io::BaseByteStream &other_stream, const size_t size)
 {
-    const auto buffer_size = 16 * 1024;
+    // copy through a bounded buffer, so that large lazily read streams
+    // (such as slices of big archives) never get fully materialized
+    const auto buffer_size = 64 * 1024;
+    bstr buffer(std::min<size_t>(buffer_size, size));
     size_t left = size;
-    for (const auto i : algo::range(0, size, buffer_size))
+    while (left)
     {
         const auto bytes_to_transcribe = std::min<size_t>(buffer_size, left);
-        write(other_stream.read(bytes_to_transcribe));
+        other_stream.read(buffer.get<u8>(), bytes_to_transcribe);
+        write_impl(buffer.get<u8>(), bytes_to_transcribe);
         left -= bytes_to_transcribe;
     }
     return *this;
@@ -64,6 +64,13 @@ namespace io {
             return ret;
         }
 
+        BaseByteStream &read(void *destination, const size_t bytes)
+        {
+            if (bytes)
+                read_impl(destination, bytes);
+            return *this;
+        }
+
         template<typename T> T read()
         {
             static_assert(
@@ -102,6 +109,13 @@ namespace io {
             return *this;
         }
 
+        io::BaseByteStream &write(const void *source, const size_t bytes)
+        {
+            if (bytes)
+                write_impl(source, bytes);
+            return *this;
+        }
+
         io::BaseByteStream &write(const std::string &bytes)
         {
             return write(bstr(bytes));
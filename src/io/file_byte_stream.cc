@@ -17,116 +17,268 @@
 
 #include "io/file_byte_stream.h"
 #include <cstdio>
+#include <cstring>
 #include "algo/locale.h"
 #include "err.h"
 
 #if _WIN32
     #include <fcntl.h>
     #include <io.h>
+    #include <mutex>
     #include <sys/stat.h>
     #include <sys/types.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
 #endif
 
 using namespace au;
 using namespace au::io;
 
-struct FileByteStream::Priv final
+namespace
 {
-    #if _WIN32
-        Priv(const path &path, FileMode mode) : path(path), mode(mode)
-        {
-            fd = _wopen(
-                path.wstr().c_str(),
-                (mode == FileMode::Write
-                    ? (_O_RDWR | _O_CREAT | _O_TRUNC)
-                    : _O_RDONLY)
-                | _O_BINARY,
-                _S_IREAD | _S_IWRITE);
-            if (fd == -1)
-                throw err::FileNotFoundError("Could not open " + path.str());
-        }
+    // Read-only file shared by all clones of a stream. Reads are
+    // position-independent, so that clones don't need to reopen the file
+    // and only carry their own cursor.
+    class SharedInputFile final
+    {
+    public:
+        SharedInputFile(const path &path);
+        ~SharedInputFile();
 
-        ~Priv()
-        {
-            _close(fd);
-        }
+        void read(
+            void *destination, const uoff_t offset, const size_t size) const;
 
-        uoff_t tell()
-        {
-            return _telli64(fd);
-        }
+        uoff_t size;
 
-        void seek(const uoff_t offset, const int whence)
-        {
-            _lseeki64(fd, offset, whence);
-        }
+    private:
+        int fd;
+        #if _WIN32
+            mutable std::mutex mutex;
+        #else
+            const u8 *data;
+        #endif
+    };
 
-        void read(void *source, const size_t size)
-        {
-            const size_t ret = _read(fd, source, size);
-            if (ret != size)
-                throw err::EofError();
-        }
+    class FileHandle final
+    {
+    public:
+        FileHandle(const path &path, const FileMode mode);
+        ~FileHandle();
 
-        void write(const void *destination, const size_t size)
-        {
-            const size_t ret = _write(fd, destination, size);
-            if (ret != size)
-                throw err::IoError("Could not write full data");
-        }
+        uoff_t tell();
+        void seek(const uoff_t offset, const int whence);
+        void read(void *destination, const size_t size);
+        void write(const void *source, const size_t size);
 
-        int fd;
-    #else
-        Priv(const path &path, FileMode mode) : path(path), mode(mode)
-        {
-            fd = std::fopen(
-                path.c_str(),
-                mode == FileMode::Write ? "w+b" : "rb");
-            if (!fd)
-                throw err::FileNotFoundError("Could not open " + path.str());
-        }
+    private:
+        #if _WIN32
+            int fd;
+        #else
+            FILE *fd;
+        #endif
+    };
+}
+
+#if _WIN32
+    SharedInputFile::SharedInputFile(const path &path)
+    {
+        fd = _wopen(path.wstr().c_str(), _O_RDONLY | _O_BINARY);
+        if (fd == -1)
+            throw err::FileNotFoundError("Could not open " + path.str());
+        size = _lseeki64(fd, 0, SEEK_END);
+    }
+
+    SharedInputFile::~SharedInputFile()
+    {
+        _close(fd);
+    }
+
+    void SharedInputFile::read(
+        void *destination, const uoff_t offset, const size_t size) const
+    {
+        if (offset + size > this->size)
+            throw err::EofError();
+        std::unique_lock<std::mutex> lock(mutex);
+        _lseeki64(fd, offset, SEEK_SET);
+        const size_t ret = _read(fd, destination, size);
+        if (ret != size)
+            throw err::EofError();
+    }
+
+    FileHandle::FileHandle(const path &path, const FileMode mode)
+    {
+        fd = _wopen(
+            path.wstr().c_str(),
+            (mode == FileMode::Write
+                ? (_O_RDWR | _O_CREAT | _O_TRUNC)
+                : _O_RDONLY)
+            | _O_BINARY,
+            _S_IREAD | _S_IWRITE);
+        if (fd == -1)
+            throw err::FileNotFoundError("Could not open " + path.str());
+    }
+
+    FileHandle::~FileHandle()
+    {
+        _close(fd);
+    }
 
-        ~Priv()
+    uoff_t FileHandle::tell()
+    {
+        return _telli64(fd);
+    }
+
+    void FileHandle::seek(const uoff_t offset, const int whence)
+    {
+        _lseeki64(fd, offset, whence);
+    }
+
+    void FileHandle::read(void *destination, const size_t size)
+    {
+        const size_t ret = _read(fd, destination, size);
+        if (ret != size)
+            throw err::EofError();
+    }
+
+    void FileHandle::write(const void *source, const size_t size)
+    {
+        const size_t ret = _write(fd, source, size);
+        if (ret != size)
+            throw err::IoError("Could not write full data");
+    }
+#else
+    SharedInputFile::SharedInputFile(const path &path) : data(nullptr)
+    {
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+            throw err::FileNotFoundError("Could not open " + path.str());
+
+        struct stat st;
+        if (fstat(fd, &st) != 0)
         {
-            fclose(fd);
+            close(fd);
+            throw err::FileNotFoundError("Could not open " + path.str());
         }
+        size = st.st_size;
 
-        uoff_t tell()
+        // fall back to pread() for anything that can't be mapped
+        if (S_ISREG(st.st_mode) && size > 0)
         {
-            return ftello(fd);
+            const auto mapping = mmap(
+                nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED)
+                data = static_cast<const u8*>(mapping);
         }
+    }
 
-        void seek(const uoff_t offset, const int whence)
+    SharedInputFile::~SharedInputFile()
+    {
+        if (data)
+            munmap(const_cast<u8*>(data), size);
+        close(fd);
+    }
+
+    void SharedInputFile::read(
+        void *destination, const uoff_t offset, const size_t size) const
+    {
+        if (offset + size > this->size)
+            throw err::EofError();
+
+        if (data)
         {
-            const auto ret = fseeko(fd, offset, whence);
-            if (ret != 0)
-                throw err::EofError();
+            std::memcpy(destination, data + offset, size);
+            return;
         }
 
-        void read(void *source, const size_t size)
+        auto target = static_cast<u8*>(destination);
+        size_t done = 0;
+        while (done < size)
         {
-            if (fread(source, 1, size, fd) != size)
+            const auto ret = pread(
+                fd, target + done, size - done, offset + done);
+            if (ret <= 0)
                 throw err::EofError();
+            done += ret;
         }
+    }
 
-        void write(const void *destination, const size_t size)
-        {
-            if (fwrite(destination, 1, size, fd) != size)
-                throw err::IoError("Could not write full data");
-        }
+    FileHandle::FileHandle(const path &path, const FileMode mode)
+    {
+        fd = std::fopen(path.c_str(), mode == FileMode::Write ? "w+b" : "rb");
+        if (!fd)
+            throw err::FileNotFoundError("Could not open " + path.str());
+    }
+
+    FileHandle::~FileHandle()
+    {
+        fclose(fd);
+    }
+
+    uoff_t FileHandle::tell()
+    {
+        return ftello(fd);
+    }
 
-        FILE *fd;
-    #endif
+    void FileHandle::seek(const uoff_t offset, const int whence)
+    {
+        const auto ret = fseeko(fd, offset, whence);
+        if (ret != 0)
+            throw err::EofError();
+    }
+
+    void FileHandle::read(void *destination, const size_t size)
+    {
+        if (fread(destination, 1, size, fd) != size)
+            throw err::EofError();
+    }
+
+    void FileHandle::write(const void *source, const size_t size)
+    {
+        if (fwrite(source, 1, size, fd) != size)
+            throw err::IoError("Could not write full data");
+    }
+#endif
+
+// Files opened for reading go through a SharedInputFile, files opened for
+// writing go through a regular FileHandle.
+struct FileByteStream::Priv final
+{
+    Priv(const path &path, const FileMode mode);
+    Priv(const std::shared_ptr<const SharedInputFile> input);
+
+    std::shared_ptr<const SharedInputFile> input;
+    uoff_t input_pos;
 
     io::path path;
-    FileMode mode;
+    std::unique_ptr<FileHandle> output;
 };
 
+FileByteStream::Priv::Priv(const io::path &path, const FileMode mode)
+    : input_pos(0), path(path)
+{
+    if (mode == FileMode::Read)
+        input = std::make_shared<const SharedInputFile>(path);
+    else
+        output = std::make_unique<FileHandle>(path, mode);
+}
+
+FileByteStream::Priv::Priv(const std::shared_ptr<const SharedInputFile> input)
+    : input(input), input_pos(0)
+{
+}
+
 FileByteStream::FileByteStream(const path &path, const FileMode mode)
     : p(new Priv(path, mode))
 {
 }
 
+FileByteStream::FileByteStream(std::unique_ptr<Priv> p) : p(std::move(p))
+{
+}
+
 FileByteStream::~FileByteStream()
 {
 }
@@ -135,32 +287,47 @@ void FileByteStream::seek_impl(const uoff_t offset)
 {
     if (offset > size())
         throw err::EofError();
-    p->seek(offset, SEEK_SET);
+    if (p->input)
+        p->input_pos = offset;
+    else
+        p->output->seek(offset, SEEK_SET);
 }
 
 void FileByteStream::read_impl(void *destination, const size_t size)
 {
     // destination MUST exist and size MUST be at least 1
-    p->read(destination, size);
+    if (p->input)
+    {
+        p->input->read(destination, p->input_pos, size);
+        p->input_pos += size;
+    }
+    else
+        p->output->read(destination, size);
 }
 
 void FileByteStream::write_impl(const void *source, const size_t size)
 {
     // source MUST exist and size MUST be at least 1
-    p->write(source, size);
+    if (p->input)
+        throw err::IoError("Could not write full data");
+    p->output->write(source, size);
 }
 
 uoff_t FileByteStream::pos() const
 {
-    return p->tell();
+    if (p->input)
+        return p->input_pos;
+    return p->output->tell();
 }
 
 uoff_t FileByteStream::size() const
 {
-    const auto old_pos = p->tell();
-    p->seek(0, SEEK_END);
-    const auto size = p->tell();
-    p->seek(old_pos, SEEK_SET);
+    if (p->input)
+        return p->input->size;
+    const auto old_pos = p->output->tell();
+    p->output->seek(0, SEEK_END);
+    const auto size = p->output->tell();
+    p->output->seek(old_pos, SEEK_SET);
     return size;
 }
 
@@ -173,7 +340,15 @@ void FileByteStream::resize_impl(const uoff_t new_size)
 
 std::unique_ptr<io::BaseByteStream> FileByteStream::clone() const
 {
-    auto ret = std::make_unique<FileByteStream>(p->path, p->mode);
+    if (p->input)
+    {
+        // shares the file with this stream rather than reopening it
+        std::unique_ptr<FileByteStream> ret(
+            new FileByteStream(std::make_unique<Priv>(p->input)));
+        ret->seek(pos());
+        return std::move(ret);
+    }
+    auto ret = std::make_unique<FileByteStream>(p->path, FileMode::Write);
     ret->seek(pos());
     return std::move(ret);
 }
@@ -50,6 +50,7 @@ namespace io {
 
     private:
         struct Priv;
+        FileByteStream(std::unique_ptr<Priv> p);
         std::unique_ptr<Priv> p;
     };
 
@@ -0,0 +1,101 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstring>
+#include "algo/endian.h"
+#include "err.h"
+#include "types.h"
+
+namespace au {
+namespace io {
+
+    // Reads bits starting from the least significant bit of each byte.
+    //
+    // The counterpart of MsbBitReader; the same rules about the buffer
+    // lifetime and about reading past the end apply.
+    class LsbBitReader final
+    {
+    public:
+        LsbBitReader(const u8 *data, const size_t size);
+        explicit LsbBitReader(const bstr &input);
+        LsbBitReader(const bstr &&input) = delete;
+
+        uoff_t pos() const;
+        uoff_t size() const;
+        uoff_t left() const;
+        void seek(const uoff_t new_pos);
+
+        inline u32 peek(const size_t bits);
+        inline void consume(const size_t bits);
+        inline u32 read(const size_t bits);
+
+    private:
+        inline void refill();
+        void refill_slow();
+
+        const u8 *const begin;
+        const u8 *const end;
+        const u8 *cursor;
+
+        // upcoming bits, aligned to the least significant bit
+        u64 buffer;
+        size_t bits_available;
+    };
+
+    inline void LsbBitReader::refill()
+    {
+        if (end - cursor >= 8)
+        {
+            u64 word;
+            std::memcpy(&word, cursor, 8);
+            buffer |= algo::from_little_endian(word) << bits_available;
+            cursor += (63 - bits_available) >> 3;
+            bits_available |= 56;
+        }
+        else
+            refill_slow();
+    }
+
+    inline u32 LsbBitReader::peek(const size_t bits)
+    {
+        if (bits_available < bits)
+            refill();
+        return static_cast<u32>(buffer & ((1ull << bits) - 1));
+    }
+
+    inline void LsbBitReader::consume(const size_t bits)
+    {
+        if (bits_available < bits)
+        {
+            refill();
+            if (bits_available < bits)
+                throw err::EofError();
+        }
+        buffer >>= bits;
+        bits_available -= bits;
+    }
+
+    inline u32 LsbBitReader::read(const size_t bits)
+    {
+        const auto value = peek(bits);
+        consume(bits);
+        return value;
+    }
+
+} }
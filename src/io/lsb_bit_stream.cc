@@ -20,7 +20,9 @@
 using namespace au;
 using namespace au::io;
 
-LsbBitStream::LsbBitStream(const bstr &input) : BaseBitStream(input)
+LsbBitStream::LsbBitStream(const bstr &input) :
+    input(input),
+    reader(new LsbBitReader(this->input))
 {
 }
 
@@ -29,12 +31,32 @@ LsbBitStream::LsbBitStream(io::BaseByteStream &input_stream)
 {
 }
 
+uoff_t LsbBitStream::pos() const
+{
+    return reader ? reader->pos() : BaseBitStream::pos();
+}
+
+uoff_t LsbBitStream::size() const
+{
+    return reader ? reader->size() : BaseBitStream::size();
+}
+
+BaseStream &LsbBitStream::seek(const uoff_t offset)
+{
+    if (!reader)
+        return BaseBitStream::seek(offset);
+    reader->seek(offset);
+    return *this;
+}
+
 u32 LsbBitStream::read(const size_t bits)
 {
+    if (reader)
+        return reader->read(bits);
     while (bits_available < bits)
     {
         const auto tmp = input_stream->read<u8>();
-        buffer |= tmp << bits_available;
+        buffer |= static_cast<u64>(tmp) << bits_available;
         bits_available += 8;
     }
     const auto mask = (1ull << bits) - 1;
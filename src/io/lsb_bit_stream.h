@@ -19,16 +19,29 @@
 
 #include "io/base_bit_stream.h"
 #include "io/base_byte_stream.h"
+#include "io/lsb_bit_reader.h"
 
 namespace au {
 namespace io {
 
+    // When constructed from a bstr, reads through LsbBitReader. Otherwise
+    // fetches one byte at a time, so that reads from the underlying stream
+    // can be interleaved with reads from the bit stream.
     class LsbBitStream final : public BaseBitStream
     {
     public:
         LsbBitStream(const bstr &input);
         LsbBitStream(io::BaseByteStream &input_stream);
+
+        uoff_t pos() const override;
+        uoff_t size() const override;
+        BaseStream &seek(const uoff_t offset) override;
+
         u32 read(const size_t n) override;
+
+    private:
+        const bstr input;
+        std::unique_ptr<LsbBitReader> reader;
     };
 
 } }
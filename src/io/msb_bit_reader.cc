@@ -0,0 +1,69 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "io/msb_bit_reader.h"
+
+using namespace au;
+using namespace au::io;
+
+MsbBitReader::MsbBitReader(const u8 *data, const size_t size) :
+    begin(data),
+    end(data + size),
+    cursor(data),
+    buffer(0),
+    bits_available(0)
+{
+}
+
+MsbBitReader::MsbBitReader(const bstr &input)
+    : MsbBitReader(input.get<u8>(), input.size())
+{
+}
+
+uoff_t MsbBitReader::pos() const
+{
+    return (cursor - begin) * 8 - bits_available;
+}
+
+uoff_t MsbBitReader::size() const
+{
+    return (end - begin) * 8;
+}
+
+uoff_t MsbBitReader::left() const
+{
+    return size() - pos();
+}
+
+void MsbBitReader::seek(const uoff_t new_pos)
+{
+    if (new_pos > size())
+        throw err::EofError();
+    cursor = begin + new_pos / 8;
+    buffer = 0;
+    bits_available = 0;
+    consume(new_pos % 8);
+}
+
+void MsbBitReader::refill_slow()
+{
+    while (bits_available <= 56 && cursor < end)
+    {
+        buffer |= static_cast<u64>(*cursor++) << (56 - bits_available);
+        bits_available += 8;
+    }
+}
@@ -0,0 +1,109 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstring>
+#include "algo/endian.h"
+#include "err.h"
+#include "types.h"
+
+namespace au {
+namespace io {
+
+    // Reads bits starting from the most significant bit of each byte.
+    //
+    // Unlike MsbBitStream, it works directly on a contiguous buffer that
+    // must outlive the reader, and refills its 64-bit buffer with whole
+    // words. peek() and consume() are meant for table-driven decoding:
+    // peek() pads the input with zeros past its end, consume() throws
+    // err::EofError if it would run past the end, leaving the reader intact.
+    // Both take at most 32 bits at a time.
+    class MsbBitReader final
+    {
+    public:
+        MsbBitReader(const u8 *data, const size_t size);
+        explicit MsbBitReader(const bstr &input);
+        MsbBitReader(const bstr &&input) = delete;
+
+        uoff_t pos() const;
+        uoff_t size() const;
+        uoff_t left() const;
+        void seek(const uoff_t new_pos);
+
+        inline u32 peek(const size_t bits);
+        inline void consume(const size_t bits);
+        inline u32 read(const size_t bits);
+
+    private:
+        inline void refill();
+        void refill_slow();
+
+        const u8 *const begin;
+        const u8 *const end;
+        const u8 *cursor;
+
+        // upcoming bits, aligned to the most significant bit
+        u64 buffer;
+        size_t bits_available;
+    };
+
+    inline void MsbBitReader::refill()
+    {
+        if (end - cursor >= 8)
+        {
+            // Loads 8 bytes, but advances only by as many as fit in the
+            // buffer. The low bits past bits_available hold the bytes ahead
+            // of the cursor, so loading them again later changes nothing.
+            u64 word;
+            std::memcpy(&word, cursor, 8);
+            buffer |= algo::from_big_endian(word) >> bits_available;
+            cursor += (63 - bits_available) >> 3;
+            bits_available |= 56;
+        }
+        else
+            refill_slow();
+    }
+
+    inline u32 MsbBitReader::peek(const size_t bits)
+    {
+        if (bits_available < bits)
+            refill();
+        // two shifts so that peek(0) doesn't shift by 64
+        return static_cast<u32>((buffer >> 32) >> (32 - bits));
+    }
+
+    inline void MsbBitReader::consume(const size_t bits)
+    {
+        if (bits_available < bits)
+        {
+            refill();
+            if (bits_available < bits)
+                throw err::EofError();
+        }
+        buffer <<= bits;
+        bits_available -= bits;
+    }
+
+    inline u32 MsbBitReader::read(const size_t bits)
+    {
+        const auto value = peek(bits);
+        consume(bits);
+        return value;
+    }
+
+} }
@@ -16,12 +16,15 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "io/msb_bit_stream.h"
+#include "err.h"
 
 using namespace au;
 using namespace au::io;
 
-MsbBitStream::MsbBitStream(const bstr &input)
-    : BaseBitStream(input), dirty(false)
+MsbBitStream::MsbBitStream(const bstr &input) :
+    dirty(false),
+    input(input),
+    reader(new MsbBitReader(this->input))
 {
 }
 
@@ -35,6 +38,24 @@ MsbBitStream::~MsbBitStream()
     flush();
 }
 
+uoff_t MsbBitStream::pos() const
+{
+    return reader ? reader->pos() : BaseBitStream::pos();
+}
+
+uoff_t MsbBitStream::size() const
+{
+    return reader ? reader->size() : BaseBitStream::size();
+}
+
+BaseStream &MsbBitStream::seek(const uoff_t offset)
+{
+    if (!reader)
+        return BaseBitStream::seek(offset);
+    reader->seek(offset);
+    return *this;
+}
+
 void MsbBitStream::flush()
 {
     if (dirty)
@@ -46,6 +67,8 @@ void MsbBitStream::flush()
 
 u32 MsbBitStream::read(const size_t bits)
 {
+    if (reader)
+        return reader->read(bits);
     while (bits_available < bits)
     {
         const auto tmp = input_stream->read<u8>();
@@ -60,6 +83,8 @@ u32 MsbBitStream::read(const size_t bits)
 
 void MsbBitStream::write(const size_t bits, const u32 value)
 {
+    if (reader)
+        throw err::NotSupportedError("Cannot write to a read-only buffer");
     const auto mask = (1ull << bits) - 1;
     buffer <<= bits;
     buffer |= value & mask;
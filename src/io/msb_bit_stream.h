@@ -19,21 +19,33 @@
 
 #include "io/base_bit_stream.h"
 #include "io/base_byte_stream.h"
+#include "io/msb_bit_reader.h"
 
 namespace au {
 namespace io {
 
+    // When constructed from a bstr, reads through MsbBitReader. Otherwise
+    // fetches one byte at a time, so that reads from the underlying stream
+    // can be interleaved with reads from the bit stream.
     class MsbBitStream final : public BaseBitStream
     {
     public:
         MsbBitStream(const bstr &input);
         MsbBitStream(io::BaseByteStream &input_stream);
         ~MsbBitStream();
+
+        uoff_t pos() const override;
+        uoff_t size() const override;
+        BaseStream &seek(const uoff_t offset) override;
+
         u32 read(const size_t bits) override;
         void flush() override;
         void write(const size_t bits, const u32 value) override;
+
     private:
         bool dirty;
+        const bstr input;
+        std::unique_ptr<MsbBitReader> reader;
     };
 
 } }
@@ -16,7 +16,6 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "io/slice_byte_stream.h"
-#include <cstring>
 
 using namespace au;
 using namespace au::io;
@@ -36,8 +35,12 @@ SliceByteStream::SliceByteStream(
         slice_offset(slice_offset),
         slice_size(slice_size)
 {
-    if (slice_size > parent_stream.size() - slice_offset)
+    if (slice_offset > parent_stream.size()
+        || slice_size > parent_stream.size() - slice_offset)
+    {
         throw err::BadDataSizeError();
+    }
+    this->parent_stream->seek(slice_offset);
 }
 
 SliceByteStream::~SliceByteStream()
@@ -51,8 +54,9 @@ void SliceByteStream::seek_impl(const uoff_t offset)
 
 void SliceByteStream::read_impl(void *destination, const size_t size)
 {
-    const auto chunk = parent_stream->read(size);
-    std::memcpy(destination, chunk.get<u8>(), size);
+    if (pos() + size > slice_size)
+        throw err::EofError();
+    parent_stream->read(destination, size);
 }
 
 void SliceByteStream::write_impl(const void *source, const size_t size)
@@ -17,19 +17,43 @@
 
 #include "res/image.h"
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include "algo/format.h"
 #include "algo/range.h"
 #include "err.h"
+#include "res/image_kernels.h"
 
 using namespace au;
 using namespace au::res;
 
 static const Pixel transparent_pixel = {0, 0, 0, 0};
 
+static const ImageKernels &get_kernels()
+{
+    return get_image_kernels(algo::get_simd_level());
+}
+
 Image::Image(const Image &other) : Grid(other)
 {
 }
 
+Image::Image(Image &&other) noexcept : Grid(std::move(other))
+{
+}
+
+Image &Image::operator=(const Image &other)
+{
+    Grid::operator=(other);
+    return *this;
+}
+
+Image &Image::operator=(Image &&other) noexcept
+{
+    Grid::operator=(std::move(other));
+    return *this;
+}
+
 Image::Image(const size_t width, const size_t height) : Grid(width, height)
 {
 }
@@ -51,13 +75,27 @@ Image::Image(
     const size_t width,
     const size_t height,
     io::BaseByteStream &input_stream,
-    const PixelFormat fmt) :
-        Image(
-            width,
-            height,
-            input_stream.read(width * height * pixel_format_to_bpp(fmt)),
-            fmt)
+    const PixelFormat fmt) : Image(width, height)
 {
+    // convert in chunks rather than reading the whole input up front
+    const auto bpp = pixel_format_to_bpp(fmt);
+    if (input_stream.left() < bpp * width * height)
+        throw err::EofError();
+    if (!width || !height)
+        throw err::BadDataSizeError();
+    if (fmt == PixelFormat::BGRA8888)
+    {
+        input_stream.read(content.data(), content.size() * 4);
+        return;
+    }
+    std::array<u8, 0x3000> chunk;
+    const auto chunk_pixels = chunk.size() / std::max<size_t>(bpp, 1);
+    for (size_t i = 0; i < content.size(); i += chunk_pixels)
+    {
+        const auto count = std::min(chunk_pixels, content.size() - i);
+        input_stream.read(chunk.data(), count * bpp);
+        read_pixels(chunk.data(), &content[i], count, fmt);
+    }
 }
 
 Image::Image(
@@ -82,37 +120,30 @@ Image::Image(
 
 Image &Image::invert()
 {
-    for (const auto y : algo::range(_height))
-    for (const auto x : algo::range(_width))
-    {
-        at(x, y).r ^= 0xFF;
-        at(x, y).g ^= 0xFF;
-        at(x, y).b ^= 0xFF;
-    }
+    get_kernels().invert(content.data(), content.size());
     return *this;
 }
 
 Image &Image::flip_vertically()
 {
+    std::vector<Pixel> row(_width);
+    const auto row_size = _width * sizeof(Pixel);
     for (const auto y : algo::range(_height >> 1))
-    for (const auto x : algo::range(_width))
     {
-        const auto t = at(x, _height - 1 - y);
-        at(x, _height - 1 - y) = at(x, y);
-        at(x, y) = t;
+        auto top = &content[y * _width];
+        auto bottom = &content[(_height - 1 - y) * _width];
+        std::memcpy(row.data(), top, row_size);
+        std::memcpy(top, bottom, row_size);
+        std::memcpy(bottom, row.data(), row_size);
     }
     return *this;
 }
 
 Image &Image::flip_horizontally()
 {
+    const auto &kernels = get_kernels();
     for (const auto y : algo::range(_height))
-    for (const auto x : algo::range(_width >> 1))
-    {
-        const auto t = at(_width - 1 - x, y);
-        at(_width - 1 - x, y) = at(x, y);
-        at(x, y) = t;
-    }
+        kernels.reverse(&content[y * _width], _width);
     return *this;
 }
 
@@ -127,25 +158,20 @@ Image &Image::offset(const int x_offset, const int y_offset)
 
 Image &Image::crop(const size_t new_width, const size_t new_height)
 {
-    std::vector<Pixel> old_content(content.begin(), content.end());
     if (!new_width || !new_height)
         throw err::BadDataSizeError();
+    std::vector<Pixel> old_content(std::move(content));
     const auto old_width = _width;
     const auto old_height = _height;
     _width = new_width;
     _height = new_height;
-    content.resize(new_width * new_height);
+    content.assign(new_width * new_height, transparent_pixel);
+    const auto row_size = std::min(old_width, new_width) * sizeof(Pixel);
     for (const auto y : algo::range(std::min(old_height, new_height)))
-    for (const auto x : algo::range(std::min(old_width, new_width)))
     {
-        content[y * new_width + x] = old_content[y * old_width + x];
+        std::memcpy(
+            &content[y * new_width], &old_content[y * old_width], row_size);
     }
-    for (const auto y : algo::range(old_height, new_height))
-    for (const auto x : algo::range(new_width))
-        content[y * new_width + x] = transparent_pixel;
-    for (const auto y : algo::range(old_height))
-    for (const auto x : algo::range(old_width, new_width))
-        content[y * new_width + x] = transparent_pixel;
     return *this;
 }
 
@@ -153,22 +179,19 @@ Image &Image::apply_mask(const Image &other)
 {
     if (other.width() != _width || other.height() != _height)
         throw std::logic_error("Mask image size is different from image size");
-    for (const auto y : algo::range(_height))
-    for (const auto x : algo::range(_width))
-        at(x, y).a = other.at(x, y).r;
+    get_kernels().apply_mask(
+        content.data(), other.content.data(), content.size());
     return *this;
 }
 
 Image &Image::apply_palette(const Palette &palette)
 {
-    const auto palette_size = palette.size();
-    for (auto &c : content)
-    {
-        if (c.r < palette_size)
-            c = palette[c.r];
-        else
-            c.a = 0;
-    }
+    // only the red channel is used as an index, so 256 entries suffice
+    std::array<Pixel, 256> table = {};
+    const auto palette_size = std::min<size_t>(palette.size(), table.size());
+    std::copy(palette.begin(), palette.begin() + palette_size, table.begin());
+    get_kernels().apply_palette(
+        content.data(), content.size(), table.data(), palette_size);
     return *this;
 }
 
@@ -185,43 +208,32 @@ Image &Image::overlay(
     const int target_y,
     const OverlayKind overlay_kind)
 {
+    if (overlay_kind != OverlayKind::OverwriteAll
+        && overlay_kind != OverlayKind::OverwriteNonTransparent
+        && overlay_kind != OverlayKind::AddSimple)
+    {
+        throw std::logic_error("Unknown overlay kind");
+    }
+
     const int x1 = std::max<int>(0, target_x);
     const int x2 = std::min<int>(width(), target_x + other.width());
     const int y1 = std::max<int>(0, target_y);
     const int y2 = std::min<int>(height(), target_y + other.height());
-    const int source_x = -target_x;
-    const int source_y = -target_y;
-    if (overlay_kind == OverlayKind::OverwriteAll)
-    {
-        for (const auto y : algo::range(y1, y2))
-        for (const auto x : algo::range(x1, x2))
-            at(x, y) = other.at(source_x + x, source_y + y);
-    }
-    else if (overlay_kind == OverlayKind::OverwriteNonTransparent)
-    {
-        for (const auto y : algo::range(y1, y2))
-        for (const auto x : algo::range(x1, x2))
-        {
-            const auto &source_pixel = other.at(source_x + x, source_y + y);
-            if (source_pixel.a)
-                at(x, y) = source_pixel;
-        }
-    }
-    else if (overlay_kind == OverlayKind::AddSimple)
-    {
-        for (const auto y : algo::range(y1, y2))
-        for (const auto x : algo::range(x1, x2))
-        {
-            auto &target_pixel = at(x, y);
-            const auto &source_pixel = other.at(source_x + x, source_y + y);
-            target_pixel.r += source_pixel.r;
-            target_pixel.g += source_pixel.g;
-            target_pixel.b += source_pixel.b;
-        }
-    }
-    else
+    if (x1 >= x2)
+        return *this;
+    const auto source_x = x1 - target_x;
+    const auto size = x2 - x1;
+    const auto &kernels = get_kernels();
+    for (const auto y : algo::range(y1, y2))
     {
-        throw std::logic_error("Unknown overlay kind");
+        auto target_ptr = &at(x1, y);
+        const auto source_ptr = &other.at(source_x, y - target_y);
+        if (overlay_kind == OverlayKind::OverwriteAll)
+            std::memmove(target_ptr, source_ptr, size * sizeof(Pixel));
+        else if (overlay_kind == OverlayKind::OverwriteNonTransparent)
+            kernels.overlay_non_transparent(target_ptr, source_ptr, size);
+        else
+            kernels.overlay_add(target_ptr, source_ptr, size);
     }
     return *this;
 }
@@ -38,6 +38,9 @@ namespace res {
         };
 
         Image(const Image &other);
+        Image(Image &&other) noexcept;
+        Image &operator=(const Image &other);
+        Image &operator=(Image &&other) noexcept;
 
         Image(const size_t width, const size_t height);
 
@@ -0,0 +1,351 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "res/image_kernels.h"
+#include <algorithm>
+#if SIMD_X86
+    #include <immintrin.h>
+#endif
+
+using namespace au;
+using namespace au::res;
+
+// All kernels must produce exactly the same output as the plain loops.
+
+static void invert_scalar(Pixel *pixels, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        pixels[i].r ^= 0xFF;
+        pixels[i].g ^= 0xFF;
+        pixels[i].b ^= 0xFF;
+    }
+}
+
+static void reverse_scalar(Pixel *pixels, const size_t count)
+{
+    std::reverse(pixels, pixels + count);
+}
+
+static void apply_mask_scalar(
+    Pixel *target, const Pixel *mask, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        target[i].a = mask[i].r;
+}
+
+static void apply_palette_scalar(
+    Pixel *pixels,
+    const size_t count,
+    const Pixel *table,
+    const size_t palette_size)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        auto &c = pixels[i];
+        if (c.r < palette_size)
+            c = table[c.r];
+        else
+            c.a = 0;
+    }
+}
+
+static void overlay_non_transparent_scalar(
+    Pixel *target, const Pixel *source, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        if (source[i].a)
+            target[i] = source[i];
+}
+
+static void overlay_add_scalar(
+    Pixel *target, const Pixel *source, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        target[i].r += source[i].r;
+        target[i].g += source[i].g;
+        target[i].b += source[i].b;
+    }
+}
+
+#if SIMD_X86
+
+static SIMD_TARGET("sse2") void invert_sse2(Pixel *pixels, const size_t count)
+{
+    const auto blocks = count / 4;
+    const auto mask = _mm_set1_epi32(0x00FFFFFF);
+    auto ptr = reinterpret_cast<__m128i*>(pixels);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        _mm_storeu_si128(
+            ptr + i, _mm_xor_si128(_mm_loadu_si128(ptr + i), mask));
+    }
+    invert_scalar(pixels + blocks * 4, count - blocks * 4);
+}
+
+static SIMD_TARGET("sse2") void reverse_sse2(Pixel *pixels, const size_t count)
+{
+    auto front = pixels;
+    auto back = pixels + count;
+    while (back - front >= 8)
+    {
+        back -= 4;
+        auto front_ptr = reinterpret_cast<__m128i*>(front);
+        auto back_ptr = reinterpret_cast<__m128i*>(back);
+        const auto a = _mm_shuffle_epi32(_mm_loadu_si128(front_ptr), 0x1B);
+        const auto b = _mm_shuffle_epi32(_mm_loadu_si128(back_ptr), 0x1B);
+        _mm_storeu_si128(front_ptr, b);
+        _mm_storeu_si128(back_ptr, a);
+        front += 4;
+    }
+    std::reverse(front, back);
+}
+
+static SIMD_TARGET("sse2") void apply_mask_sse2(
+    Pixel *target, const Pixel *mask, const size_t count)
+{
+    const auto blocks = count / 4;
+    const auto color_mask = _mm_set1_epi32(0x00FFFFFF);
+    const auto alpha_mask = _mm_set1_epi32(0xFF000000);
+    auto target_ptr = reinterpret_cast<__m128i*>(target);
+    auto mask_ptr = reinterpret_cast<const __m128i*>(mask);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto t = _mm_loadu_si128(target_ptr + i);
+        const auto m = _mm_loadu_si128(mask_ptr + i);
+        _mm_storeu_si128(
+            target_ptr + i,
+            _mm_or_si128(
+                _mm_and_si128(t, color_mask),
+                _mm_and_si128(_mm_slli_epi32(m, 8), alpha_mask)));
+    }
+    apply_mask_scalar(
+        target + blocks * 4, mask + blocks * 4, count - blocks * 4);
+}
+
+static SIMD_TARGET("sse2") void overlay_non_transparent_sse2(
+    Pixel *target, const Pixel *source, const size_t count)
+{
+    const auto blocks = count / 4;
+    const auto alpha_mask = _mm_set1_epi32(0xFF000000);
+    auto target_ptr = reinterpret_cast<__m128i*>(target);
+    auto source_ptr = reinterpret_cast<const __m128i*>(source);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto t = _mm_loadu_si128(target_ptr + i);
+        const auto s = _mm_loadu_si128(source_ptr + i);
+        const auto transparent = _mm_cmpeq_epi32(
+            _mm_and_si128(s, alpha_mask), _mm_setzero_si128());
+        _mm_storeu_si128(
+            target_ptr + i,
+            _mm_or_si128(
+                _mm_and_si128(transparent, t),
+                _mm_andnot_si128(transparent, s)));
+    }
+    overlay_non_transparent_scalar(
+        target + blocks * 4, source + blocks * 4, count - blocks * 4);
+}
+
+static SIMD_TARGET("sse2") void overlay_add_sse2(
+    Pixel *target, const Pixel *source, const size_t count)
+{
+    const auto blocks = count / 4;
+    const auto color_mask = _mm_set1_epi32(0x00FFFFFF);
+    auto target_ptr = reinterpret_cast<__m128i*>(target);
+    auto source_ptr = reinterpret_cast<const __m128i*>(source);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto t = _mm_loadu_si128(target_ptr + i);
+        const auto s = _mm_loadu_si128(source_ptr + i);
+        _mm_storeu_si128(
+            target_ptr + i,
+            _mm_add_epi8(t, _mm_and_si128(s, color_mask)));
+    }
+    overlay_add_scalar(
+        target + blocks * 4, source + blocks * 4, count - blocks * 4);
+}
+
+static SIMD_TARGET("avx2") void invert_avx2(Pixel *pixels, const size_t count)
+{
+    const auto blocks = count / 8;
+    const auto mask = _mm256_set1_epi32(0x00FFFFFF);
+    auto ptr = reinterpret_cast<__m256i*>(pixels);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        _mm256_storeu_si256(
+            ptr + i, _mm256_xor_si256(_mm256_loadu_si256(ptr + i), mask));
+    }
+    invert_scalar(pixels + blocks * 8, count - blocks * 8);
+}
+
+static SIMD_TARGET("avx2") void reverse_avx2(Pixel *pixels, const size_t count)
+{
+    const auto order = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    auto front = pixels;
+    auto back = pixels + count;
+    while (back - front >= 16)
+    {
+        back -= 8;
+        auto front_ptr = reinterpret_cast<__m256i*>(front);
+        auto back_ptr = reinterpret_cast<__m256i*>(back);
+        const auto a = _mm256_permutevar8x32_epi32(
+            _mm256_loadu_si256(front_ptr), order);
+        const auto b = _mm256_permutevar8x32_epi32(
+            _mm256_loadu_si256(back_ptr), order);
+        _mm256_storeu_si256(front_ptr, b);
+        _mm256_storeu_si256(back_ptr, a);
+        front += 8;
+    }
+    std::reverse(front, back);
+}
+
+static SIMD_TARGET("avx2") void apply_mask_avx2(
+    Pixel *target, const Pixel *mask, const size_t count)
+{
+    const auto blocks = count / 8;
+    const auto color_mask = _mm256_set1_epi32(0x00FFFFFF);
+    const auto alpha_mask = _mm256_set1_epi32(0xFF000000);
+    auto target_ptr = reinterpret_cast<__m256i*>(target);
+    auto mask_ptr = reinterpret_cast<const __m256i*>(mask);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto t = _mm256_loadu_si256(target_ptr + i);
+        const auto m = _mm256_loadu_si256(mask_ptr + i);
+        _mm256_storeu_si256(
+            target_ptr + i,
+            _mm256_or_si256(
+                _mm256_and_si256(t, color_mask),
+                _mm256_and_si256(_mm256_slli_epi32(m, 8), alpha_mask)));
+    }
+    apply_mask_scalar(
+        target + blocks * 8, mask + blocks * 8, count - blocks * 8);
+}
+
+static SIMD_TARGET("avx2") void apply_palette_avx2(
+    Pixel *pixels,
+    const size_t count,
+    const Pixel *table,
+    const size_t palette_size)
+{
+    const auto blocks = count / 8;
+    const auto size = _mm256_set1_epi32(palette_size);
+    const auto index_mask = _mm256_set1_epi32(0xFF);
+    const auto color_mask = _mm256_set1_epi32(0x00FFFFFF);
+    const auto table_ptr = reinterpret_cast<const int*>(table);
+    auto ptr = reinterpret_cast<__m256i*>(pixels);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto c = _mm256_loadu_si256(ptr + i);
+        const auto index = _mm256_and_si256(
+            _mm256_srli_epi32(c, 16), index_mask);
+        const auto colors = _mm256_i32gather_epi32(table_ptr, index, 4);
+        const auto in_range = _mm256_cmpgt_epi32(size, index);
+        _mm256_storeu_si256(
+            ptr + i,
+            _mm256_blendv_epi8(
+                _mm256_and_si256(c, color_mask), colors, in_range));
+    }
+    apply_palette_scalar(
+        pixels + blocks * 8, count - blocks * 8, table, palette_size);
+}
+
+static SIMD_TARGET("avx2") void overlay_non_transparent_avx2(
+    Pixel *target, const Pixel *source, const size_t count)
+{
+    const auto blocks = count / 8;
+    const auto alpha_mask = _mm256_set1_epi32(0xFF000000);
+    auto target_ptr = reinterpret_cast<__m256i*>(target);
+    auto source_ptr = reinterpret_cast<const __m256i*>(source);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto t = _mm256_loadu_si256(target_ptr + i);
+        const auto s = _mm256_loadu_si256(source_ptr + i);
+        const auto transparent = _mm256_cmpeq_epi32(
+            _mm256_and_si256(s, alpha_mask), _mm256_setzero_si256());
+        _mm256_storeu_si256(
+            target_ptr + i, _mm256_blendv_epi8(s, t, transparent));
+    }
+    overlay_non_transparent_scalar(
+        target + blocks * 8, source + blocks * 8, count - blocks * 8);
+}
+
+static SIMD_TARGET("avx2") void overlay_add_avx2(
+    Pixel *target, const Pixel *source, const size_t count)
+{
+    const auto blocks = count / 8;
+    const auto color_mask = _mm256_set1_epi32(0x00FFFFFF);
+    auto target_ptr = reinterpret_cast<__m256i*>(target);
+    auto source_ptr = reinterpret_cast<const __m256i*>(source);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto t = _mm256_loadu_si256(target_ptr + i);
+        const auto s = _mm256_loadu_si256(source_ptr + i);
+        _mm256_storeu_si256(
+            target_ptr + i,
+            _mm256_add_epi8(t, _mm256_and_si256(s, color_mask)));
+    }
+    overlay_add_scalar(
+        target + blocks * 8, source + blocks * 8, count - blocks * 8);
+}
+
+#endif
+
+static const ImageKernels scalar_kernels =
+{
+    invert_scalar,
+    reverse_scalar,
+    apply_mask_scalar,
+    apply_palette_scalar,
+    overlay_non_transparent_scalar,
+    overlay_add_scalar,
+};
+
+#if SIMD_X86
+
+static const ImageKernels sse2_kernels =
+{
+    invert_sse2,
+    reverse_sse2,
+    apply_mask_sse2,
+    apply_palette_scalar,
+    overlay_non_transparent_sse2,
+    overlay_add_sse2,
+};
+
+static const ImageKernels avx2_kernels =
+{
+    invert_avx2,
+    reverse_avx2,
+    apply_mask_avx2,
+    apply_palette_avx2,
+    overlay_non_transparent_avx2,
+    overlay_add_avx2,
+};
+
+#endif
+
+const ImageKernels &res::get_image_kernels(const algo::SimdLevel level)
+{
+    #if SIMD_X86
+        if (level == algo::SimdLevel::Avx2)
+            return avx2_kernels;
+        if (level == algo::SimdLevel::Sse2 || level == algo::SimdLevel::Ssse3)
+            return sse2_kernels;
+    #endif
+    return scalar_kernels;
+}
@@ -0,0 +1,61 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "algo/cpu_features.h"
+#include "res/pixel.h"
+
+namespace au {
+namespace res {
+
+    // Row operations behind Image, written once per instruction set.
+    struct ImageKernels final
+    {
+        // Inverts the color channels, leaving alpha alone.
+        void (*invert)(Pixel *pixels, const size_t count);
+
+        // Reverses the order of pixels.
+        void (*reverse)(Pixel *pixels, const size_t count);
+
+        // Takes alpha from the red channel of the mask.
+        void (*apply_mask)(
+            Pixel *target, const Pixel *mask, const size_t count);
+
+        // Replaces pixels with palette[pixel.r]. Pixels past the end of the
+        // palette become transparent instead. The table must hold 256
+        // entries; only the first palette_size are valid.
+        void (*apply_palette)(
+            Pixel *pixels,
+            const size_t count,
+            const Pixel *table,
+            const size_t palette_size);
+
+        // Copies source pixels whose alpha isn't zero.
+        void (*overlay_non_transparent)(
+            Pixel *target, const Pixel *source, const size_t count);
+
+        // Adds the color channels with wraparound, leaving alpha alone.
+        void (*overlay_add)(
+            Pixel *target, const Pixel *source, const size_t count);
+    };
+
+    // Operations that have no kernel for the given instruction set use
+    // older ones, down to plain loops.
+    const ImageKernels &get_image_kernels(const algo::SimdLevel level);
+
+} }
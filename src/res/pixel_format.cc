@@ -19,6 +19,7 @@
 #include <cstring>
 #include "algo/format.h"
 #include "algo/range.h"
+#include "res/pixel_kernels.h"
 
 namespace au {
 namespace res {
@@ -255,47 +256,101 @@ namespace res {
         return c;
     }
 
-    void read_pixels(
-        const u8 *input_ptr, std::vector<Pixel> &output, const PixelFormat fmt)
+    template<PixelFormat fmt> static void read_pixels_scalar(
+        const u8 *input_ptr, Pixel *output_ptr, const size_t count)
     {
-        // save those precious CPU cycles
-        if (fmt == PixelFormat::BGRA8888)
-        {
-            std::memcpy(output.data(), input_ptr, output.size() * 4);
-            return;
-        }
+        for (const auto i : algo::range(count))
+            output_ptr[i] = read_pixel<fmt>(input_ptr);
+    }
+
+    using ScalarKernel = void (*)(const u8 *, Pixel *, const size_t);
 
+    static ScalarKernel get_scalar_kernel(const PixelFormat fmt)
+    {
         // I don't think there is a better alternative to this
         using PF = PixelFormat;
-        std::function<void(const u8 *, std::vector<Pixel> &)> impl;
         switch (fmt)
         {
-            case PF::Gray8:     impl = read_pixels<PF::Gray8>; break;
-            case PF::BGR555X:   impl = read_pixels<PF::BGR555X>; break;
-            case PF::BGR565:    impl = read_pixels<PF::BGR565>; break;
-            case PF::BGR888:    impl = read_pixels<PF::BGR888>; break;
-            case PF::BGR888X:   impl = read_pixels<PF::BGR888X>; break;
-            case PF::BGRA4444:  impl = read_pixels<PF::BGRA4444>; break;
-            case PF::BGRA5551:  impl = read_pixels<PF::BGRA5551>; break;
-            case PF::BGRA8888:  impl = read_pixels<PF::BGRA8888>; break;
-            case PF::BGRnA4444: impl = read_pixels<PF::BGRnA4444>; break;
-            case PF::BGRnA5551: impl = read_pixels<PF::BGRnA5551>; break;
-            case PF::BGRnA8888: impl = read_pixels<PF::BGRnA8888>; break;
-            case PF::RGB555X:   impl = read_pixels<PF::RGB555X>; break;
-            case PF::RGB565:    impl = read_pixels<PF::RGB565>; break;
-            case PF::RGB888:    impl = read_pixels<PF::RGB888>; break;
-            case PF::RGB888X:   impl = read_pixels<PF::RGB888X>; break;
-            case PF::RGBA4444:  impl = read_pixels<PF::RGBA4444>; break;
-            case PF::RGBA5551:  impl = read_pixels<PF::RGBA5551>; break;
-            case PF::RGBA8888:  impl = read_pixels<PF::RGBA8888>; break;
-            case PF::RGBnA4444: impl = read_pixels<PF::RGBnA4444>; break;
-            case PF::RGBnA5551: impl = read_pixels<PF::RGBnA5551>; break;
-            case PF::RGBnA8888: impl = read_pixels<PF::RGBnA8888>; break;
+            case PF::Gray8:     return read_pixels_scalar<PF::Gray8>;
+            case PF::BGR555X:   return read_pixels_scalar<PF::BGR555X>;
+            case PF::BGR565:    return read_pixels_scalar<PF::BGR565>;
+            case PF::BGR888:    return read_pixels_scalar<PF::BGR888>;
+            case PF::BGR888X:   return read_pixels_scalar<PF::BGR888X>;
+            case PF::BGRA4444:  return read_pixels_scalar<PF::BGRA4444>;
+            case PF::BGRA5551:  return read_pixels_scalar<PF::BGRA5551>;
+            case PF::BGRA8888:  return read_pixels_scalar<PF::BGRA8888>;
+            case PF::BGRnA4444: return read_pixels_scalar<PF::BGRnA4444>;
+            case PF::BGRnA5551: return read_pixels_scalar<PF::BGRnA5551>;
+            case PF::BGRnA8888: return read_pixels_scalar<PF::BGRnA8888>;
+            case PF::RGB555X:   return read_pixels_scalar<PF::RGB555X>;
+            case PF::RGB565:    return read_pixels_scalar<PF::RGB565>;
+            case PF::RGB888:    return read_pixels_scalar<PF::RGB888>;
+            case PF::RGB888X:   return read_pixels_scalar<PF::RGB888X>;
+            case PF::RGBA4444:  return read_pixels_scalar<PF::RGBA4444>;
+            case PF::RGBA5551:  return read_pixels_scalar<PF::RGBA5551>;
+            case PF::RGBA8888:  return read_pixels_scalar<PF::RGBA8888>;
+            case PF::RGBnA4444: return read_pixels_scalar<PF::RGBnA4444>;
+            case PF::RGBnA5551: return read_pixels_scalar<PF::RGBnA5551>;
+            case PF::RGBnA8888: return read_pixels_scalar<PF::RGBnA8888>;
             default:
                 throw std::logic_error(
                     algo::format("Unsupported pixel format: %d", fmt));
         }
-        impl(input_ptr, output);
+    }
+
+    // Falls back to older instruction sets if there's no kernel for the
+    // requested one.
+    static PixelKernel find_kernel(
+        const PixelFormat fmt, const algo::SimdLevel level)
+    {
+        if (level == algo::SimdLevel::Neon)
+            return get_pixel_kernel(fmt, level);
+        for (auto i = static_cast<int>(level); i > 0; i--)
+        {
+            const auto kernel
+                = get_pixel_kernel(fmt, static_cast<algo::SimdLevel>(i));
+            if (kernel)
+                return kernel;
+        }
+        return nullptr;
+    }
+
+    void read_pixels(
+        const u8 *input_ptr,
+        Pixel *output_ptr,
+        const size_t count,
+        const PixelFormat fmt,
+        const algo::SimdLevel level)
+    {
+        // save those precious CPU cycles
+        if (fmt == PixelFormat::BGRA8888)
+        {
+            std::memcpy(output_ptr, input_ptr, count * 4);
+            return;
+        }
+
+        const auto scalar_kernel = get_scalar_kernel(fmt);
+        const auto kernel = find_kernel(fmt, level);
+        const auto done = kernel ? kernel(input_ptr, output_ptr, count) : 0;
+        scalar_kernel(
+            input_ptr + done * pixel_format_to_bpp(fmt),
+            output_ptr + done,
+            count - done);
+    }
+
+    void read_pixels(
+        const u8 *input_ptr,
+        Pixel *output_ptr,
+        const size_t count,
+        const PixelFormat fmt)
+    {
+        read_pixels(input_ptr, output_ptr, count, fmt, algo::get_simd_level());
+    }
+
+    void read_pixels(
+        const u8 *input_ptr, std::vector<Pixel> &output, const PixelFormat fmt)
+    {
+        read_pixels(input_ptr, output.data(), output.size(), fmt);
     }
 
 } }
@@ -90,6 +90,14 @@ namespace res {
             c = read_pixel<fmt>(input_ptr);
     }
 
+    // Converts count pixels from a contiguous buffer, using the best
+    // vectorized kernel the CPU supports.
+    void read_pixels(
+        const u8 *input_ptr,
+        Pixel *output_ptr,
+        const size_t count,
+        const PixelFormat fmt);
+
     void read_pixels(
         const u8 *input_ptr,
         std::vector<Pixel> &output,
@@ -0,0 +1,456 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "res/pixel_kernels.h"
+#if SIMD_X86
+    #include <immintrin.h>
+#endif
+#if SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
+using namespace au;
+using namespace au::res;
+
+// All kernels must produce exactly the same output as read_pixel<fmt>.
+
+namespace
+{
+    enum class Alpha : u8
+    {
+        Opaque, // 0xFF
+        Bits,   // taken from a_mask, a_shift
+        Sign,   // 0xFF if the top bit is set, 0 otherwise
+    };
+
+    // Describes a 16-bit format as a mask and a shift for every channel.
+    // Positive shifts go left.
+    template<
+        u16 b_mask_, int b_shift_,
+        u16 g_mask_, int g_shift_,
+        u16 r_mask_, int r_shift_,
+        Alpha alpha_, u16 a_mask_, int a_shift_, u8 a_xor_>
+    struct Format16 final
+    {
+        static const u16 b_mask = b_mask_;
+        static const int b_shift = b_shift_;
+        static const u16 g_mask = g_mask_;
+        static const int g_shift = g_shift_;
+        static const u16 r_mask = r_mask_;
+        static const int r_shift = r_shift_;
+        static const Alpha alpha = alpha_;
+        static const u16 a_mask = a_mask_;
+        static const int a_shift = a_shift_;
+        static const u8 a_xor = a_xor_;
+    };
+
+    template<typename T> using SwapRb = Format16<
+        T::r_mask, T::r_shift,
+        T::g_mask, T::g_shift,
+        T::b_mask, T::b_shift,
+        T::alpha, T::a_mask, T::a_shift, T::a_xor>;
+
+    using Bgr555X = Format16<
+        0x001F, 3, 0x03E0, -2, 0x7C00, -7, Alpha::Opaque, 0, 0, 0>;
+    using Bgr565 = Format16<
+        0x001F, 3, 0x07E0, -3, 0xF800, -8, Alpha::Opaque, 0, 0, 0>;
+    using Bgra4444 = Format16<
+        0x000F, 4, 0x00F0, 0, 0x0F00, -4, Alpha::Bits, 0xF000, -8, 0>;
+    using Bgra5551 = Format16<
+        0x001F, 3, 0x03E0, -2, 0x7C00, -7, Alpha::Sign, 0, 0, 0>;
+    using BgrnA4444 = Format16<
+        0x000F, 4, 0x00F0, 0, 0x0F00, -4, Alpha::Bits, 0xF000, -8, 0xFF>;
+    using BgrnA5551 = Format16<
+        0x001F, 3, 0x03E0, -2, 0x7C00, -7, Alpha::Sign, 0, 0, 0xFF>;
+
+    // Describes a 32-bit format relative to BGRA8888.
+    template<bool swap_rb_, u32 or_mask_, u32 xor_mask_> struct Format32 final
+    {
+        static const bool swap_rb = swap_rb_;
+        static const u32 or_mask = or_mask_;
+        static const u32 xor_mask = xor_mask_;
+    };
+
+    using Bgr888X = Format32<false, 0xFF000000, 0>;
+    using BgrnA8888 = Format32<false, 0, 0xFF000000>;
+    using Rgb888X = Format32<true, 0xFF000000, 0>;
+    using Rgba8888 = Format32<true, 0, 0>;
+    using RgbnA8888 = Format32<true, 0, 0xFF000000>;
+}
+
+#if SIMD_X86
+
+template<u16 mask, int shift> static SIMD_TARGET("sse2")
+    inline __m128i extract_sse2(const __m128i v)
+{
+    const auto x = _mm_and_si128(v, _mm_set1_epi16(mask));
+    if (shift > 0)
+        return _mm_slli_epi16(x, shift > 0 ? shift : 0);
+    if (shift < 0)
+        return _mm_srli_epi16(x, shift < 0 ? -shift : 0);
+    return x;
+}
+
+template<typename T> static SIMD_TARGET("sse2")
+    size_t read_16bpp_sse2(
+        const u8 *input_ptr, Pixel *output_ptr, const size_t count)
+{
+    const auto blocks = count / 8;
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto v = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(input_ptr) + i);
+        const auto b = extract_sse2<T::b_mask, T::b_shift>(v);
+        const auto g = extract_sse2<T::g_mask, T::g_shift>(v);
+        const auto r = extract_sse2<T::r_mask, T::r_shift>(v);
+        auto a = _mm_set1_epi16(0xFF);
+        if (T::alpha == Alpha::Bits)
+            a = extract_sse2<T::a_mask, T::a_shift>(v);
+        else if (T::alpha == Alpha::Sign)
+            a = _mm_srli_epi16(_mm_srai_epi16(v, 15), 8);
+        if (T::a_xor)
+            a = _mm_xor_si128(a, _mm_set1_epi16(T::a_xor));
+        const auto bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+        const auto ra = _mm_or_si128(r, _mm_slli_epi16(a, 8));
+        auto target = reinterpret_cast<__m128i*>(output_ptr) + i * 2;
+        _mm_storeu_si128(target, _mm_unpacklo_epi16(bg, ra));
+        _mm_storeu_si128(target + 1, _mm_unpackhi_epi16(bg, ra));
+    }
+    return blocks * 8;
+}
+
+template<typename T> static SIMD_TARGET("sse2")
+    size_t read_32bpp_sse2(
+        const u8 *input_ptr, Pixel *output_ptr, const size_t count)
+{
+    const auto blocks = count / 4;
+    for (size_t i = 0; i < blocks; i++)
+    {
+        auto v = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(input_ptr) + i);
+        if (T::swap_rb)
+        {
+            v = _mm_or_si128(
+                _mm_and_si128(v, _mm_set1_epi32(0xFF00FF00)),
+                _mm_or_si128(
+                    _mm_and_si128(
+                        _mm_srli_epi32(v, 16), _mm_set1_epi32(0xFF)),
+                    _mm_and_si128(
+                        _mm_slli_epi32(v, 16), _mm_set1_epi32(0xFF0000))));
+        }
+        if (T::or_mask)
+            v = _mm_or_si128(v, _mm_set1_epi32(T::or_mask));
+        if (T::xor_mask)
+            v = _mm_xor_si128(v, _mm_set1_epi32(T::xor_mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output_ptr) + i, v);
+    }
+    return blocks * 4;
+}
+
+static SIMD_TARGET("sse2") size_t read_gray8_sse2(
+    const u8 *input_ptr, Pixel *output_ptr, const size_t count)
+{
+    const auto blocks = count / 16;
+    const auto opaque = _mm_set1_epi8(static_cast<char>(0xFF));
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto v = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(input_ptr) + i);
+        const auto gg_lo = _mm_unpacklo_epi8(v, v);
+        const auto gg_hi = _mm_unpackhi_epi8(v, v);
+        const auto ga_lo = _mm_unpacklo_epi8(v, opaque);
+        const auto ga_hi = _mm_unpackhi_epi8(v, opaque);
+        auto target = reinterpret_cast<__m128i*>(output_ptr) + i * 4;
+        _mm_storeu_si128(target, _mm_unpacklo_epi16(gg_lo, ga_lo));
+        _mm_storeu_si128(target + 1, _mm_unpackhi_epi16(gg_lo, ga_lo));
+        _mm_storeu_si128(target + 2, _mm_unpacklo_epi16(gg_hi, ga_hi));
+        _mm_storeu_si128(target + 3, _mm_unpackhi_epi16(gg_hi, ga_hi));
+    }
+    return blocks * 16;
+}
+
+template<bool swap_rb> static SIMD_TARGET("ssse3")
+    size_t read_24bpp_ssse3(
+        const u8 *input_ptr, Pixel *output_ptr, const size_t count)
+{
+    const auto shuffle = swap_rb
+        ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1)
+        : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const auto opaque = _mm_set1_epi32(0xFF000000);
+    const auto blocks = count / 16;
+    for (size_t i = 0; i < blocks; i++)
+    {
+        // 16 pixels take exactly three registers
+        const auto source = reinterpret_cast<const __m128i*>(input_ptr) + i * 3;
+        const auto a = _mm_loadu_si128(source);
+        const auto b = _mm_loadu_si128(source + 1);
+        const auto c = _mm_loadu_si128(source + 2);
+        const __m128i groups[4] =
+        {
+            a,
+            _mm_alignr_epi8(b, a, 12),
+            _mm_alignr_epi8(c, b, 8),
+            _mm_srli_si128(c, 4),
+        };
+        auto target = reinterpret_cast<__m128i*>(output_ptr) + i * 4;
+        for (size_t j = 0; j < 4; j++)
+        {
+            _mm_storeu_si128(
+                target + j,
+                _mm_or_si128(_mm_shuffle_epi8(groups[j], shuffle), opaque));
+        }
+    }
+    return blocks * 16;
+}
+
+template<u16 mask, int shift> static SIMD_TARGET("avx2")
+    inline __m256i extract_avx2(const __m256i v)
+{
+    const auto x = _mm256_and_si256(v, _mm256_set1_epi16(mask));
+    if (shift > 0)
+        return _mm256_slli_epi16(x, shift > 0 ? shift : 0);
+    if (shift < 0)
+        return _mm256_srli_epi16(x, shift < 0 ? -shift : 0);
+    return x;
+}
+
+template<typename T> static SIMD_TARGET("avx2")
+    size_t read_16bpp_avx2(
+        const u8 *input_ptr, Pixel *output_ptr, const size_t count)
+{
+    const auto blocks = count / 16;
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(input_ptr) + i);
+        const auto b = extract_avx2<T::b_mask, T::b_shift>(v);
+        const auto g = extract_avx2<T::g_mask, T::g_shift>(v);
+        const auto r = extract_avx2<T::r_mask, T::r_shift>(v);
+        auto a = _mm256_set1_epi16(0xFF);
+        if (T::alpha == Alpha::Bits)
+            a = extract_avx2<T::a_mask, T::a_shift>(v);
+        else if (T::alpha == Alpha::Sign)
+            a = _mm256_srli_epi16(_mm256_srai_epi16(v, 15), 8);
+        if (T::a_xor)
+            a = _mm256_xor_si256(a, _mm256_set1_epi16(T::a_xor));
+        const auto bg = _mm256_or_si256(b, _mm256_slli_epi16(g, 8));
+        const auto ra = _mm256_or_si256(r, _mm256_slli_epi16(a, 8));
+        // unpacking works within 128-bit lanes, so put the halves back in
+        // order before storing
+        const auto lo = _mm256_unpacklo_epi16(bg, ra);
+        const auto hi = _mm256_unpackhi_epi16(bg, ra);
+        auto target = reinterpret_cast<__m256i*>(output_ptr) + i * 2;
+        _mm256_storeu_si256(target, _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(
+            target + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    return blocks * 16;
+}
+
+template<typename T> static SIMD_TARGET("avx2")
+    size_t read_32bpp_avx2(
+        const u8 *input_ptr, Pixel *output_ptr, const size_t count)
+{
+    const auto blocks = count / 8;
+    for (size_t i = 0; i < blocks; i++)
+    {
+        auto v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(input_ptr) + i);
+        if (T::swap_rb)
+        {
+            v = _mm256_or_si256(
+                _mm256_and_si256(v, _mm256_set1_epi32(0xFF00FF00)),
+                _mm256_or_si256(
+                    _mm256_and_si256(
+                        _mm256_srli_epi32(v, 16), _mm256_set1_epi32(0xFF)),
+                    _mm256_and_si256(
+                        _mm256_slli_epi32(v, 16),
+                        _mm256_set1_epi32(0xFF0000))));
+        }
+        if (T::or_mask)
+            v = _mm256_or_si256(v, _mm256_set1_epi32(T::or_mask));
+        if (T::xor_mask)
+            v = _mm256_xor_si256(v, _mm256_set1_epi32(T::xor_mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output_ptr) + i, v);
+    }
+    return blocks * 8;
+}
+
+static SIMD_TARGET("avx2") size_t read_gray8_avx2(
+    const u8 *input_ptr, Pixel *output_ptr, const size_t count)
+{
+    const auto blocks = count / 8;
+    const auto spread = _mm256_set1_epi32(0x010101);
+    const auto opaque = _mm256_set1_epi32(0xFF000000);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+            reinterpret_cast<const __m128i*>(input_ptr + i * 8)));
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(output_ptr) + i,
+            _mm256_or_si256(_mm256_mullo_epi32(v, spread), opaque));
+    }
+    return blocks * 8;
+}
+
+#endif
+
+#if SIMD_NEON
+
+static size_t read_gray8_neon(
+    const u8 *input_ptr, Pixel *output_ptr, const size_t count)
+{
+    const auto blocks = count / 16;
+    auto target = reinterpret_cast<u8*>(output_ptr);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto v = vld1q_u8(input_ptr + i * 16);
+        uint8x16x4_t pixels;
+        pixels.val[0] = v;
+        pixels.val[1] = v;
+        pixels.val[2] = v;
+        pixels.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(target + i * 64, pixels);
+    }
+    return blocks * 16;
+}
+
+template<bool swap_rb> static size_t read_24bpp_neon(
+    const u8 *input_ptr, Pixel *output_ptr, const size_t count)
+{
+    const auto blocks = count / 16;
+    auto target = reinterpret_cast<u8*>(output_ptr);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto v = vld3q_u8(input_ptr + i * 48);
+        uint8x16x4_t pixels;
+        pixels.val[0] = v.val[swap_rb ? 2 : 0];
+        pixels.val[1] = v.val[1];
+        pixels.val[2] = v.val[swap_rb ? 0 : 2];
+        pixels.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(target + i * 64, pixels);
+    }
+    return blocks * 16;
+}
+
+template<typename T> static size_t read_32bpp_neon(
+    const u8 *input_ptr, Pixel *output_ptr, const size_t count)
+{
+    const auto blocks = count / 16;
+    auto target = reinterpret_cast<u8*>(output_ptr);
+    for (size_t i = 0; i < blocks; i++)
+    {
+        const auto v = vld4q_u8(input_ptr + i * 64);
+        uint8x16x4_t pixels;
+        pixels.val[0] = v.val[T::swap_rb ? 2 : 0];
+        pixels.val[1] = v.val[1];
+        pixels.val[2] = v.val[T::swap_rb ? 0 : 2];
+        pixels.val[3] = vorrq_u8(
+            veorq_u8(v.val[3], vdupq_n_u8(T::xor_mask >> 24)),
+            vdupq_n_u8(T::or_mask >> 24));
+        vst4q_u8(target + i * 64, pixels);
+    }
+    return blocks * 16;
+}
+
+#endif
+
+PixelKernel res::get_pixel_kernel(
+    const PixelFormat fmt, const algo::SimdLevel level)
+{
+    using PF = PixelFormat;
+    using SL = algo::SimdLevel;
+    #if SIMD_X86
+        if (level == SL::Sse2)
+        {
+            switch (fmt)
+            {
+                case PF::Gray8:     return read_gray8_sse2;
+                case PF::BGR555X:   return read_16bpp_sse2<Bgr555X>;
+                case PF::BGR565:    return read_16bpp_sse2<Bgr565>;
+                case PF::BGR888X:   return read_32bpp_sse2<Bgr888X>;
+                case PF::BGRA4444:  return read_16bpp_sse2<Bgra4444>;
+                case PF::BGRA5551:  return read_16bpp_sse2<Bgra5551>;
+                case PF::BGRnA4444: return read_16bpp_sse2<BgrnA4444>;
+                case PF::BGRnA5551: return read_16bpp_sse2<BgrnA5551>;
+                case PF::BGRnA8888: return read_32bpp_sse2<BgrnA8888>;
+                case PF::RGB555X:   return read_16bpp_sse2<SwapRb<Bgr555X>>;
+                case PF::RGB565:    return read_16bpp_sse2<SwapRb<Bgr565>>;
+                case PF::RGB888X:   return read_32bpp_sse2<Rgb888X>;
+                case PF::RGBA4444:  return read_16bpp_sse2<SwapRb<Bgra4444>>;
+                case PF::RGBA5551:  return read_16bpp_sse2<SwapRb<Bgra5551>>;
+                case PF::RGBA8888:  return read_32bpp_sse2<Rgba8888>;
+                case PF::RGBnA4444: return read_16bpp_sse2<SwapRb<BgrnA4444>>;
+                case PF::RGBnA5551: return read_16bpp_sse2<SwapRb<BgrnA5551>>;
+                case PF::RGBnA8888: return read_32bpp_sse2<RgbnA8888>;
+                default: return nullptr;
+            }
+        }
+        if (level == SL::Ssse3)
+        {
+            switch (fmt)
+            {
+                case PF::BGR888: return read_24bpp_ssse3<false>;
+                case PF::RGB888: return read_24bpp_ssse3<true>;
+                default: return nullptr;
+            }
+        }
+        if (level == SL::Avx2)
+        {
+            switch (fmt)
+            {
+                case PF::Gray8:     return read_gray8_avx2;
+                case PF::BGR555X:   return read_16bpp_avx2<Bgr555X>;
+                case PF::BGR565:    return read_16bpp_avx2<Bgr565>;
+                case PF::BGR888X:   return read_32bpp_avx2<Bgr888X>;
+                case PF::BGRA4444:  return read_16bpp_avx2<Bgra4444>;
+                case PF::BGRA5551:  return read_16bpp_avx2<Bgra5551>;
+                case PF::BGRnA4444: return read_16bpp_avx2<BgrnA4444>;
+                case PF::BGRnA5551: return read_16bpp_avx2<BgrnA5551>;
+                case PF::BGRnA8888: return read_32bpp_avx2<BgrnA8888>;
+                case PF::RGB555X:   return read_16bpp_avx2<SwapRb<Bgr555X>>;
+                case PF::RGB565:    return read_16bpp_avx2<SwapRb<Bgr565>>;
+                case PF::RGB888X:   return read_32bpp_avx2<Rgb888X>;
+                case PF::RGBA4444:  return read_16bpp_avx2<SwapRb<Bgra4444>>;
+                case PF::RGBA5551:  return read_16bpp_avx2<SwapRb<Bgra5551>>;
+                case PF::RGBA8888:  return read_32bpp_avx2<Rgba8888>;
+                case PF::RGBnA4444: return read_16bpp_avx2<SwapRb<BgrnA4444>>;
+                case PF::RGBnA5551: return read_16bpp_avx2<SwapRb<BgrnA5551>>;
+                case PF::RGBnA8888: return read_32bpp_avx2<RgbnA8888>;
+                default: return nullptr;
+            }
+        }
+    #endif
+    #if SIMD_NEON
+        if (level == SL::Neon)
+        {
+            switch (fmt)
+            {
+                case PF::Gray8:     return read_gray8_neon;
+                case PF::BGR888:    return read_24bpp_neon<false>;
+                case PF::BGR888X:   return read_32bpp_neon<Bgr888X>;
+                case PF::BGRnA8888: return read_32bpp_neon<BgrnA8888>;
+                case PF::RGB888:    return read_24bpp_neon<true>;
+                case PF::RGB888X:   return read_32bpp_neon<Rgb888X>;
+                case PF::RGBA8888:  return read_32bpp_neon<Rgba8888>;
+                case PF::RGBnA8888: return read_32bpp_neon<RgbnA8888>;
+                default: return nullptr;
+            }
+        }
+    #endif
+    return nullptr;
+}
@@ -0,0 +1,44 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include "algo/cpu_features.h"
+#include "res/pixel_format.h"
+
+namespace au {
+namespace res {
+
+    // Converts the leading pixels of a row in whole vector blocks and
+    // returns how many it converted. The rest is left to the scalar path.
+    using PixelKernel = size_t (*)(
+        const u8 *input_ptr, Pixel *output_ptr, const size_t count);
+
+    // Returns nullptr if there's no kernel for the given format written
+    // with exactly the given instruction set.
+    PixelKernel get_pixel_kernel(
+        const PixelFormat fmt, const algo::SimdLevel level);
+
+    // Like read_pixels, but limited to the given instruction set.
+    void read_pixels(
+        const u8 *input_ptr,
+        Pixel *output_ptr,
+        const size_t count,
+        const PixelFormat fmt,
+        const algo::SimdLevel level);
+
+} }
@@ -16,122 +16,205 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "virtual_file_system.h"
+#include <array>
 #include <map>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 #include "algo/str.h"
 #include "err.h"
 #include "io/file_system.h"
 
 using namespace au;
 
-static std::mutex mutex;
-static std::map<io::path, std::function<std::unique_ptr<io::File>()>> factories;
-static std::set<io::path> directories;
+namespace
+{
+    using FileFactory = std::function<std::unique_ptr<io::File>()>;
+
+    enum class Key : u8
+    {
+        Stem = 0,
+        Name = 1,
+        Path = 2,
+    };
+
+    // Lowercase stems, names and paths of all files within a registered
+    // directory. Walking big game directories is expensive, so this is done
+    // once, on the first lookup that needs it.
+    class DirectoryIndex final
+    {
+    public:
+        DirectoryIndex(const io::path &path);
+        const io::path *find(const Key key, const std::string &value);
+
+    private:
+        void build();
+
+        const io::path path;
+        std::once_flag build_flag;
+        std::array<std::unordered_map<std::string, io::path>, 3> paths;
+    };
+}
+
+static std::shared_timed_mutex mutex;
+static std::map<io::path, FileFactory> factories;
+static std::array<std::unordered_map<std::string, std::set<io::path>>, 2>
+    factory_index;
+static std::map<io::path, std::shared_ptr<DirectoryIndex>> directories;
 static bool enabled = true;
 
+static std::string get_key(const io::path &path, const Key key)
+{
+    if (key == Key::Stem)
+        return algo::lower(path.stem());
+    if (key == Key::Name)
+        return algo::lower(path.name());
+    return io::path(algo::lower(path.str())).str();
+}
+
+DirectoryIndex::DirectoryIndex(const io::path &path) : path(path)
+{
+}
+
+void DirectoryIndex::build()
+{
+    for (const auto &other_path : io::recursive_directory_range(path))
+    for (const auto key : {Key::Stem, Key::Name, Key::Path})
+    {
+        // the first match wins, like in a plain directory walk
+        paths[static_cast<size_t>(key)].emplace(
+            get_key(other_path, key), other_path);
+    }
+}
+
+const io::path *DirectoryIndex::find(const Key key, const std::string &value)
+{
+    std::call_once(build_flag, [&]() { build(); });
+    const auto &key_paths = paths[static_cast<size_t>(key)];
+    const auto it = key_paths.find(value);
+    return it == key_paths.end() ? nullptr : &it->second;
+}
+
+static std::unique_ptr<io::File> get(const Key key, const std::string &check)
+{
+    FileFactory factory;
+    std::vector<std::shared_ptr<DirectoryIndex>> directory_indexes;
+
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex);
+        if (!enabled)
+            return nullptr;
+
+        if (key == Key::Path)
+        {
+            const auto it = factories.find(io::path(check));
+            if (it != factories.end())
+                factory = it->second;
+        }
+        else
+        {
+            const auto &index = factory_index[static_cast<size_t>(key)];
+            const auto it = index.find(check);
+            if (it != index.end())
+                factory = factories.at(*it->second.begin());
+        }
+
+        if (!factory)
+            for (const auto &kv : directories)
+                directory_indexes.push_back(kv.second);
+    }
+
+    if (factory)
+        return factory();
+
+    for (const auto &directory_index : directory_indexes)
+        if (const auto other_path = directory_index->find(key, check))
+            return std::make_unique<io::File>(*other_path, io::FileMode::Read);
+
+    return nullptr;
+}
+
 void VirtualFileSystem::disable()
 {
-    std::unique_lock<std::mutex> lock(mutex);
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
     enabled = false;
 }
 
 void VirtualFileSystem::enable()
 {
-    std::unique_lock<std::mutex> lock(mutex);
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
     enabled = true;
 }
 
 void VirtualFileSystem::clear()
 {
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
     directories.clear();
     factories.clear();
+    for (auto &index : factory_index)
+        index.clear();
 }
 
 void VirtualFileSystem::register_file(
     const io::path &path,
     const std::function<std::unique_ptr<io::File>()> factory)
 {
-    std::unique_lock<std::mutex> lock(mutex);
-    if (enabled)
-        factories[io::path(algo::lower(path.str()))] = factory;
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
+    if (!enabled)
+        return;
+    const auto key = io::path(get_key(path, Key::Path));
+    factories[key] = factory;
+    for (const auto index_key : {Key::Stem, Key::Name})
+    {
+        auto &index = factory_index[static_cast<size_t>(index_key)];
+        index[get_key(key, index_key)].insert(key);
+    }
 }
 
 void VirtualFileSystem::unregister_file(const io::path &path)
 {
-    std::unique_lock<std::mutex> lock(mutex);
-    factories.erase(io::path(algo::lower(path.str())));
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
+    const auto key = io::path(get_key(path, Key::Path));
+    if (!factories.erase(key))
+        return;
+    for (const auto index_key : {Key::Stem, Key::Name})
+    {
+        auto &index = factory_index[static_cast<size_t>(index_key)];
+        const auto it = index.find(get_key(key, index_key));
+        it->second.erase(key);
+        if (it->second.empty())
+            index.erase(it);
+    }
 }
 
 void VirtualFileSystem::register_directory(const io::path &path)
 {
-    std::unique_lock<std::mutex> lock(mutex);
-    if (enabled)
-        directories.insert(path);
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
+    if (enabled && directories.find(path) == directories.end())
+        directories[path] = std::make_shared<DirectoryIndex>(path);
 }
 
 void VirtualFileSystem::unregister_directory(const io::path &path)
 {
-    std::unique_lock<std::mutex> lock(mutex);
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
     directories.erase(path);
 }
 
 std::unique_ptr<io::File> VirtualFileSystem::get_by_stem(
     const std::string &stem)
 {
-    std::unique_lock<std::mutex> lock(mutex);
-    if (!enabled)
-        return nullptr;
-
-    const auto check = algo::lower(stem);
-    for (const auto &kv : factories)
-        if (kv.first.stem() == check)
-            return kv.second();
-
-    for (const auto &directory : directories)
-    for (const auto &other_path : io::recursive_directory_range(directory))
-        if (algo::lower(other_path.stem()) == check)
-            return std::make_unique<io::File>(other_path, io::FileMode::Read);
-
-    return nullptr;
+    return get(Key::Stem, algo::lower(stem));
 }
 
 std::unique_ptr<io::File> VirtualFileSystem::get_by_name(
     const std::string &name)
 {
-    std::unique_lock<std::mutex> lock(mutex);
-    if (!enabled)
-        return nullptr;
-
-    const auto check = algo::lower(name);
-    for (const auto &kv : factories)
-        if (kv.first.name() == check)
-            return kv.second();
-
-    for (const auto &directory : directories)
-    for (const auto &other_path : io::recursive_directory_range(directory))
-        if (algo::lower(other_path.name()) == check)
-            return std::make_unique<io::File>(other_path, io::FileMode::Read);
-
-    return nullptr;
+    return get(Key::Name, algo::lower(name));
 }
 
 std::unique_ptr<io::File> VirtualFileSystem::get_by_path(const io::path &path)
 {
-    std::unique_lock<std::mutex> lock(mutex);
-    if (!enabled)
-        return nullptr;
-
-    const auto check = io::path(algo::lower(path.str()));
-    if (factories.find(check) != factories.end())
-        return factories[check]();
-
-    for (const auto &directory : directories)
-    for (const auto &other_path : io::recursive_directory_range(directory))
-    {
-        if (io::path(algo::lower(other_path.str())) == check)
-            return std::make_unique<io::File>(other_path, io::FileMode::Read);
-    }
-
-    return nullptr;
+    return get(Key::Path, get_key(path, Key::Path));
 }
@@ -0,0 +1,261 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "algo/pack/huffman_table.h"
+#include "algo/pack/huffman.h"
+#include "algo/range.h"
+#include "io/lsb_bit_reader.h"
+#include "io/memory_byte_stream.h"
+#include "io/msb_bit_reader.h"
+#include "io/msb_bit_stream.h"
+#include "test_support/catch.h"
+#include "test_support/common.h"
+
+using namespace au;
+using namespace au::algo::pack;
+
+namespace
+{
+    struct Code final
+    {
+        u32 bits;
+        size_t size;
+    };
+}
+
+// Assigns canonical codes the slow way, for comparison.
+static std::vector<Code> get_canonical_codes(
+    const std::vector<u8> &code_sizes)
+{
+    std::vector<Code> codes(code_sizes.size());
+    u32 code = 0;
+    for (const auto size : algo::range(1, 32))
+    {
+        for (const auto symbol : algo::range(code_sizes.size()))
+        {
+            if (code_sizes[symbol] == size)
+                codes[symbol] = {code++, static_cast<size_t>(size)};
+        }
+        code <<= 1;
+    }
+    return codes;
+}
+
+static bstr encode(
+    const std::vector<Code> &codes,
+    const std::vector<u32> &symbols,
+    const HuffmanBitOrder bit_order)
+{
+    io::MemoryByteStream output_stream;
+    {
+        io::MsbBitStream bit_stream(output_stream);
+        for (const auto symbol : symbols)
+        {
+            const auto &code = codes.at(symbol);
+            for (const auto i : algo::range(code.size))
+                bit_stream.write(1, code.bits >> (code.size - 1 - i));
+        }
+        bit_stream.write(7, 0);
+    }
+    auto output = output_stream.seek(0).read_to_eof();
+    if (bit_order == HuffmanBitOrder::LsbFirst)
+    {
+        for (auto &c : output)
+        {
+            u8 reversed = 0;
+            for (const auto i : algo::range(8))
+                reversed |= ((c >> i) & 1) << (7 - i);
+            c = reversed;
+        }
+    }
+    return output;
+}
+
+template<typename T> static std::vector<u32> decode(
+    const HuffmanTable &table, const bstr &input, const size_t count)
+{
+    T reader(input);
+    std::vector<u32> symbols;
+    for (const auto i : algo::range(count))
+        symbols.push_back(table.decode(reader));
+    return symbols;
+}
+
+static void test_code_sizes(
+    const std::vector<u8> &code_sizes,
+    const size_t max_lookup_bits,
+    const size_t symbol_count)
+{
+    const auto codes = get_canonical_codes(code_sizes);
+    std::vector<u32> used_symbols;
+    for (const auto symbol : algo::range(code_sizes.size()))
+        if (code_sizes[symbol])
+            used_symbols.push_back(symbol);
+    std::vector<u32> symbols;
+    for (const auto i : algo::range(symbol_count))
+        symbols.push_back(used_symbols[rand() % used_symbols.size()]);
+
+    INFO("Lookup bits: " << max_lookup_bits);
+    for (const auto bit_order :
+        {HuffmanBitOrder::MsbFirst, HuffmanBitOrder::LsbFirst})
+    {
+        const auto table = HuffmanTable::from_code_sizes(
+            code_sizes, bit_order, max_lookup_bits);
+        const auto input = encode(codes, symbols, bit_order);
+        const auto actual = bit_order == HuffmanBitOrder::MsbFirst
+            ? decode<io::MsbBitReader>(table, input, symbols.size())
+            : decode<io::LsbBitReader>(table, input, symbols.size());
+        REQUIRE(actual == symbols);
+    }
+}
+
+TEST_CASE("Huffman tables", "[algo][pack]")
+{
+    SECTION("Canonical codes")
+    {
+        // B=0, A=10, C=110, D=111
+        const std::vector<u8> code_sizes = {2, 1, 3, 3};
+        const auto table = HuffmanTable::from_code_sizes(
+            code_sizes, HuffmanBitOrder::MsbFirst);
+        const auto input = "\x5B\x80"_b; // 0 10 110 111 0
+        io::MsbBitReader reader(input);
+        REQUIRE(table.decode(reader) == 1);
+        REQUIRE(table.decode(reader) == 0);
+        REQUIRE(table.decode(reader) == 2);
+        REQUIRE(table.decode(reader) == 3);
+        REQUIRE(table.decode(reader) == 1);
+        REQUIRE(reader.pos() == 10);
+    }
+
+    SECTION("LSB first codes")
+    {
+        const std::vector<u8> code_sizes = {2, 1, 3, 3};
+        const auto table = HuffmanTable::from_code_sizes(
+            code_sizes, HuffmanBitOrder::LsbFirst);
+        const auto input = "\xDA\x01"_b; // 0 10 110 111 0, from bit 0
+        io::LsbBitReader reader(input);
+        REQUIRE(table.decode(reader) == 1);
+        REQUIRE(table.decode(reader) == 0);
+        REQUIRE(table.decode(reader) == 2);
+        REQUIRE(table.decode(reader) == 3);
+        REQUIRE(table.decode(reader) == 1);
+    }
+
+    SECTION("Codes longer than the lookup table")
+    {
+        std::vector<u8> code_sizes;
+        for (const auto i : algo::range(1, 20))
+            code_sizes.push_back(i);
+        code_sizes.push_back(19);
+        for (const auto lookup_bits : algo::range(1, 12))
+            test_code_sizes(code_sizes, lookup_bits, 1000);
+    }
+
+    SECTION("Random codes")
+    {
+        for (const auto i : algo::range(20))
+        {
+            // split the code space randomly until it's full
+            std::vector<u8> code_sizes = {1, 1};
+            for (const auto j : algo::range(rand() % 200))
+            {
+                const auto symbol = rand() % code_sizes.size();
+                if (code_sizes[symbol] >= 16)
+                    continue;
+                code_sizes[symbol]++;
+                code_sizes.push_back(code_sizes[symbol]);
+            }
+            test_code_sizes(code_sizes, rand() % 12 + 1, 1000);
+        }
+    }
+
+    SECTION("Single symbol trees")
+    {
+        const HuffmanTable table(
+            {}, 5 | HuffmanTable::leaf_flag, HuffmanBitOrder::MsbFirst);
+        const auto input = "\xFF"_b;
+        io::MsbBitReader reader(input);
+        REQUIRE(table.decode(reader) == 5);
+        REQUIRE(reader.pos() == 0);
+    }
+
+    SECTION("Incomplete codes")
+    {
+        const std::vector<u8> code_sizes = {1, 2};
+        const auto table = HuffmanTable::from_code_sizes(
+            code_sizes, HuffmanBitOrder::MsbFirst);
+        const auto input = "\x58"_b; // 0 10 11
+        io::MsbBitReader reader(input);
+        REQUIRE(table.decode(reader) == 0);
+        REQUIRE(table.decode(reader) == 1);
+        REQUIRE_THROWS_AS(table.decode(reader), err::CorruptDataError);
+    }
+
+    SECTION("Oversubscribed codes")
+    {
+        const std::vector<u8> code_sizes = {1, 1, 1};
+        REQUIRE_THROWS_AS(
+            HuffmanTable::from_code_sizes(
+                code_sizes, HuffmanBitOrder::MsbFirst),
+            err::CorruptDataError);
+    }
+
+    SECTION("Running out of input")
+    {
+        const std::vector<u8> code_sizes = {1, 2, 2};
+        const auto table = HuffmanTable::from_code_sizes(
+            code_sizes, HuffmanBitOrder::MsbFirst);
+        const auto input = "\x01"_b; // 0000000 1
+        io::MsbBitReader reader(input);
+        reader.consume(7);
+        REQUIRE_THROWS_AS(table.decode(reader), err::EofError);
+        REQUIRE(reader.pos() == 7);
+    }
+}
+
+TEST_CASE("Huffman trees", "[algo][pack]")
+{
+    // tree: (a, (b, c)), then data: a b c a
+    io::MemoryByteStream output_stream;
+    {
+        io::MsbBitStream bit_stream(output_stream);
+        bit_stream.write(1, 1);
+        bit_stream.write(1, 0);
+        bit_stream.write(8, 'a');
+        bit_stream.write(1, 1);
+        bit_stream.write(1, 0);
+        bit_stream.write(8, 'b');
+        bit_stream.write(1, 0);
+        bit_stream.write(8, 'c');
+        bit_stream.write(6, 0b010110);
+    }
+    const auto input = output_stream.seek(0).read_to_eof();
+
+    SECTION("Decoding up to target size")
+    {
+        io::MsbBitReader reader(input);
+        const HuffmanTree tree(reader);
+        tests::compare_binary(decode_huffman(tree, reader, 4), "abca"_b);
+    }
+
+    SECTION("Stopping at the end of input")
+    {
+        io::MsbBitReader reader(input);
+        const HuffmanTree tree(reader);
+        REQUIRE(decode_huffman(tree, reader, 100).size() >= 4);
+    }
+}
@@ -16,6 +16,8 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "algo/pack/lzss.h"
+#include "algo/format.h"
+#include "algo/pack/lzss_engine.h"
 #include "algo/range.h"
 #include "test_support/catch.h"
 #include "test_support/common.h"
@@ -45,6 +47,90 @@ static void test_bytes(const bstr &input, size_t size)
     test_bytes(input, bstr(size, 'a'));
 }
 
+// Straightforward byte-by-byte decoding, for comparison.
+static bstr reference_decompress(
+    const bstr &input, const size_t output_size, const size_t initial_pos)
+{
+    u8 dict[0x1000] = {0};
+    size_t dict_pos = initial_pos;
+    bstr output(output_size);
+    size_t output_pos = 0, input_pos = 0;
+    u16 control = 0;
+    while (output_pos < output_size)
+    {
+        control >>= 1;
+        if (!(control & 0x100))
+        {
+            if (input_pos >= input.size()) break;
+            control = input[input_pos++] | 0xFF00;
+        }
+        if (control & 1)
+        {
+            if (input_pos >= input.size()) break;
+            const u8 b = input[input_pos++];
+            output[output_pos++] = b;
+            dict[dict_pos++ & 0xFFF] = b;
+        }
+        else
+        {
+            if (input_pos + 2 > input.size()) break;
+            const u8 lo = input[input_pos++];
+            const u8 hi = input[input_pos++];
+            size_t look_behind_pos = lo | ((hi & 0xF0) << 4);
+            auto repetitions = (hi & 0xF) + 3;
+            while (repetitions-- && output_pos < output_size)
+            {
+                const auto b = dict[look_behind_pos++ & 0xFFF];
+                output[output_pos++] = b;
+                dict[dict_pos++ & 0xFFF] = b;
+            }
+        }
+    }
+    return output;
+}
+
+TEST_CASE("LZSS window", "[algo][pack]")
+{
+    SECTION("Copies match byte-by-byte copies")
+    {
+        for (const auto i : algo::range(1000))
+        {
+            const size_t size = 1 << (rand() % 6 + 1);
+            const size_t initial_pos = rand() % size;
+            LzssWindow window(size, initial_pos);
+            std::vector<u8> expected_window(size);
+            for (const auto j : algo::range(size))
+                expected_window[j] = window.data()[j] = rand();
+
+            size_t expected_pos = initial_pos;
+            for (const auto j : algo::range(10))
+            {
+                const auto source_pos = rand() % (size * 2);
+                const auto match_size = rand() % (size + 4);
+                const auto output_size = rand() % (match_size + 2);
+                bstr expected(output_size), actual(output_size);
+                size_t n = 0;
+                for (auto src = source_pos; n < std::min<size_t>(
+                    match_size, output_size); n++, src++)
+                {
+                    const auto c = expected_window[src % size];
+                    expected[n] = c;
+                    expected_window[expected_pos++ % size] = c;
+                }
+                REQUIRE(window.copy(
+                        source_pos,
+                        match_size,
+                        actual.get<u8>(),
+                        actual.end<const u8>())
+                    == n);
+                tests::compare_binary(actual, expected);
+                for (const auto k : algo::range(size))
+                    REQUIRE(window.data()[k] == expected_window[k]);
+            }
+        }
+    }
+}
+
 TEST_CASE("LZSS unpacking", "[algo][pack]")
 {
     SECTION("Bitwise")
@@ -106,6 +192,20 @@ TEST_CASE("LZSS unpacking", "[algo][pack]")
         test_bytes("\x07\x61\x61\x61\xEE\xF0\xEE\xF3\xEE\xF9\xEE\xFC'"_b, 39);
         test_bytes("\x07\x61\x61\x61\xEE\xF0\xEE\xF3\xEE\xF9\xEE\xFD'"_b, 40);
     }
+
+    SECTION("Bytewise, random input")
+    {
+        for (const auto i : algo::range(100))
+        {
+            bstr input(rand() % 2000);
+            for (auto &c : input)
+                c = rand();
+            const auto output_size = rand() % 5000;
+            tests::compare_binary(
+                lzss_decompress(input, output_size),
+                reference_decompress(input, output_size, 0xFEE));
+        }
+    }
 }
 
 TEST_CASE("LZSS packing", "[algo][pack]")
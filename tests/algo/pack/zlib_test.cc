@@ -16,6 +16,7 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "algo/pack/zlib.h"
+#include "algo/range.h"
 #include "io/memory_byte_stream.h"
 #include "test_support/catch.h"
 #include "test_support/common.h"
@@ -43,6 +44,46 @@ TEST_CASE("ZLIB compression", "[algo][pack]")
         REQUIRE(input_stream.left() == 0);
     }
 
+    SECTION("Inflating ZLIB with known size")
+    {
+        tests::compare_binary(zlib_inflate(input, output.size()), output);
+    }
+
+    SECTION("Inflating ZLIB with inaccurate size")
+    {
+        tests::compare_binary(zlib_inflate(input, 1), output);
+        tests::compare_binary(zlib_inflate(input, 1000), output);
+    }
+
+    SECTION("Inflating ZLIB from stream with known size")
+    {
+        io::MemoryByteStream input_stream(input + "trailing data"_b);
+        tests::compare_binary(
+            zlib_inflate(input_stream, output.size()), output);
+        REQUIRE(input_stream.pos() == input.size());
+    }
+
+    SECTION("Inflating ZLIB into preallocated buffer")
+    {
+        bstr target(output.size() + 5);
+        const auto written = zlib_inflate(
+            input.get<u8>(), input.size(), target.get<u8>(), target.size());
+        REQUIRE(written == output.size());
+        tests::compare_binary(target.substr(0, written), output);
+    }
+
+    SECTION("Inflating ZLIB into too small buffer")
+    {
+        bstr target(output.size() - 1);
+        REQUIRE_THROWS(zlib_inflate(
+            input.get<u8>(), input.size(), target.get<u8>(), target.size()));
+    }
+
+    SECTION("Inflating truncated ZLIB")
+    {
+        REQUIRE_THROWS(zlib_inflate(input.substr(0, input.size() - 3)));
+    }
+
     SECTION("Deflating ZLIB from bstr")
     {
         tests::compare_binary(zlib_inflate(zlib_deflate(output)), output);
@@ -55,3 +96,28 @@ TEST_CASE("ZLIB compression", "[algo][pack]")
         tests::compare_binary(inflated, output);
     }
 }
+
+TEST_CASE("ZLIB compression of large data", "[algo][pack]")
+{
+    bstr output(1024 * 1024);
+    for (const auto i : algo::range(output.size()))
+        output[i] = (i * i) >> 7;
+    const auto input = zlib_deflate(output);
+
+    SECTION("Unknown size")
+    {
+        tests::compare_binary(zlib_inflate(input), output);
+    }
+
+    SECTION("Known size")
+    {
+        tests::compare_binary(zlib_inflate(input, output.size()), output);
+    }
+
+    SECTION("Stream")
+    {
+        io::MemoryByteStream input_stream(input);
+        tests::compare_binary(zlib_inflate(input_stream), output);
+        REQUIRE(input_stream.left() == 0);
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "algo/parallel.h"
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "err.h"
+#include "test_support/catch.h"
+
+using namespace au;
+
+namespace
+{
+    // Restores the default limit even when an assertion fails midway.
+    class ThreadLimitGuard final
+    {
+    public:
+        ThreadLimitGuard(const size_t thread_limit)
+        {
+            algo::set_thread_limit(thread_limit);
+        }
+
+        ~ThreadLimitGuard()
+        {
+            algo::set_thread_limit(0);
+        }
+    };
+}
+
+TEST_CASE("Running tasks in parallel", "[algo]")
+{
+    SECTION("Every task runs exactly once")
+    {
+        std::vector<std::atomic<int>> counters(100);
+        for (auto &counter : counters)
+            counter = 0;
+        algo::run_in_parallel(counters.size(), 4, [&](const size_t i)
+        {
+            ++counters[i];
+        });
+        for (const auto &counter : counters)
+            REQUIRE(counter.load() == 1);
+    }
+
+    SECTION("Errors are rethrown in the calling thread")
+    {
+        std::atomic<int> run_count(0);
+        REQUIRE_THROWS_AS(
+            algo::run_in_parallel(10, 4, [&](const size_t i)
+            {
+                ++run_count;
+                if (i == 5)
+                    throw err::CorruptDataError("test");
+            }),
+            err::CorruptDataError);
+        REQUIRE(run_count.load() == 10);
+    }
+
+    SECTION("Busy threads count against the thread limit")
+    {
+        std::set<std::thread::id> thread_ids;
+        std::mutex mutex;
+        {
+            const ThreadLimitGuard thread_limit_guard(1);
+            const algo::BusyThreadScope busy_scope;
+            algo::run_in_parallel(16, 0, [&](const size_t)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                thread_ids.insert(std::this_thread::get_id());
+            });
+        }
+        REQUIRE(thread_ids.size() == 1);
+        REQUIRE(*thread_ids.begin() == std::this_thread::get_id());
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+// Replaces the global allocation functions so that the benchmarks can count
+// allocations. Kept in its own translation unit so that the compiler can't
+// pair the inlined malloc() calls with the delete expressions elsewhere.
+
+#include "bench/allocation_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace au;
+
+static std::atomic<u64> allocation_count(0);
+
+u64 bench::get_allocation_count()
+{
+    return allocation_count.load();
+}
+
+void *operator new(std::size_t size)
+{
+    ++allocation_count;
+    if (auto ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
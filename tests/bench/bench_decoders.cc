@@ -0,0 +1,436 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+// Measures decoder throughput over the fixture corpus in tests/dec/.
+//
+// Every decoder whose fixture directory exists gets its recognized fixtures
+// decoded through the same helpers the unit tests use. Small inputs are
+// replicated until enough data went through the decoder to make timings
+// stable. Results are written as JSON and can be compared against a saved
+// baseline to spot regressions.
+//
+// The other files in this directory add micro benchmarks of single
+// components, which only print their timings. --test runs a subset.
+
+#define CATCH_CONFIG_RUNNER
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include "algo/format.h"
+#include "algo/range.h"
+#include "algo/str.h"
+#include "arg_parser.h"
+#include "bench/allocation_counter.h"
+#include "dec/idecoder_visitor.h"
+#include "dec/registry.h"
+#include "entry_point.h"
+#include "err.h"
+#include "io/file_system.h"
+#include "io/program_path.h"
+#include "test_support/catch.h"
+#include "test_support/decoder_support.h"
+#include "virtual_file_system.h"
+
+using namespace au;
+
+namespace
+{
+    struct Options final
+    {
+        std::string decoder;
+        std::string test_spec;
+        size_t iterations = 3;
+        size_t min_bytes = 1024 * 1024;
+        double max_seconds = 0.25;
+        io::path output_path = "bench_decoders.json";
+        io::path baseline_path;
+        double threshold = 10.0;
+    };
+
+    struct Result final
+    {
+        std::string decoder;
+        size_t file_count;
+        size_t run_count;
+        size_t error_count;
+        u64 byte_count;
+        double seconds;
+        u64 allocation_count;
+        u64 peak_rss_kb;
+
+        double mb_per_s() const;
+    };
+
+    class DecoderRunner final : public dec::IDecoderVisitor
+    {
+    public:
+        DecoderRunner(io::File &input_file);
+        void visit(const dec::BaseArchiveDecoder &decoder) override;
+        void visit(const dec::BaseFileDecoder &decoder) override;
+        void visit(const dec::BaseImageDecoder &decoder) override;
+        void visit(const dec::BaseAudioDecoder &decoder) override;
+
+    private:
+        io::File &input_file;
+    };
+}
+
+static Options options;
+static std::vector<Result> results;
+
+double Result::mb_per_s() const
+{
+    return seconds > 0 ? byte_count / seconds / 1024.0 / 1024.0 : 0.0;
+}
+
+DecoderRunner::DecoderRunner(io::File &input_file) : input_file(input_file)
+{
+}
+
+void DecoderRunner::visit(const dec::BaseArchiveDecoder &decoder)
+{
+    for (const auto &output_file : tests::unpack(decoder, input_file))
+        if (output_file)
+            output_file->stream.size();
+}
+
+void DecoderRunner::visit(const dec::BaseFileDecoder &decoder)
+{
+    tests::decode(decoder, input_file);
+}
+
+void DecoderRunner::visit(const dec::BaseImageDecoder &decoder)
+{
+    tests::decode(decoder, input_file);
+}
+
+void DecoderRunner::visit(const dec::BaseAudioDecoder &decoder)
+{
+    tests::decode(decoder, input_file);
+}
+
+// Resets the peak resident set size of the process, so that the next
+// reading covers only what happened since. Needs Linux 4.0 or newer.
+static bool reset_peak_rss()
+{
+    #ifdef __linux__
+        std::ofstream output("/proc/self/clear_refs");
+        output << "5";
+        output.flush();
+        return static_cast<bool>(output);
+    #else
+        return false;
+    #endif
+}
+
+static u64 get_peak_rss_kb()
+{
+    std::ifstream input("/proc/self/status");
+    std::string line;
+    while (std::getline(input, line))
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return std::strtoull(line.c_str() + 6, nullptr, 10);
+    return 0;
+}
+
+// "alice-soft/ald" -> "tests/dec/alice_soft/files/ald/"
+static io::path get_fixture_dir(const std::string &decoder_name)
+{
+    auto name = decoder_name;
+    for (auto &c : name)
+        if (c == '-')
+            c = '_';
+    const auto pos = name.find('/');
+    if (pos == std::string::npos)
+        return "";
+    return io::path("tests/dec")
+        / name.substr(0, pos) / "files" / name.substr(pos + 1);
+}
+
+static Result benchmark_decoder(const std::string &decoder_name)
+{
+    Result result {decoder_name, 0, 0, 0, 0, 0.0, 0, 0};
+    const auto fixture_dir = get_fixture_dir(decoder_name);
+    if (fixture_dir.str().empty() || !io::is_directory(fixture_dir))
+        return result;
+
+    // the peak is process-wide, so it only says something about this
+    // decoder if it could be reset first
+    const auto peak_rss_was_reset = reset_peak_rss();
+    VirtualFileSystem::clear();
+    VirtualFileSystem::register_directory(fixture_dir);
+    const auto decoder = dec::Registry::instance().create_decoder(
+        decoder_name);
+    for (const auto &path : io::recursive_directory_range(fixture_dir))
+    {
+        if (!io::is_regular_file(path))
+            continue;
+        const auto data = io::File(path, io::FileMode::Read)
+            .stream.seek(0).read_to_eof();
+        {
+            io::File input_file(path, data);
+            if (!decoder->is_recognized(input_file))
+                continue;
+        }
+
+        ++result.file_count;
+        std::chrono::duration<double> elapsed(0);
+        u64 processed = 0;
+        for (size_t run = 0; ; run++)
+        {
+            if (run >= options.iterations
+                && (processed >= options.min_bytes
+                    || elapsed.count() >= options.max_seconds))
+            {
+                break;
+            }
+
+            io::File input_file(path, data);
+            DecoderRunner runner(input_file);
+            const auto allocations_before = bench::get_allocation_count();
+            const auto begin = std::chrono::steady_clock::now();
+            try
+            {
+                decoder->accept(runner);
+            }
+            catch (const std::exception &e)
+            {
+                std::fprintf(
+                    stderr,
+                    "%s: %s\n",
+                    path.str().c_str(),
+                    e.what());
+                ++result.error_count;
+                break;
+            }
+            elapsed += std::chrono::steady_clock::now() - begin;
+            result.allocation_count
+                += bench::get_allocation_count() - allocations_before;
+            processed += data.size();
+            ++result.run_count;
+        }
+        result.seconds += elapsed.count();
+        result.byte_count += processed;
+    }
+    VirtualFileSystem::clear();
+
+    result.peak_rss_kb = peak_rss_was_reset ? get_peak_rss_kb() : 0;
+    return result;
+}
+
+static std::string format_result(const Result &result)
+{
+    return algo::format(
+        "{\"decoder\": \"%s\", \"files\": %d, \"runs\": %d, "
+        "\"errors\": %d, \"bytes\": %llu, \"seconds\": %.06f, "
+        "\"mb_per_s\": %.03f, \"allocations\": %llu, "
+        "\"peak_rss_kb\": %llu}",
+        result.decoder.c_str(),
+        static_cast<int>(result.file_count),
+        static_cast<int>(result.run_count),
+        static_cast<int>(result.error_count),
+        static_cast<unsigned long long>(result.byte_count),
+        result.seconds,
+        result.mb_per_s(),
+        static_cast<unsigned long long>(result.allocation_count),
+        static_cast<unsigned long long>(result.peak_rss_kb));
+}
+
+static void write_results(const io::path &path)
+{
+    std::ofstream output(path.str());
+    output << "{\"results\": [\n";
+    for (const auto i : algo::range(results.size()))
+        output << (i ? ",\n" : "") << "    " << format_result(results[i]);
+    output << "\n]}\n";
+    if (!output)
+        throw err::IoError("Error writing " + path.str());
+}
+
+// Reads files produced by write_results(); each result lives on its own line.
+static std::map<std::string, double> read_baseline(const io::path &path)
+{
+    std::ifstream input(path.str());
+    if (!input)
+        throw err::IoError("Error reading " + path.str());
+
+    static const std::string decoder_key = "\"decoder\": \"";
+    static const std::string speed_key = "\"mb_per_s\": ";
+    std::map<std::string, double> baseline;
+    std::string line;
+    while (std::getline(input, line))
+    {
+        const auto decoder_pos = line.find(decoder_key);
+        const auto speed_pos = line.find(speed_key);
+        if (decoder_pos == std::string::npos
+            || speed_pos == std::string::npos)
+        {
+            continue;
+        }
+        const auto name_start = decoder_pos + decoder_key.size();
+        const auto name_end = line.find('"', name_start);
+        baseline[line.substr(name_start, name_end - name_start)]
+            = std::atof(line.c_str() + speed_pos + speed_key.size());
+    }
+    return baseline;
+}
+
+static size_t compare_results(const std::map<std::string, double> &baseline)
+{
+    size_t regression_count = 0;
+    for (const auto &result : results)
+    {
+        const auto it = baseline.find(result.decoder);
+        if (it == baseline.end() || it->second <= 0 || !result.run_count)
+            continue;
+        const auto change = (result.mb_per_s() / it->second - 1.0) * 100.0;
+        if (change >= -options.threshold)
+            continue;
+        std::printf(
+            "REGRESSION %-30s %10.03f MB/s -> %10.03f MB/s (%+.01f%%)\n",
+            result.decoder.c_str(),
+            it->second,
+            result.mb_per_s(),
+            change);
+        ++regression_count;
+    }
+    std::printf(
+        "%d regressions over %.01f%% threshold\n",
+        static_cast<int>(regression_count),
+        options.threshold);
+    return regression_count;
+}
+
+TEST_CASE("Decoder throughput", "[benchmark][decoders]")
+{
+    const auto &registry = dec::Registry::instance();
+    for (const auto &name : registry.get_decoder_names())
+    {
+        if (!options.decoder.empty() && options.decoder != name)
+            continue;
+        const auto result = benchmark_decoder(name);
+        if (!result.file_count)
+            continue;
+        std::printf(
+            "%-30s %3d files %6d runs %10.03f MB/s %10llu allocs\n",
+            name.c_str(),
+            static_cast<int>(result.file_count),
+            static_cast<int>(result.run_count),
+            result.mb_per_s(),
+            static_cast<unsigned long long>(result.allocation_count));
+        std::fflush(stdout);
+        results.push_back(result);
+    }
+}
+
+// Returns false if the program should exit right away.
+static bool parse_options(const std::vector<std::string> &arguments)
+{
+    ArgParser arg_parser;
+    arg_parser.register_flag({"-h", "--help"})
+        ->set_description("Shows this message.");
+    arg_parser.register_switch({"--dec"})
+        ->set_value_name("DECODER")
+        ->set_description("Benchmarks only given decoder.");
+    arg_parser.register_switch({"--test"})
+        ->set_value_name("SPEC")
+        ->set_description(
+            "Runs only the benchmarks matching given Catch test spec, "
+            "e.g. [decoders] or \"TaskScheduler scaling\".");
+    arg_parser.register_switch({"--iterations"})
+        ->set_value_name("NUM")
+        ->set_description("Minimum runs per fixture (defaults to 3).");
+    arg_parser.register_switch({"--min-bytes"})
+        ->set_value_name("NUM")
+        ->set_description(
+            "Replicates smaller fixtures until this many bytes were "
+            "decoded (defaults to 1048576).");
+    arg_parser.register_switch({"--out"})
+        ->set_value_name("FILE")
+        ->set_description(
+            "Where to write the JSON results "
+            "(defaults to bench_decoders.json).");
+    arg_parser.register_switch({"--compare"})
+        ->set_value_name("FILE")
+        ->set_description(
+            "Compares the results against a previously saved JSON file.");
+    arg_parser.register_switch({"--threshold"})
+        ->set_value_name("PERCENT")
+        ->set_description(
+            "Slowdown reported as a regression (defaults to 10).");
+    arg_parser.parse(arguments);
+
+    if (arg_parser.has_flag("-h") || arg_parser.has_flag("--help"))
+    {
+        Logger logger;
+        logger.info("Usage: bench_decoders [options]\n\n");
+        arg_parser.print_help(logger);
+        return false;
+    }
+
+    if (arg_parser.has_switch("--dec"))
+        options.decoder = arg_parser.get_switch("--dec");
+    if (arg_parser.has_switch("--test"))
+        options.test_spec = arg_parser.get_switch("--test");
+    if (arg_parser.has_switch("--iterations"))
+        options.iterations = algo::from_string<int>(
+            arg_parser.get_switch("--iterations"));
+    if (arg_parser.has_switch("--min-bytes"))
+        options.min_bytes = algo::from_string<int>(
+            arg_parser.get_switch("--min-bytes"));
+    if (arg_parser.has_switch("--out"))
+        options.output_path = arg_parser.get_switch("--out");
+    if (arg_parser.has_switch("--compare"))
+        options.baseline_path = arg_parser.get_switch("--compare");
+    if (arg_parser.has_switch("--threshold"))
+        options.threshold = std::atof(
+            arg_parser.get_switch("--threshold").c_str());
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    io::set_program_path_from_arg(argv[0]);
+    init_fs_utf8();
+
+    try
+    {
+        if (!parse_options(std::vector<std::string>(argv + 1, argv + argc)))
+            return 0;
+        const char *catch_argv[] = {argv[0], options.test_spec.c_str()};
+        const auto failure_count = Catch::Session().run(
+            options.test_spec.empty() ? 1 : 2, catch_argv);
+        if (failure_count)
+            return 1;
+
+        // runs without the decoder benchmarks keep the saved results
+        if (results.empty())
+            return 0;
+        write_results(options.output_path);
+        if (!options.baseline_path.str().empty())
+            return compare_results(read_baseline(options.baseline_path))
+                ? 1 : 0;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+}
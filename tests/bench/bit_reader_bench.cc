@@ -0,0 +1,71 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdio>
+#include <functional>
+#include "algo/range.h"
+#include "bench/bench_support.h"
+#include "io/memory_byte_stream.h"
+#include "io/msb_bit_reader.h"
+#include "io/msb_bit_stream.h"
+#include "test_support/catch.h"
+
+using namespace au;
+
+template<class T> static double measure_reads(
+    const std::function<T()> &create, const std::vector<size_t> &bit_counts)
+{
+    return bench::measure([&]()
+    {
+        auto reader = create();
+        volatile u32 sink = 0;
+        for (const auto bits : bit_counts)
+            sink = sink + reader->read(bits);
+    });
+}
+
+TEST_CASE("Bit reader throughput", "[benchmark][io]")
+{
+    bstr data(32 * 1024 * 1024);
+    for (auto &c : data)
+        c = rand();
+    std::vector<size_t> bit_counts(data.size() / 4);
+    for (auto &bits : bit_counts)
+        bits = rand() % 33;
+    io::MemoryByteStream input_stream(data);
+
+    const auto stream_time = measure_reads<std::unique_ptr<io::BaseBitStream>>(
+        [&]()
+        {
+            return std::make_unique<io::MsbBitStream>(input_stream);
+        },
+        bit_counts);
+    const auto wrapper_time
+        = measure_reads<std::unique_ptr<io::BaseBitStream>>(
+            [&]() { return std::make_unique<io::MsbBitStream>(data); },
+            bit_counts);
+    const auto reader_time = measure_reads<std::unique_ptr<io::MsbBitReader>>(
+        [&]() { return std::make_unique<io::MsbBitReader>(data); },
+        bit_counts);
+
+    std::printf(
+        "%d reads: %.03fs byte-wise, %.03fs wrapped, %.03fs reader\n",
+        static_cast<int>(bit_counts.size()),
+        stream_time,
+        wrapper_time,
+        reader_time);
+}
@@ -0,0 +1,51 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dec/malie/common/camellia_stream.h"
+#include <algorithm>
+#include <cstdio>
+#include "bench/bench_support.h"
+#include "io/memory_byte_stream.h"
+#include "test_support/catch.h"
+
+using namespace au;
+using namespace au::dec::malie::common;
+
+TEST_CASE("Malie Camellia stream throughput", "[benchmark][dec]")
+{
+    std::vector<u32> key(52);
+    for (auto &k : key)
+        k = rand();
+    bstr input(16 * 1024 * 1024);
+    for (auto &c : input)
+        c = rand();
+    io::MemoryByteStream input_stream(input);
+
+    const auto measure = [&](const char *name, const size_t chunk_size)
+    {
+        CamelliaStream stream(input_stream, key);
+        const auto time = bench::measure([&]()
+        {
+            while (stream.left())
+                stream.read(std::min<size_t>(stream.left(), chunk_size));
+        });
+        std::printf("%s: %.03fs\n", name, time);
+    };
+
+    measure("16 MiB in 4-byte reads", 4);
+    measure("16 MiB in one read", input.size());
+}
@@ -0,0 +1,46 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dec/microsoft/dxt/dxt_decoders.h"
+#include <cstdio>
+#include "bench/bench_support.h"
+#include "io/memory_byte_stream.h"
+#include "test_support/catch.h"
+
+using namespace au;
+using namespace au::dec::microsoft::dxt;
+
+TEST_CASE("BCn texture decoding throughput", "[benchmark][dec]")
+{
+    const size_t width = 4096, height = 4096;
+    const std::vector<std::pair<BcnFormat, std::string>> formats
+        = {{BcnFormat::Bc1, "BC1"}, {BcnFormat::Bc3, "BC3"},
+            {BcnFormat::Bc7, "BC7"}};
+    for (const auto &format : formats)
+    {
+        const auto fmt = format.first;
+        bstr input(get_texture_size(fmt, width, height));
+        for (auto &c : input)
+            c = rand();
+        io::MemoryByteStream input_stream(input);
+        const auto time = bench::measure([&]()
+        {
+            decode_bcn(input_stream, fmt, width, height);
+        });
+        std::printf("%s: %.03fs\n", format.second.c_str(), time);
+    }
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "algo/pack/huffman_table.h"
+#include <cstdio>
+#include "algo/range.h"
+#include "bench/bench_support.h"
+#include "io/memory_byte_stream.h"
+#include "io/msb_bit_reader.h"
+#include "io/msb_bit_stream.h"
+#include "test_support/catch.h"
+
+using namespace au;
+using namespace au::algo::pack;
+
+namespace
+{
+    struct Code final
+    {
+        u32 bits;
+        size_t size;
+    };
+}
+
+static std::vector<Code> get_canonical_codes(
+    const std::vector<u8> &code_sizes)
+{
+    std::vector<Code> codes(code_sizes.size());
+    u32 code = 0;
+    for (const auto size : algo::range(1, 32))
+    {
+        for (const auto symbol : algo::range(code_sizes.size()))
+        {
+            if (code_sizes[symbol] == size)
+                codes[symbol] = {code++, static_cast<size_t>(size)};
+        }
+        code <<= 1;
+    }
+    return codes;
+}
+
+static bstr encode(
+    const std::vector<Code> &codes, const std::vector<u32> &symbols)
+{
+    io::MemoryByteStream output_stream;
+    {
+        io::MsbBitStream bit_stream(output_stream);
+        for (const auto symbol : symbols)
+        {
+            const auto &code = codes.at(symbol);
+            for (const auto i : algo::range(code.size))
+                bit_stream.write(1, code.bits >> (code.size - 1 - i));
+        }
+        bit_stream.write(7, 0);
+    }
+    return output_stream.seek(0).read_to_eof();
+}
+
+TEST_CASE("Huffman table throughput", "[benchmark][algo][pack]")
+{
+    std::vector<u8> code_sizes = {1, 1};
+    while (code_sizes.size() < 256)
+    {
+        const auto symbol = rand() % code_sizes.size();
+        if (code_sizes[symbol] >= 15)
+            continue;
+        code_sizes[symbol]++;
+        code_sizes.push_back(code_sizes[symbol]);
+    }
+    const auto codes = get_canonical_codes(code_sizes);
+    std::vector<u32> symbols;
+    for (const auto i : algo::range(4 * 1024 * 1024))
+        symbols.push_back(rand() % code_sizes.size());
+    const auto input = encode(codes, symbols);
+
+    for (const auto lookup_bits : {1, 9, 10, 12})
+    {
+        const auto table = HuffmanTable::from_code_sizes(
+            code_sizes, HuffmanBitOrder::MsbFirst, lookup_bits);
+        std::vector<u32> actual;
+        actual.reserve(symbols.size());
+        const auto time = bench::measure([&]()
+        {
+            io::MsbBitReader reader(input);
+            for (const auto i : algo::range(symbols.size()))
+                actual.push_back(table.decode(reader));
+        });
+        REQUIRE(actual == symbols);
+        std::printf("%2d lookup bits: %.03fs\n", lookup_bits, time);
+    }
+}
@@ -0,0 +1,65 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "res/image_kernels.h"
+#include <cstdio>
+#include "algo/range.h"
+#include "bench/bench_support.h"
+#include "test_support/catch.h"
+
+using namespace au;
+
+static std::vector<res::Pixel> get_random_pixels(const size_t count)
+{
+    std::vector<res::Pixel> pixels(count);
+    for (auto &c : pixels)
+    {
+        c.b = rand();
+        c.g = rand();
+        c.r = rand();
+        c.a = rand() % 3 ? rand() : 0;
+    }
+    return pixels;
+}
+
+TEST_CASE("Image kernel throughput", "[benchmark][res]")
+{
+    const size_t count = 2048 * 2048;
+    const auto source = get_random_pixels(count);
+    auto target = get_random_pixels(count);
+    std::vector<res::Pixel> table(256);
+
+    for (const auto level : {algo::SimdLevel::None, algo::get_simd_level()})
+    {
+        const auto &kernels = res::get_image_kernels(level);
+        const auto time = bench::measure([&]()
+        {
+            for (const auto i : algo::range(10))
+            {
+                kernels.overlay_non_transparent(
+                    target.data(), source.data(), count);
+                kernels.overlay_add(target.data(), source.data(), count);
+                kernels.apply_mask(target.data(), source.data(), count);
+                kernels.invert(target.data(), count);
+                kernels.reverse(target.data(), count);
+                kernels.apply_palette(
+                    target.data(), count, table.data(), 128);
+            }
+        });
+        std::printf("SIMD level %d: %.03fs\n", static_cast<int>(level), time);
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "algo/pack/lzss.h"
+#include <cstdio>
+#include "algo/format.h"
+#include "algo/range.h"
+#include "bench/bench_support.h"
+#include "test_support/catch.h"
+#include "test_support/common.h"
+
+using namespace au;
+using namespace au::algo::pack;
+
+// Straightforward byte-by-byte decoding, for comparison.
+static bstr reference_decompress(
+    const bstr &input, const size_t output_size, const size_t initial_pos)
+{
+    u8 dict[0x1000] = {0};
+    size_t dict_pos = initial_pos;
+    bstr output(output_size);
+    size_t output_pos = 0, input_pos = 0;
+    u16 control = 0;
+    while (output_pos < output_size)
+    {
+        control >>= 1;
+        if (!(control & 0x100))
+        {
+            if (input_pos >= input.size()) break;
+            control = input[input_pos++] | 0xFF00;
+        }
+        if (control & 1)
+        {
+            if (input_pos >= input.size()) break;
+            const u8 b = input[input_pos++];
+            output[output_pos++] = b;
+            dict[dict_pos++ & 0xFFF] = b;
+        }
+        else
+        {
+            if (input_pos + 2 > input.size()) break;
+            const u8 lo = input[input_pos++];
+            const u8 hi = input[input_pos++];
+            size_t look_behind_pos = lo | ((hi & 0xF0) << 4);
+            auto repetitions = (hi & 0xF) + 3;
+            while (repetitions-- && output_pos < output_size)
+            {
+                const auto b = dict[look_behind_pos++ & 0xFFF];
+                output[output_pos++] = b;
+                dict[dict_pos++ & 0xFFF] = b;
+            }
+        }
+    }
+    return output;
+}
+
+TEST_CASE("LZSS unpacking throughput", "[benchmark][algo][pack]")
+{
+    bstr input;
+    for (const auto i : algo::range(4 * 1024 * 1024 / 36))
+        input += algo::format("%09d %09d %09d %04d ", i * 7, i, i * 3, i % 97);
+    BytewiseLzssSettings settings;
+    const auto compressed = lzss_compress(input, settings);
+
+    for (const auto i : algo::range(2))
+    {
+        bstr actual;
+        const auto time = bench::measure([&]()
+        {
+            actual = i
+                ? lzss_decompress(compressed, input.size(), settings)
+                : reference_decompress(
+                    compressed, input.size(), settings.initial_dictionary_pos);
+        });
+        tests::compare_binary(actual, input);
+        std::printf("%s: %.03fs\n", i ? "window" : "byte loop", time);
+    }
+}
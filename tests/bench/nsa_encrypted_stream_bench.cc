@@ -0,0 +1,53 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dec/nscripter/nsa_encrypted_stream.h"
+#include <algorithm>
+#include <cstdio>
+#include "bench/bench_support.h"
+#include "io/memory_byte_stream.h"
+#include "test_support/catch.h"
+
+using namespace au;
+
+// Decryption does the same work regardless of the content, so the input
+// does not need to be a real encrypted archive.
+TEST_CASE("NScripter NSA encryption throughput", "[benchmark][dec]")
+{
+    const auto key = "weird key"_b;
+    bstr encrypted_input(16 * 1024 * 1024);
+    for (auto &c : encrypted_input)
+        c = rand();
+    io::MemoryByteStream base_stream(encrypted_input);
+
+    const auto measure = [&](const char *name, const size_t chunk_size)
+    {
+        dec::nscripter::NsaEncryptedStream encrypted_stream(base_stream, key);
+        const auto time = bench::measure([&]()
+        {
+            while (encrypted_stream.left())
+            {
+                encrypted_stream.read(
+                    std::min<size_t>(encrypted_stream.left(), chunk_size));
+            }
+        });
+        std::printf("%s: %.03fs\n", name, time);
+    };
+
+    measure("16 MiB in 4-byte reads", 4);
+    measure("16 MiB in one read", encrypted_input.size());
+}
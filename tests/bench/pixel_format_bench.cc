@@ -0,0 +1,53 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "res/pixel_kernels.h"
+#include <cstdio>
+#include "algo/range.h"
+#include "bench/bench_support.h"
+#include "test_support/catch.h"
+
+using namespace au;
+
+TEST_CASE("PixelFormat kernel throughput", "[benchmark][res]")
+{
+    const auto format_count = static_cast<int>(res::PixelFormat::Count);
+    const size_t count = 4096 * 4096;
+    bstr input(4 * count);
+    for (auto &c : input)
+        c = rand();
+    std::vector<res::Pixel> output(count);
+    const auto simd_level = algo::get_simd_level();
+
+    for (const auto i : algo::range(format_count))
+    {
+        const auto fmt = static_cast<res::PixelFormat>(i);
+        for (const auto level : {algo::SimdLevel::None, simd_level})
+        {
+            const auto time = bench::measure([&]()
+            {
+                res::read_pixels(
+                    input.get<u8>(), output.data(), count, fmt, level);
+            });
+            std::printf(
+                "format %2d, SIMD level %d: %.03fs\n",
+                i,
+                static_cast<int>(level),
+                time);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "enc/png/png_image_encoder.h"
+#include <cstdio>
+#include "algo/range.h"
+#include "bench/bench_support.h"
+#include "test_support/catch.h"
+
+using namespace au;
+using namespace au::enc::png;
+
+static res::Image create_big_image(const size_t width, const size_t height)
+{
+    res::Image image(width, height);
+    for (const auto y : algo::range(image.height()))
+    for (const auto x : algo::range(image.width()))
+    {
+        auto &pixel = image.at(x, y);
+        pixel.r = x * y;
+        pixel.g = x + y;
+        pixel.b = (x ^ y) >> 2;
+        pixel.a = y;
+    }
+    return image;
+}
+
+TEST_CASE("PNG images encoding speed", "[benchmark][enc]")
+{
+    Logger dummy_logger;
+    dummy_logger.mute();
+    const auto input_image = create_big_image(3840, 2160);
+    for (const auto compression : {
+        PngCompression::Store,
+        PngCompression::Fastest,
+        PngCompression::Fast,
+        PngCompression::Best})
+    {
+        for (const auto thread_count : {1, 0})
+        {
+            const auto png_encoder
+                = PngImageEncoder(compression, thread_count);
+            std::unique_ptr<io::File> output_file;
+            const auto time = bench::measure([&]()
+            {
+                output_file = png_encoder.encode(
+                    dummy_logger, input_image, "test.dat");
+            });
+            std::printf(
+                "preset %d, %s: %d bytes in %.03fs\n",
+                static_cast<int>(compression),
+                thread_count ? "1 thread" : "all threads",
+                static_cast<int>(output_file->stream.size()),
+                time);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdio>
+#include <map>
+#include <set>
+#include "bench/bench_support.h"
+#include "dec/idecoder.h"
+#include "dec/registry.h"
+#include "io/file_system.h"
+#include "test_support/catch.h"
+
+using namespace au;
+
+static size_t probe(
+    const std::map<std::string, std::shared_ptr<dec::IDecoder>> &decoders,
+    const std::vector<std::string> &names,
+    io::File &input_file)
+{
+    size_t recognized_count = 0;
+    for (const auto &name : names)
+        if (decoders.at(name)->is_recognized(input_file))
+            ++recognized_count;
+    return recognized_count;
+}
+
+TEST_CASE("Decoder signature index", "[benchmark][registry]")
+{
+    const auto &registry = dec::Registry::instance();
+    const auto names = registry.get_decoder_names();
+    const std::set<std::string> name_set(names.begin(), names.end());
+    std::map<std::string, std::shared_ptr<dec::IDecoder>> decoders;
+    for (const auto &name : names)
+        decoders[name] = registry.create_decoder(name);
+
+    std::vector<std::unique_ptr<io::File>> input_files;
+    for (const auto &path : io::recursive_directory_range("tests/dec"))
+        if (io::is_regular_file(path) && !path.has_extension("cc"))
+            input_files.push_back(std::make_unique<io::File>(
+                path, io::FileMode::Read));
+
+    size_t candidate_count = 0;
+    const auto probing_time = bench::measure([&]()
+    {
+        for (const auto &input_file : input_files)
+            probe(decoders, names, *input_file);
+    });
+    const auto indexed_time = bench::measure([&]()
+    {
+        for (const auto &input_file : input_files)
+        {
+            const auto candidates
+                = registry.get_recognition_candidates(*input_file, name_set);
+            probe(decoders, candidates, *input_file);
+            candidate_count += candidates.size();
+        }
+    });
+
+    std::printf(
+        "%d files: %.03fs probing all %d decoders, "
+        "%.03fs probing %.01f candidates per file\n",
+        static_cast<int>(input_files.size()),
+        probing_time,
+        static_cast<int>(names.size()),
+        indexed_time,
+        candidate_count / static_cast<double>(input_files.size()));
+}
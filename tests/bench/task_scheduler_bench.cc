@@ -0,0 +1,98 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/task_scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include "algo/range.h"
+#include "bench/bench_support.h"
+#include "test_support/catch.h"
+
+using namespace au;
+using namespace au::flow;
+
+namespace
+{
+    class LambdaTask final : public ITask
+    {
+    public:
+        LambdaTask(std::function<bool()> callback) : callback(callback)
+        {
+        }
+
+        bool work() const override
+        {
+            return callback();
+        }
+
+    private:
+        std::function<bool()> callback;
+    };
+}
+
+// Spawns a complete binary tree of tasks, similar to how nested decoding
+// bursts into many small tasks.
+static void spawn_tree(
+    TaskScheduler &scheduler,
+    std::atomic<int> &counter,
+    const int depth,
+    const int work_amount)
+{
+    scheduler.push_front(std::make_shared<LambdaTask>(
+        [&, depth, work_amount]()
+        {
+            volatile int sink = 0;
+            for (const auto i : algo::range(work_amount))
+                sink += i;
+            ++counter;
+            if (depth > 0)
+            {
+                spawn_tree(scheduler, counter, depth - 1, work_amount);
+                spawn_tree(scheduler, counter, depth - 1, work_amount);
+            }
+            return true;
+        }));
+}
+
+TEST_CASE("TaskScheduler scaling", "[benchmark][flow]")
+{
+    const auto max_thread_count = std::max<int>(
+        1, std::thread::hardware_concurrency());
+    double base_time = 0;
+    for (int thread_count = 1; ; thread_count *= 2)
+    {
+        thread_count = std::min(thread_count, max_thread_count);
+        TaskScheduler scheduler;
+        std::atomic<int> counter(0);
+        spawn_tree(scheduler, counter, 16, 2000);
+        const auto time = bench::measure([&]()
+        {
+            scheduler.run(thread_count);
+        });
+        REQUIRE(counter == (1 << 17) - 1);
+        if (thread_count == 1)
+            base_time = time;
+        std::printf(
+            "%d tasks on %d threads: %.03fs (%.02fx)\n",
+            counter.load(), thread_count, time, base_time / time);
+        if (thread_count == max_thread_count)
+            break;
+    }
+}
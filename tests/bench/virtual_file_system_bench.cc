@@ -0,0 +1,44 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "virtual_file_system.h"
+#include <cstdio>
+#include "algo/range.h"
+#include "bench/bench_support.h"
+#include "test_support/catch.h"
+
+using namespace au;
+
+TEST_CASE("VirtualFileSystem directory lookups", "[benchmark][core]")
+{
+    VirtualFileSystem::clear();
+    VirtualFileSystem::register_directory("tests/dec");
+    bool all_found = true;
+    const auto time = bench::measure([&]()
+    {
+        for (const auto i : algo::range(1000))
+        {
+            if (!VirtualFileSystem::get_by_name("reimu_transparent.png"))
+                all_found = false;
+            if (VirtualFileSystem::get_by_stem("missing"))
+                all_found = false;
+        }
+    });
+    VirtualFileSystem::clear();
+    REQUIRE(all_found);
+    std::printf("1000 hits and 1000 misses: %.03fs\n", time);
+}
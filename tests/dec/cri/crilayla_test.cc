@@ -0,0 +1,143 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dec/cri/crilayla.h"
+#include <algorithm>
+#include "algo/range.h"
+#include "err.h"
+#include "io/memory_byte_stream.h"
+#include "test_support/catch.h"
+#include "test_support/common.h"
+
+using namespace au;
+using namespace au::dec::cri;
+
+namespace
+{
+    // Packs bits MSB first. The decoder walks the compressed data from its
+    // last byte to its first one, so the packed bytes are stored reversed.
+    class LaylaWriter final
+    {
+    public:
+        void write_literal(const u8 c)
+        {
+            write(1, 0);
+            write(8, c);
+        }
+
+        void write_repetition(
+            const size_t look_behind, const size_t repetitions)
+        {
+            static const size_t marker_sizes[] = {2, 3, 5};
+            write(1, 1);
+            write(13, look_behind - 3);
+            auto left = repetitions - 3;
+            for (const auto i : algo::range(100))
+            {
+                const auto size = i < 3 ? marker_sizes[i] : 8;
+                const auto max = (1u << size) - 1;
+                if (left < max)
+                {
+                    write(size, left);
+                    break;
+                }
+                write(size, max);
+                left -= max;
+            }
+        }
+
+        bstr get_data() const
+        {
+            auto ret = bytes;
+            std::reverse(ret.begin(), ret.end());
+            return ret;
+        }
+
+    private:
+        void write(const size_t bits, const u32 value)
+        {
+            for (const auto i : algo::range(bits))
+            {
+                if (bit_pos % 8 == 0)
+                    bytes += "\x00"_b;
+                if ((value >> (bits - 1 - i)) & 1)
+                    bytes[bytes.size() - 1] |= 0x80 >> (bit_pos % 8);
+                bit_pos++;
+            }
+        }
+
+        bstr bytes;
+        size_t bit_pos = 0;
+    };
+}
+
+static bstr make_layla(
+    const LaylaWriter &writer, const size_t size_orig, const bstr &prefix)
+{
+    const auto data_comp = writer.get_data();
+    io::MemoryByteStream output_stream;
+    output_stream.write("CRILAYLA"_b);
+    output_stream.write_le<u32>(size_orig);
+    output_stream.write_le<u32>(data_comp.size());
+    output_stream.write(data_comp);
+    output_stream.write(prefix);
+    return output_stream.seek(0).read_to_eof();
+}
+
+TEST_CASE("CRI CRILAYLA decompression", "[dec]")
+{
+    SECTION("Literals, repetitions and the uncompressed prefix")
+    {
+        // The stream produces the output backwards: "abcdefgh", a copy of
+        // its first 4 bytes, "xyz", an overlapping run of it and "!".
+        LaylaWriter writer;
+        for (const auto c : "abcdefgh"_b)
+            writer.write_literal(c);
+        writer.write_repetition(8, 4);
+        for (const auto c : "xyz"_b)
+            writer.write_literal(c);
+        writer.write_repetition(3, 49);
+        writer.write_literal('!');
+        const auto prefix = "uncompressed header"_b;
+        const auto input = make_layla(writer, 65, prefix);
+
+        bstr reversed = "abcdefghabcdxyz"_b;
+        for (const auto i : algo::range(49))
+            reversed += bstr(1, "xyz"[i % 3]);
+        reversed += "!"_b;
+        std::reverse(reversed.begin(), reversed.end());
+
+        tests::compare_binary(crilayla_decompress(input), prefix + reversed);
+    }
+
+    SECTION("Look-behind out of bounds")
+    {
+        LaylaWriter writer;
+        writer.write_literal('a');
+        writer.write_repetition(5, 3);
+        const auto input = make_layla(writer, 4, ""_b);
+        REQUIRE_THROWS_AS(crilayla_decompress(input), err::CorruptDataError);
+    }
+
+    SECTION("Truncated stream")
+    {
+        LaylaWriter writer;
+        writer.write_literal('a');
+        const auto input = make_layla(writer, 2, ""_b);
+        REQUIRE_THROWS_AS(crilayla_decompress(input), err::EofError);
+    }
+}
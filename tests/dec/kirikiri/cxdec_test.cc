@@ -0,0 +1,76 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dec/kirikiri/cxdec.h"
+#include "algo/crypt/md5.h"
+#include "algo/range.h"
+#include "test_support/catch.h"
+#include "test_support/common.h"
+
+using namespace au;
+using namespace au::dec::kirikiri;
+
+static bstr make_control_block()
+{
+    bstr control_block(4096);
+    u32 seed = 1;
+    for (const auto i : algo::range(control_block.size()))
+    {
+        seed = seed * 1103515245 + 12345;
+        control_block[i] = seed >> 16;
+    }
+    return control_block;
+}
+
+TEST_CASE("KiriKiri cxdec key derivation", "[dec]")
+{
+    // Hashes of a zeroed 64 KiB buffer decrypted with the given keys, as
+    // produced by the original shellcode interpreter. The buffer is large
+    // enough for both 16-bit offsets of each chunk to land in it.
+    static const std::vector<std::pair<u32, bstr>> expected_hashes
+    {
+        {0x75432777, "\xF8\x69\x0C\x37\x72\xF2\xDA\xAF"
+                     "\x6D\x6F\x02\x10\x20\x36\xDC\xCF"_b},
+        {0xCD305E6A, "\xF8\x7F\x1B\xA8\x74\x17\x0B\x53"
+                     "\xE9\x0B\x17\xD8\xD8\xC3\x1C\xE6"_b},
+        {0x25DBFAC1, "\x87\x61\x17\xBA\x6E\x62\xA2\x06"
+                     "\x31\x4D\x77\x6D\x0F\xD0\xF6\xB2"_b},
+        {0x4B5C952C, "\xEA\x7C\xAF\x6A\x2B\x5B\x8B\x8A"
+                     "\x8B\x64\x91\x77\x21\xC2\x24\x8D"_b},
+        {0x84DE0E9B, "\xD6\xE1\x58\x04\x49\x47\x97\xB4"
+                     "\x25\x49\xE0\x11\xDD\xCA\x4E\xB0"_b},
+        {0xE2AA733E, "\x18\xC1\xDF\x56\x41\xD5\xFE\x15"
+                     "\xC8\x5E\x8F\xEB\xA0\x27\xF3\x0E"_b},
+        {0xEA0F8185, "\x1F\xA7\x38\x76\xC3\x9E\x95\x79"
+                     "\x8E\x12\x20\xEF\x76\xEF\x95\xF9"_b},
+        {0xF2D08520, "\x31\x7A\x0B\x05\x6B\xD3\x24\x0E"
+                     "\x42\xF4\x15\x38\xF0\x31\x13\x94"_b},
+    };
+
+    const auto plugin = create_cxdec_plugin(
+        0x22A, 0x2A2, {1,0,2}, {7,6,5,1,0,3,4,2}, {3,2,1,4,5,0},
+        make_control_block());
+    const auto decrypt = plugin.create_decrypt_func("test.xp3");
+
+    for (const auto &kv : expected_hashes)
+    {
+        bstr data(0x10000);
+        decrypt(data, kv.first);
+        INFO("Key: " << kv.first);
+        tests::compare_binary(algo::crypt::md5(data), kv.second);
+    }
+}
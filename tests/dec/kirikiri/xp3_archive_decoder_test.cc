@@ -16,6 +16,7 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "dec/kirikiri/xp3_archive_decoder.h"
+#include "err.h"
 #include "test_support/catch.h"
 #include "test_support/decoder_support.h"
 #include "test_support/file_support.h"
@@ -25,7 +26,7 @@ using namespace au::dec::kirikiri;
 
 static const std::string dir = "tests/dec/kirikiri/files/xp3/";
 
-static void do_test(const std::string &input_path)
+static void do_test(io::File &input_file)
 {
     const std::vector<std::shared_ptr<io::File>> expected_files
     {
@@ -34,11 +35,16 @@ static void do_test(const std::string &input_path)
     };
     Xp3ArchiveDecoder decoder;
     decoder.plugin_manager.set("noop");
-    const auto input_file = tests::file_from_path(dir + input_path);
-    const auto actual_files = tests::unpack(decoder, *input_file);
+    const auto actual_files = tests::unpack(decoder, input_file);
     tests::compare_files(actual_files, expected_files, true);
 }
 
+static void do_test(const std::string &input_path)
+{
+    const auto input_file = tests::file_from_path(dir + input_path);
+    do_test(*input_file);
+}
+
 TEST_CASE("KiriKiri XP3 archives", "[dec]")
 {
     SECTION("Version 1")
@@ -75,4 +81,37 @@ TEST_CASE("KiriKiri XP3 archives", "[dec]")
     {
         do_test("xp3-time.xp3");
     }
+
+    SECTION("Implausible uncompressed sizes")
+    {
+        const auto data = tests::file_from_path(
+            dir + "xp3-compressed-files.xp3")->stream.read_to_eof();
+        io::File input_file("test.xp3", data);
+        for (auto pos = data.find("segm"_b);
+            pos != bstr::npos;
+            pos = data.find("segm"_b, pos + 1))
+        {
+            input_file.stream.seek(pos + 24).write_le<u64>(0xFFFFFFFFFFFF);
+        }
+        do_test(input_file);
+    }
+
+    SECTION("Implausible compressed sizes")
+    {
+        const auto data = tests::file_from_path(
+            dir + "xp3-compressed-files.xp3")->stream.read_to_eof();
+        io::File input_file("test.xp3", data);
+        for (auto pos = data.find("segm"_b);
+            pos != bstr::npos;
+            pos = data.find("segm"_b, pos + 1))
+        {
+            input_file.stream.seek(pos + 24);
+            input_file.stream.write_le<u64>(0xFFFFFFFFFFFFFFFF);
+            input_file.stream.write_le<u64>(0xFFFFFFFFFFFFFFFF);
+        }
+        Xp3ArchiveDecoder decoder;
+        decoder.plugin_manager.set("noop");
+        REQUIRE_THROWS_AS(
+            tests::unpack(decoder, input_file), err::EofError);
+    }
 }
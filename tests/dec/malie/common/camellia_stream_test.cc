@@ -0,0 +1,133 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dec/malie/common/camellia_stream.h"
+#include "algo/range.h"
+#include "io/memory_byte_stream.h"
+#include "test_support/catch.h"
+#include "test_support/common.h"
+
+using namespace au;
+using namespace au::dec::malie::common;
+
+static const std::vector<u32> key =
+{
+    0x364F9A3E, 0x873B57D7, 0x920C8F7C, 0x2CCCC422,
+    0x0309410A, 0xC7DFDB3F, 0x3180EB15, 0xE5D35D62,
+    0x3FA9D12A, 0x34EF8ECB, 0x8A62FA9C, 0x537EB987,
+    0x502947E1, 0x3A65CB88, 0x85A91735, 0x87E77D3D,
+    0xB563DBCA, 0x1B009542, 0x16573462, 0x84C47A65,
+    0x057C13F5, 0xC6598E67, 0xB444FBF1, 0x6157D19F,
+    0x77ED2698, 0xE6E57501, 0xEACADAAD, 0xAAD676B2,
+    0x266968F1, 0xEC566ACE, 0x261B7E2E, 0x1C46FE7C,
+    0x8AA8675B, 0x6CF5157A, 0xC1717A59, 0x36982E47,
+    0x5D4C7804, 0xE2E976F7, 0x7592E4C7, 0x304A48B3,
+    0xC8E3D3FF, 0xFF8B759A, 0x9EF24637, 0xC98FE507,
+    0x04767A7A, 0x693DB6A7, 0x084FAE8D, 0x90DBB24A,
+    0x2CAA8502, 0x4DDBE69D, 0x9CF7D7AF, 0xF3D06D0A,
+};
+
+static bstr make_input(const size_t size)
+{
+    bstr input(size);
+    u32 seed = 1;
+    for (const auto i : algo::range(size))
+    {
+        seed = seed * 1103515245 + 12345;
+        input[i] = seed >> 16;
+    }
+    return input;
+}
+
+static bstr decrypt(const bstr &input)
+{
+    algo::crypt::Camellia camellia(key);
+    io::MemoryByteStream input_stream(input);
+    io::MemoryByteStream output_stream;
+    for (const auto i : algo::range(input.size() / 0x10))
+    {
+        u32 input_block[4];
+        u32 output_block[4];
+        for (const auto j : algo::range(4))
+            input_block[j] = input_stream.read_le<u32>();
+        camellia.decrypt_block_128(i * 0x10, input_block, output_block);
+        for (const auto j : algo::range(4))
+            output_stream.write_be<u32>(output_block[j]);
+    }
+    return output_stream.seek(0).read_to_eof();
+}
+
+TEST_CASE("Malie Camellia stream", "[dec]")
+{
+    const auto input = make_input(20000);
+    const auto expected = decrypt(input);
+    io::MemoryByteStream input_stream(input);
+
+    SECTION("Reading in small chunks")
+    {
+        CamelliaStream stream(input_stream, key);
+        bstr output;
+        while (stream.left())
+            output += stream.read(std::min<size_t>(stream.left(), 7));
+        tests::compare_binary(output, expected);
+    }
+
+    SECTION("Reading big unaligned chunks")
+    {
+        CamelliaStream stream(input_stream, key);
+        stream.seek(5);
+        tests::compare_binary(stream.read(15000), expected.substr(5, 15000));
+        REQUIRE(stream.pos() == 15005);
+        tests::compare_binary(stream.read(4995), expected.substr(15005));
+    }
+
+    SECTION("Rereading after seeking")
+    {
+        CamelliaStream stream(input_stream, key);
+        stream.seek(10000);
+        tests::compare_binary(stream.read(20), expected.substr(10000, 20));
+        stream.seek(30);
+        tests::compare_binary(stream.read(4), expected.substr(30, 4));
+        stream.seek(10010);
+        tests::compare_binary(stream.read(40), expected.substr(10010, 40));
+    }
+
+    SECTION("Reading views of the parent stream")
+    {
+        CamelliaStream stream(input_stream, key, 100, 5000);
+        REQUIRE(stream.size() == 5000);
+        tests::compare_binary(
+            stream.seek(3).read(10), expected.substr(103, 10));
+        const auto clone = stream.clone();
+        REQUIRE(clone->pos() == 13);
+        tests::compare_binary(clone->read(4900), expected.substr(113, 4900));
+    }
+
+    SECTION("Reading beyond the last full block")
+    {
+        io::MemoryByteStream short_stream(input.substr(0, 40));
+        CamelliaStream stream(short_stream, key);
+        tests::compare_binary(stream.read(32), expected.substr(0, 32));
+        REQUIRE_THROWS(stream.read(1));
+    }
+
+    SECTION("Empty key")
+    {
+        CamelliaStream stream(input_stream, {});
+        tests::compare_binary(stream.seek(7).read(3), input.substr(7, 3));
+    }
+}
@@ -16,6 +16,8 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "dec/microsoft/dds_image_decoder.h"
+#include "algo/range.h"
+#include "io/memory_byte_stream.h"
 #include "test_support/catch.h"
 #include "test_support/decoder_support.h"
 #include "test_support/file_support.h"
@@ -36,6 +38,49 @@ static void do_test(
     tests::compare_images(actual_image, *expected_file);
 }
 
+// Builds a 4x4 texture holding a single block.
+static std::unique_ptr<io::File> make_dds(
+    const bstr &four_cc, const u32 dxgi_format, const bstr &block)
+{
+    io::MemoryByteStream output_stream;
+    output_stream.write("DDS\x20"_b);
+    output_stream.write_le<u32>(124);
+    output_stream.write_le<u32>(0x1007);
+    output_stream.write_le<u32>(4);
+    output_stream.write_le<u32>(4);
+    output_stream.write_le<u32>(block.size());
+    output_stream.write_le<u32>(0);
+    output_stream.write_le<u32>(1);
+    output_stream.write(bstr(4 * 11));
+    output_stream.write_le<u32>(32);
+    output_stream.write_le<u32>(0x4);
+    output_stream.write(four_cc);
+    output_stream.write(bstr(4 * 5));
+    output_stream.write(bstr(4 * 5));
+    if (four_cc == "DX10"_b)
+    {
+        output_stream.write_le<u32>(dxgi_format);
+        output_stream.write_le<u32>(3);
+        output_stream.write_le<u32>(0);
+        output_stream.write_le<u32>(1);
+        output_stream.write_le<u32>(0);
+    }
+    output_stream.write(block);
+    return std::make_unique<io::File>(
+        "test.dds", output_stream.seek(0).read_to_eof());
+}
+
+static void do_test(io::File &input_file, const res::Pixel expected_pixel)
+{
+    const auto decoder = DdsImageDecoder();
+    const auto actual_image = tests::decode(decoder, input_file);
+    REQUIRE(actual_image.width() == 4);
+    REQUIRE(actual_image.height() == 4);
+    for (const auto y : algo::range(4))
+    for (const auto x : algo::range(4))
+        REQUIRE(actual_image.at(x, y) == expected_pixel);
+}
+
 TEST_CASE("Microsoft DDS textures", "[dec]")
 {
     SECTION("DXT1")
@@ -57,4 +102,39 @@ TEST_CASE("Microsoft DDS textures", "[dec]")
     {
         do_test("koishi_7.dds", "koishi_7-out.png");
     }
+
+    SECTION("BC4")
+    {
+        const auto input_file
+            = make_dds("ATI1"_b, 0, "\x80\x80\x00\x00\x00\x00\x00\x00"_b);
+        do_test(*input_file, {0x80, 0x80, 0x80, 0xFF});
+    }
+
+    SECTION("BC5")
+    {
+        const auto input_file = make_dds(
+            "ATI2"_b,
+            0,
+            "\x40\x40\x00\x00\x00\x00\x00\x00"
+            "\x80\x80\x00\x00\x00\x00\x00\x00"_b);
+        do_test(*input_file, {0, 0x80, 0x40, 0xFF});
+    }
+
+    SECTION("DX10 header")
+    {
+        // mode 6 with both endpoints set to white
+        const auto input_file = make_dds(
+            "DX10"_b,
+            98,
+            "\xC0\xFF\xFF\xFF\xFF\xFF\xFF\xFF"
+            "\x01\x00\x00\x00\x00\x00\x00\x00"_b);
+        do_test(*input_file, {0xFF, 0xFF, 0xFF, 0xFF});
+    }
+
+    SECTION("Unsupported DXGI formats")
+    {
+        const auto decoder = DdsImageDecoder();
+        const auto input_file = make_dds("DX10"_b, 95, bstr(16));
+        REQUIRE_THROWS(tests::decode(decoder, *input_file));
+    }
 }
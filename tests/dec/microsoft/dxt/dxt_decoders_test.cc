@@ -0,0 +1,205 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dec/microsoft/dxt/dxt_decoders.h"
+#include "algo/range.h"
+#include "err.h"
+#include "io/memory_byte_stream.h"
+#include "test_support/catch.h"
+
+using namespace au;
+using namespace au::dec::microsoft::dxt;
+
+namespace
+{
+    // Packs BC7 fields starting from the least significant bit.
+    class Bc7BlockWriter final
+    {
+    public:
+        Bc7BlockWriter() : block(16), pos(0)
+        {
+        }
+
+        Bc7BlockWriter &put(const u32 value, const size_t bits)
+        {
+            for (const auto i : algo::range(bits))
+            {
+                if (value & (1 << i))
+                    block[pos >> 3] |= 1 << (pos & 7);
+                pos++;
+            }
+            return *this;
+        }
+
+        bstr get() const
+        {
+            REQUIRE(pos == 128);
+            return block;
+        }
+
+    private:
+        bstr block;
+        size_t pos;
+    };
+}
+
+static std::unique_ptr<res::Image> decode(
+    const bstr &input, const BcnFormat fmt, const size_t width = 4)
+{
+    return decode_bcn(input.get<const u8>(), input.size(), fmt, width, 4);
+}
+
+static res::Pixel make_pixel(const u8 r, const u8 g, const u8 b, const u8 a)
+{
+    res::Pixel pixel;
+    pixel.r = r;
+    pixel.g = g;
+    pixel.b = b;
+    pixel.a = a;
+    return pixel;
+}
+
+TEST_CASE("BCn texture decoding", "[dec]")
+{
+    SECTION("BC4")
+    {
+        const auto image = decode(
+            "\xC8\x64\x88\x00\x00\x00\x00\x00"_b, BcnFormat::Bc4);
+        REQUIRE(image->at(0, 0) == make_pixel(200, 200, 200, 0xFF));
+        REQUIRE(image->at(1, 0) == make_pixel(100, 100, 100, 0xFF));
+        REQUIRE(image->at(2, 0) == make_pixel(185, 185, 185, 0xFF));
+        REQUIRE(image->at(3, 3) == make_pixel(200, 200, 200, 0xFF));
+    }
+
+    SECTION("BC5")
+    {
+        const auto image = decode(
+            "\x40\x40\x00\x00\x00\x00\x00\x00"
+            "\x80\x80\x00\x00\x00\x00\x00\x00"_b,
+            BcnFormat::Bc5);
+        for (const auto y : algo::range(4))
+        for (const auto x : algo::range(4))
+            REQUIRE(image->at(x, y) == make_pixel(0x40, 0x80, 0, 0xFF));
+    }
+
+    SECTION("BC7 with interpolated indices")
+    {
+        Bc7BlockWriter writer;
+        writer.put(1 << 6, 7);
+        writer.put(0x40, 7).put(0, 7);
+        writer.put(0x20, 7).put(0, 7);
+        writer.put(0x10, 7).put(0, 7);
+        writer.put(0x7F, 7).put(0, 7);
+        writer.put(1, 1).put(0, 1);
+        writer.put(0, 3).put(15, 4).put(8, 4);
+        for (const auto i : algo::range(13))
+            writer.put(0, 4);
+        const auto image = decode(writer.get(), BcnFormat::Bc7);
+        REQUIRE(image->at(0, 0) == make_pixel(0x81, 0x41, 0x21, 0xFF));
+        REQUIRE(image->at(1, 0) == make_pixel(0, 0, 0, 0));
+        REQUIRE(image->at(2, 0) == make_pixel(60, 30, 15, 120));
+        REQUIRE(image->at(3, 3) == make_pixel(0x81, 0x41, 0x21, 0xFF));
+    }
+
+    SECTION("BC7 with channel rotation")
+    {
+        Bc7BlockWriter writer;
+        writer.put(1 << 5, 6);
+        writer.put(1, 2);
+        writer.put(0x7F, 7).put(0, 7);
+        writer.put(0, 7).put(0, 7);
+        writer.put(0, 7).put(0, 7);
+        writer.put(0x10, 8).put(0, 8);
+        writer.put(0, 31).put(0, 31);
+        const auto image = decode(writer.get(), BcnFormat::Bc7);
+        for (const auto y : algo::range(4))
+        for (const auto x : algo::range(4))
+            REQUIRE(image->at(x, y) == make_pixel(0x10, 0, 0, 0xFF));
+    }
+
+    SECTION("BC7 with partitions")
+    {
+        Bc7BlockWriter writer;
+        writer.put(1 << 1, 2);
+        writer.put(0, 6);
+        for (const auto c : algo::range(3))
+            writer.put(63, 6).put(63, 6).put(0, 6).put(0, 6);
+        writer.put(1, 1).put(0, 1);
+        writer.put(0, 16 * 3 - 2);
+        const auto image = decode(writer.get(), BcnFormat::Bc7);
+        for (const auto y : algo::range(4))
+        {
+            REQUIRE(image->at(0, y) == make_pixel(0xFF, 0xFF, 0xFF, 0xFF));
+            REQUIRE(image->at(1, y) == make_pixel(0xFF, 0xFF, 0xFF, 0xFF));
+            REQUIRE(image->at(2, y) == make_pixel(0, 0, 0, 0xFF));
+            REQUIRE(image->at(3, y) == make_pixel(0, 0, 0, 0xFF));
+        }
+    }
+
+    SECTION("BC7 with reserved mode")
+    {
+        const auto image = decode(bstr(16, 0xFF) + bstr(16), BcnFormat::Bc7, 8);
+        for (const auto y : algo::range(4))
+        for (const auto x : algo::range(4, 8))
+            REQUIRE(image->at(x, y) == make_pixel(0, 0, 0, 0));
+    }
+
+    SECTION("Unaligned dimensions")
+    {
+        const auto input = bstr(get_texture_size(BcnFormat::Bc1, 5, 7));
+        REQUIRE(input.size() == 4 * 8);
+        const auto image = decode_bcn(
+            input.get<const u8>(), input.size(), BcnFormat::Bc1, 5, 7);
+        REQUIRE(image->width() == 8);
+        REQUIRE(image->height() == 8);
+    }
+
+    SECTION("Not enough input")
+    {
+        io::MemoryByteStream input_stream(bstr(8 * 4 - 1));
+        REQUIRE_THROWS_AS(
+            decode_bcn(input_stream, BcnFormat::Bc1, 8, 8), err::EofError);
+    }
+
+    SECTION("Large textures match block by block decoding")
+    {
+        const size_t width = 1024, height = 512;
+        for (const auto fmt : {BcnFormat::Bc1, BcnFormat::Bc3, BcnFormat::Bc7})
+        {
+            const auto block_size = get_block_size(fmt);
+            bstr input(get_texture_size(fmt, width, height));
+            for (auto &c : input)
+                c = rand();
+            const auto image = decode_bcn(
+                input.get<const u8>(), input.size(), fmt, width, height);
+
+            const auto *input_ptr = input.get<const u8>();
+            for (const auto block_y : algo::range(0, height, 4))
+            for (const auto block_x : algo::range(0, width, 4))
+            {
+                const auto block = decode_bcn(input_ptr, block_size, fmt, 4, 4);
+                input_ptr += block_size;
+                for (const auto y : algo::range(4))
+                for (const auto x : algo::range(4))
+                {
+                    REQUIRE(image->at(block_x + x, block_y + y)
+                        == block->at(x, y));
+                }
+            }
+        }
+    }
+}
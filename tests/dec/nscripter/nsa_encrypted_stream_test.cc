@@ -17,6 +17,7 @@
 
 #include "dec/nscripter/nsa_encrypted_stream.h"
 #include <array>
+#include <thread>
 #include "algo/binary.h"
 #include "algo/crypt/hmac.h"
 #include "algo/crypt/md5.h"
@@ -77,13 +78,8 @@ static void transform_block(
     }
 }
 
-TEST_CASE("NScripter NSA encryption", "[dec]")
+static bstr encrypt(const bstr &input, const bstr &key)
 {
-    bstr input;
-    for (const auto i : algo::range(10000))
-        input += "weird things"_b;
-    const auto key = "weird key"_b;
-
     bstr encrypted_input = input;
     for (const auto i : algo::range(0, input.size(), 1024))
     {
@@ -93,17 +89,90 @@ TEST_CASE("NScripter NSA encryption", "[dec]")
             encrypted_input.get<u8>() + i,
             std::max<size_t>(0, std::min<size_t>(input.size() - i, 1024)));
     }
+    return encrypted_input;
+}
 
-    const size_t chunk_size = 555;
+TEST_CASE("NScripter NSA encryption", "[dec]")
+{
+    bstr input;
+    for (const auto i : algo::range(10000))
+        input += "weird things"_b;
+    const auto key = "weird key"_b;
+    const auto encrypted_input = encrypt(input, key);
     io::MemoryByteStream base_stream(encrypted_input);
-    dec::nscripter::NsaEncryptedStream encrypted_stream(base_stream, key);
 
-    bstr output;
-    while (encrypted_stream.left())
+    SECTION("Reading in chunks")
+    {
+        const size_t chunk_size = 555;
+        dec::nscripter::NsaEncryptedStream encrypted_stream(base_stream, key);
+
+        bstr output;
+        while (encrypted_stream.left())
+        {
+            output += encrypted_stream.read(
+                std::min<size_t>(encrypted_stream.left(), chunk_size));
+        }
+
+        tests::compare_binary(output, input);
+    }
+
+    SECTION("Reading everything at once")
     {
-        output += encrypted_stream.read(
-            std::min<size_t>(encrypted_stream.left(), chunk_size));
+        dec::nscripter::NsaEncryptedStream encrypted_stream(base_stream, key);
+        tests::compare_binary(encrypted_stream.read_to_eof(), input);
     }
 
-    tests::compare_binary(output, input);
+    SECTION("Rereading after seeking")
+    {
+        dec::nscripter::NsaEncryptedStream encrypted_stream(base_stream, key);
+        encrypted_stream.seek(5000);
+        tests::compare_binary(
+            encrypted_stream.read(3000), input.substr(5000, 3000));
+        encrypted_stream.seek(1000);
+        tests::compare_binary(
+            encrypted_stream.read(6000), input.substr(1000, 6000));
+        REQUIRE(encrypted_stream.pos() == 7000);
+    }
+
+    SECTION("Clones and streams sharing a cache")
+    {
+        const auto cache
+            = std::make_shared<dec::nscripter::NsaKeystreamCache>(key);
+        dec::nscripter::NsaEncryptedStream encrypted_stream(base_stream, cache);
+        encrypted_stream.seek(2000);
+        const auto clone = encrypted_stream.clone();
+        REQUIRE(clone->pos() == 2000);
+        tests::compare_binary(clone->read(100), input.substr(2000, 100));
+        REQUIRE(encrypted_stream.pos() == 2000);
+
+        dec::nscripter::NsaEncryptedStream other_stream(base_stream, cache);
+        tests::compare_binary(other_stream.read_to_eof(), input);
+    }
+
+    SECTION("Concurrent large reads sharing a cache")
+    {
+        const auto cache
+            = std::make_shared<dec::nscripter::NsaKeystreamCache>(key);
+        std::vector<bstr> outputs(4);
+        std::vector<std::thread> threads;
+        for (const auto i : algo::range(outputs.size()))
+        {
+            threads.emplace_back([&, i]()
+            {
+                dec::nscripter::NsaEncryptedStream encrypted_stream(
+                    base_stream, cache);
+                outputs[i] = encrypted_stream.read_to_eof();
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        for (const auto &output : outputs)
+            tests::compare_binary(output, input);
+    }
+
+    SECTION("Empty key")
+    {
+        dec::nscripter::NsaEncryptedStream plain_stream(base_stream, ""_b);
+        tests::compare_binary(plain_stream.read_to_eof(), encrypted_input);
+    }
 }
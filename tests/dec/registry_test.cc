@@ -0,0 +1,235 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "dec/registry.h"
+#include "dec/base_file_decoder.h"
+#include "io/file_system.h"
+#include "test_support/catch.h"
+
+using namespace au;
+using namespace au::dec;
+
+namespace
+{
+    class TestDecoder final : public BaseFileDecoder
+    {
+    public:
+        TestDecoder(
+            const DecoderSignature &signature,
+            const std::vector<std::string> &linked_formats = {});
+        DecoderSignature get_signature() const override;
+        std::vector<std::string> get_linked_formats() const override;
+
+    protected:
+        bool is_recognized_impl(io::File &input_file) const override;
+
+        std::unique_ptr<io::File> decode_impl(
+            const Logger &logger, io::File &input_file) const override;
+
+    private:
+        DecoderSignature signature;
+        std::vector<std::string> linked_formats;
+    };
+}
+
+TestDecoder::TestDecoder(
+    const DecoderSignature &signature,
+    const std::vector<std::string> &linked_formats) :
+        signature(signature),
+        linked_formats(linked_formats)
+{
+}
+
+DecoderSignature TestDecoder::get_signature() const
+{
+    return signature;
+}
+
+std::vector<std::string> TestDecoder::get_linked_formats() const
+{
+    return linked_formats;
+}
+
+bool TestDecoder::is_recognized_impl(io::File &input_file) const
+{
+    return true;
+}
+
+std::unique_ptr<io::File> TestDecoder::decode_impl(
+    const Logger &logger, io::File &input_file) const
+{
+    return nullptr;
+}
+
+static std::vector<std::string> get_candidates(
+    const Registry &registry, io::File &input_file)
+{
+    const auto names = registry.get_decoder_names();
+    return registry.get_recognition_candidates(
+        input_file, std::set<std::string>(names.begin(), names.end()));
+}
+
+TEST_CASE("Decoder registry", "[dec]")
+{
+    auto registry = Registry::create_mock();
+    const auto add = [&](const std::string &name, DecoderSignature signature)
+    {
+        registry->add_decoder(
+            name, [=]() { return std::make_shared<TestDecoder>(signature); });
+    };
+    add("none", DecoderSignature());
+    add("abc", DecoderSignature().add_magic("ABC"_b));
+    add("abc-or-xyz", DecoderSignature().add_magic("ABC"_b).add_magic("XYZ"_b));
+    add("bc-at-1", DecoderSignature().add_magic("BC"_b, 1));
+    add("abc-dat", DecoderSignature().add_magic("ABC"_b).add_extension("dat"));
+    add("dat", DecoderSignature().add_extension("dat"));
+    add("big", DecoderSignature().set_min_size(10));
+
+    SECTION("Matching magic")
+    {
+        io::File input_file("test.bin", "ABCDEF"_b);
+        REQUIRE(get_candidates(*registry, input_file)
+            == std::vector<std::string>(
+                {"abc", "abc-or-xyz", "bc-at-1", "none"}));
+    }
+
+    SECTION("Matching alternative magic")
+    {
+        io::File input_file("test.bin", "XYZ"_b);
+        REQUIRE(get_candidates(*registry, input_file)
+            == std::vector<std::string>({"abc-or-xyz", "none"}));
+    }
+
+    SECTION("Matching extension")
+    {
+        io::File input_file("test.DAT", "ABC"_b);
+        REQUIRE(get_candidates(*registry, input_file)
+            == std::vector<std::string>(
+                {"abc", "abc-dat", "abc-or-xyz", "bc-at-1", "dat", "none"}));
+    }
+
+    SECTION("Matching minimum size")
+    {
+        io::File input_file("test.bin", "0123456789"_b);
+        REQUIRE(get_candidates(*registry, input_file)
+            == std::vector<std::string>({"big", "none"}));
+    }
+
+    SECTION("Files shorter than magic")
+    {
+        io::File input_file("test.bin", "A"_b);
+        REQUIRE(get_candidates(*registry, input_file)
+            == std::vector<std::string>({"none"}));
+    }
+
+    SECTION("Restricting to given decoders")
+    {
+        io::File input_file("test.bin", "ABC"_b);
+        REQUIRE(registry->get_recognition_candidates(
+                input_file, {"abc", "dat"})
+            == std::vector<std::string>({"abc"}));
+    }
+
+    SECTION("Rebuilding index after adding decoders")
+    {
+        io::File input_file("test.bin", "XYZ"_b);
+        get_candidates(*registry, input_file);
+        add("xyz", DecoderSignature().add_magic("XYZ"_b));
+        REQUIRE(get_candidates(*registry, input_file)
+            == std::vector<std::string>({"abc-or-xyz", "none", "xyz"}));
+    }
+}
+
+TEST_CASE("Decoder registry linked decoders", "[dec]")
+{
+    auto registry = Registry::create_mock();
+    const auto add = [&](
+        const std::string &name, const std::vector<std::string> &linked)
+    {
+        registry->add_decoder(
+            name,
+            [=]()
+            {
+                return std::make_shared<TestDecoder>(
+                    DecoderSignature(), linked);
+            });
+    };
+    add("archive", {"image", "nested-archive"});
+    add("nested-archive", {"archive", "audio"});
+    add("image", {});
+    add("audio", {});
+
+    SECTION("Closure of linked formats")
+    {
+        REQUIRE(*registry->get_linked_decoders("archive")
+            == std::set<std::string>(
+                {"archive", "audio", "image", "nested-archive"}));
+        REQUIRE(*registry->get_linked_decoders("nested-archive")
+            == std::set<std::string>(
+                {"archive", "audio", "image", "nested-archive"}));
+        REQUIRE(registry->get_linked_decoders("image")->empty());
+    }
+
+    SECTION("Results are shared")
+    {
+        REQUIRE(registry->get_linked_decoders("archive")
+            == registry->get_linked_decoders("archive"));
+    }
+
+    SECTION("Rebuilding after adding decoders")
+    {
+        registry->get_linked_decoders("image");
+        add("video", {"image"});
+        REQUIRE(*registry->get_linked_decoders("video")
+            == std::set<std::string>({"image"}));
+    }
+
+    SECTION("Unknown decoders")
+    {
+        REQUIRE_THROWS(registry->get_linked_decoders("unknown"));
+    }
+}
+
+TEST_CASE("Decoder signatures over test corpus", "[dec]")
+{
+    // the index must never hide a decoder that would recognize the file
+    const auto &registry = Registry::instance();
+    const auto names = registry.get_decoder_names();
+    const std::set<std::string> name_set(names.begin(), names.end());
+    std::map<std::string, std::shared_ptr<IDecoder>> decoders;
+    for (const auto &name : names)
+        decoders[name] = registry.create_decoder(name);
+
+    for (const auto &path : io::recursive_directory_range("tests/dec"))
+    {
+        if (!io::is_regular_file(path) || path.has_extension("cc"))
+            continue;
+        io::File input_file(path, io::FileMode::Read);
+        INFO(path.str());
+        const auto candidates
+            = registry.get_recognition_candidates(input_file, name_set);
+        const std::set<std::string> candidate_set(
+            candidates.begin(), candidates.end());
+        for (const auto &name : names)
+        {
+            if (candidate_set.find(name) != candidate_set.end())
+                continue;
+            INFO(name);
+            REQUIRE(!decoders[name]->is_recognized(input_file));
+        }
+    }
+}
@@ -0,0 +1,88 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "enc/png/png_image_encoder.h"
+#include "algo/range.h"
+#include "dec/png/png_image_decoder.h"
+#include "test_support/catch.h"
+#include "test_support/common.h"
+#include "test_support/image_support.h"
+
+using namespace au;
+using namespace au::enc::png;
+
+static res::Image create_big_image(
+    const size_t width = 1000, const size_t height = 700)
+{
+    res::Image image(width, height);
+    for (const auto y : algo::range(image.height()))
+    for (const auto x : algo::range(image.width()))
+    {
+        auto &pixel = image.at(x, y);
+        pixel.r = x * y;
+        pixel.g = x + y;
+        pixel.b = (x ^ y) >> 2;
+        pixel.a = y;
+    }
+    return image;
+}
+
+static void do_test(const res::Image &input_image, const size_t thread_count)
+{
+    Logger dummy_logger;
+    dummy_logger.mute();
+    const auto png_decoder = dec::png::PngImageDecoder();
+    for (const auto compression : {
+        PngCompression::Store,
+        PngCompression::Fastest,
+        PngCompression::Fast,
+        PngCompression::Best})
+    {
+        const auto png_encoder = PngImageEncoder(compression, thread_count);
+        const auto output_file
+            = png_encoder.encode(dummy_logger, input_image, "test.dat");
+        REQUIRE(output_file->path.name() == "test.png");
+        const auto output_image
+            = png_decoder.decode(dummy_logger, *output_file);
+        tests::compare_images(output_image, input_image);
+    }
+}
+
+TEST_CASE("PNG images encoding", "[enc]")
+{
+    SECTION("Small image")
+    {
+        res::Image input_image(1, 1);
+        input_image.at(0, 0) = {1, 2, 3, 4};
+        do_test(input_image, 1);
+    }
+
+    SECTION("Transparent image")
+    {
+        do_test(tests::get_transparent_test_image(), 1);
+    }
+
+    SECTION("Image spanning many bands, single thread")
+    {
+        do_test(create_big_image(), 1);
+    }
+
+    SECTION("Image spanning many bands, multiple threads")
+    {
+        do_test(create_big_image(), 4);
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/decoder_options_cache.h"
+#include "dec/base_file_decoder.h"
+#include "test_support/catch.h"
+
+using namespace au;
+using namespace au::flow;
+
+namespace
+{
+    class TestDecoder final : public dec::BaseFileDecoder
+    {
+    public:
+        TestDecoder(int &register_count);
+
+        std::string value;
+
+    protected:
+        bool is_recognized_impl(io::File &input_file) const override;
+
+        std::unique_ptr<io::File> decode_impl(
+            const Logger &logger, io::File &input_file) const override;
+    };
+}
+
+TestDecoder::TestDecoder(int &register_count)
+{
+    add_arg_parser_decorator(
+        [&](ArgParser &arg_parser)
+        {
+            arg_parser.register_switch({"--test-value"});
+            register_count++;
+        },
+        [&](const ArgParser &arg_parser)
+        {
+            if (arg_parser.has_switch("test-value"))
+                value = arg_parser.get_switch("test-value");
+        });
+}
+
+bool TestDecoder::is_recognized_impl(io::File &input_file) const
+{
+    return true;
+}
+
+std::unique_ptr<io::File> TestDecoder::decode_impl(
+    const Logger &logger, io::File &input_file) const
+{
+    return nullptr;
+}
+
+TEST_CASE("DecoderOptionsCache", "[flow]")
+{
+    int register_count = 0;
+    const DecoderOptionsCache decoder_options({"--test-value=abc", "file"});
+
+    SECTION("Options are parsed once per decoder type")
+    {
+        TestDecoder decoder1(register_count), decoder2(register_count);
+        decoder_options.apply("test", decoder1);
+        decoder_options.apply("test", decoder2);
+        REQUIRE(decoder1.value == "abc");
+        REQUIRE(decoder2.value == "abc");
+        REQUIRE(register_count == 1);
+    }
+
+    SECTION("Decoder types are parsed separately")
+    {
+        TestDecoder decoder1(register_count), decoder2(register_count);
+        decoder_options.apply("test1", decoder1);
+        decoder_options.apply("test2", decoder2);
+        REQUIRE(decoder1.value == "abc");
+        REQUIRE(decoder2.value == "abc");
+        REQUIRE(register_count == 2);
+    }
+}
@@ -0,0 +1,116 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/decoder_pool.h"
+#include "dec/base_file_decoder.h"
+#include "err.h"
+#include "test_support/catch.h"
+
+using namespace au;
+using namespace au::flow;
+
+namespace
+{
+    class TestDecoder final : public dec::BaseFileDecoder
+    {
+    public:
+        TestDecoder(int &instance_count);
+
+        std::string value;
+
+    protected:
+        bool is_recognized_impl(io::File &input_file) const override;
+
+        std::unique_ptr<io::File> decode_impl(
+            const Logger &logger, io::File &input_file) const override;
+    };
+}
+
+TestDecoder::TestDecoder(int &instance_count)
+{
+    instance_count++;
+    add_arg_parser_decorator(
+        [](ArgParser &arg_parser)
+        {
+            arg_parser.register_switch({"--test-value"});
+        },
+        [&](const ArgParser &arg_parser)
+        {
+            if (arg_parser.has_switch("test-value"))
+            {
+                value = arg_parser.get_switch("test-value");
+                if (value == "bad")
+                    throw err::UsageError("Bad value");
+            }
+        });
+}
+
+bool TestDecoder::is_recognized_impl(io::File &input_file) const
+{
+    return true;
+}
+
+std::unique_ptr<io::File> TestDecoder::decode_impl(
+    const Logger &logger, io::File &input_file) const
+{
+    return nullptr;
+}
+
+TEST_CASE("DecoderPool", "[flow]")
+{
+    int instance_count = 0;
+    auto registry = dec::Registry::create_mock();
+    registry->add_decoder(
+        "test",
+        [&]() { return std::make_shared<TestDecoder>(instance_count); });
+
+    SECTION("Decoders are created and configured once")
+    {
+        const DecoderOptionsCache decoder_options({"--test-value=abc"});
+        const DecoderPool decoder_pool(*registry, decoder_options);
+        const auto decoder1 = decoder_pool.get("test");
+        const auto decoder2 = decoder_pool.get("test");
+        REQUIRE(decoder1 == decoder2);
+        REQUIRE(instance_count == 1);
+        REQUIRE(dynamic_cast<const TestDecoder&>(*decoder1).value == "abc");
+    }
+
+    SECTION("Configured decoders are separate from shared registry ones")
+    {
+        const DecoderOptionsCache decoder_options({"--test-value=abc"});
+        const DecoderPool decoder_pool(*registry, decoder_options);
+        const auto decoder = registry->get_decoder("test");
+        REQUIRE(decoder == registry->get_decoder("test"));
+        REQUIRE(decoder != decoder_pool.get("test"));
+        REQUIRE(dynamic_cast<const TestDecoder&>(*decoder).value.empty());
+    }
+
+    SECTION("Bad options are reported on every use")
+    {
+        const DecoderOptionsCache decoder_options({"--test-value=bad"});
+        const DecoderPool decoder_pool(*registry, decoder_options);
+        REQUIRE_THROWS(decoder_pool.get("test"));
+        REQUIRE_THROWS(decoder_pool.get("test"));
+    }
+
+    SECTION("Unknown decoders")
+    {
+        const DecoderOptionsCache decoder_options({});
+        const DecoderPool decoder_pool(*registry, decoder_options);
+        REQUIRE_THROWS(decoder_pool.get("unknown"));
+    }
+}
@@ -16,8 +16,14 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "flow/file_saver_hdd.h"
+#include <map>
+#include <mutex>
+#include "algo/format.h"
+#include "algo/range.h"
+#include "err.h"
 #include "io/file_system.h"
 #include "test_support/catch.h"
+#include "test_support/file_support.h"
 
 using namespace au;
 
@@ -27,6 +33,7 @@ static void do_test(const io::path &path)
     const auto file = std::make_shared<io::File>(path.str(), "test"_b);
 
     file_saver.save(file);
+    file_saver.flush();
 
     REQUIRE(io::exists(path));
     {
@@ -52,6 +59,8 @@ static void do_test_overwriting(
         REQUIRE(!io::exists(path2));
         file_saver1.save(file);
         file_saver2.save(file);
+        file_saver1.flush();
+        file_saver2.flush();
         REQUIRE(io::exists(path));
         REQUIRE(io::exists(path2) == renamed_file_exists);
         if (io::exists(path)) io::remove(path);
@@ -95,4 +104,96 @@ TEST_CASE("FileSaver", "[core]")
         const flow::FileSaverHdd file_saver(".", true);
         do_test_overwriting(file_saver, file_saver, true);
     }
+
+    SECTION("Saving more data than the write queue can hold")
+    {
+        const flow::FileSaverHdd file_saver(".", true, 10);
+        std::vector<io::path> paths;
+        for (const auto i : algo::range(20))
+        {
+            const auto file = std::make_shared<io::File>(
+                algo::format("test%d.out", i), algo::format("test%d", i));
+            paths.push_back(file_saver.save(file));
+        }
+        file_saver.flush();
+
+        const auto stats = file_saver.get_stats();
+        REQUIRE(file_saver.get_saved_file_count() == 20);
+        REQUIRE(stats.queued_bytes == 0);
+        REQUIRE(stats.peak_queued_bytes <= 10);
+        REQUIRE(stats.written_bytes == 10 * 5 + 10 * 6);
+        for (const auto i : algo::range(20))
+        {
+            {
+                io::FileByteStream file_stream(paths[i], io::FileMode::Read);
+                REQUIRE(file_stream.read_to_eof()
+                    == bstr(algo::format("test%d", i)));
+            }
+            io::remove(paths[i]);
+        }
+    }
+
+
+    SECTION("Saving more files than the write queue can hold")
+    {
+        const flow::FileSaverHdd file_saver(".", true, 1024, 3);
+        std::vector<io::path> paths;
+        for (const auto i : algo::range(20))
+        {
+            const auto file = std::make_shared<io::File>(
+                algo::format("test%d.out", i), ""_b);
+            paths.push_back(file_saver.save(file));
+        }
+        file_saver.flush();
+
+        const auto stats = file_saver.get_stats();
+        REQUIRE(file_saver.get_saved_file_count() == 20);
+        REQUIRE(stats.queued_file_count == 0);
+        REQUIRE(stats.peak_queued_file_count <= 3);
+        for (const auto &path : paths)
+        {
+            REQUIRE(io::exists(path));
+            io::remove(path);
+        }
+    }
+
+    SECTION("Failed writes are reported per file")
+    {
+        const flow::FileSaverHdd file_saver(".", true);
+        std::map<std::string, std::string> errors;
+        std::mutex mutex;
+        const auto on_written = [&](
+            const io::path &path, const std::string &error)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            errors[path.str()] = error;
+        };
+
+        const auto path1 = file_saver.save_async(
+            std::make_shared<io::File>("test1.out", "test"_b), on_written);
+        const auto path2 = file_saver.save_async(
+            std::shared_ptr<io::File>(
+                tests::failing_file("test2.out", 100, 10)),
+            on_written);
+        file_saver.flush();
+        io::remove(path1);
+        io::remove(path2);
+
+        REQUIRE(errors.size() == 2);
+        REQUIRE(errors[path1.str()].empty());
+        REQUIRE(!errors[path2.str()].empty());
+        REQUIRE(file_saver.get_saved_file_count() == 1);
+        REQUIRE(file_saver.get_stats().failed_file_count == 1);
+    }
+
+    SECTION("Failed writes without a callback are reported by flush()")
+    {
+        const flow::FileSaverHdd file_saver(".", true);
+        const auto path = file_saver.save(
+            std::shared_ptr<io::File>(
+                tests::failing_file("test.out", 100, 10)));
+        REQUIRE_THROWS_AS(file_saver.flush(), err::IoError);
+        io::remove(path);
+        REQUIRE(file_saver.get_saved_file_count() == 0);
+    }
 }
@@ -0,0 +1,33 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/file_saver_null.h"
+#include "io/file_system.h"
+#include "test_support/catch.h"
+
+using namespace au;
+
+TEST_CASE("Discarding saved files", "[flow]")
+{
+    const flow::FileSaverNull file_saver;
+    file_saver.save(std::make_shared<io::File>("test.out", "test"_b));
+    file_saver.save(std::make_shared<io::File>("test.out", "test2"_b));
+    file_saver.flush();
+    REQUIRE(file_saver.get_saved_file_count() == 2);
+    REQUIRE(file_saver.get_saved_byte_count() == 9);
+    REQUIRE(!io::exists("test.out"));
+}
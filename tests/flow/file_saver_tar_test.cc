@@ -0,0 +1,183 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/file_saver_tar.h"
+#include <thread>
+#include "algo/format.h"
+#include "algo/range.h"
+#include "algo/str.h"
+#include "err.h"
+#include "io/file_byte_stream.h"
+#include "io/file_system.h"
+#include "test_support/catch.h"
+#include "test_support/file_support.h"
+
+using namespace au;
+
+namespace
+{
+    struct TarEntry final
+    {
+        std::string name;
+        bstr content;
+    };
+}
+
+static std::vector<TarEntry> read_tar(const io::path &path)
+{
+    std::vector<TarEntry> entries;
+    io::FileByteStream input_stream(path, io::FileMode::Read);
+    REQUIRE(input_stream.size() % 10240 == 0);
+    std::string long_name;
+    while (true)
+    {
+        const auto header = input_stream.read(512);
+        if (header == bstr(512))
+            break;
+
+        u32 checksum = 0;
+        for (const auto i : algo::range(512))
+            checksum += i >= 148 && i < 156 ? ' ' : header[i];
+        REQUIRE(checksum == std::stoul(header.substr(148, 7).str(), 0, 8));
+        REQUIRE(header.substr(257, 6) == "ustar\x00"_b);
+
+        const auto size = std::stoull(header.substr(124, 11).str(), 0, 8);
+        const auto content = input_stream.read(size);
+        input_stream.skip((512 - size % 512) % 512);
+        if (header[156] == 'L')
+        {
+            long_name = content.str(true);
+            continue;
+        }
+
+        REQUIRE(header[156] == '0');
+        auto name = header.substr(0, 100).str(true);
+        const auto prefix = header.substr(345, 155).str(true);
+        if (!long_name.empty())
+            name = long_name;
+        else if (!prefix.empty())
+            name = prefix + "/" + name;
+        long_name.clear();
+        entries.push_back({name, content});
+    }
+    return entries;
+}
+
+TEST_CASE("Saving files to tar archives", "[flow]")
+{
+    const io::path path = "tests/trash.tar";
+
+    SECTION("Plain files")
+    {
+        {
+            const flow::FileSaverTar file_saver(path);
+            file_saver.save(std::make_shared<io::File>("a.txt", "test"_b));
+            file_saver.save(std::make_shared<io::File>("dir/b.txt", ""_b));
+            file_saver.save(
+                std::make_shared<io::File>("a.txt", bstr(1000, 'x')));
+            REQUIRE(file_saver.get_saved_file_count() == 3);
+            file_saver.finish();
+        }
+        const auto entries = read_tar(path);
+        io::remove(path);
+        REQUIRE(entries.size() == 3);
+        REQUIRE(entries[0].name == "a.txt");
+        REQUIRE(entries[0].content == "test"_b);
+        REQUIRE(entries[1].name == "dir/b.txt");
+        REQUIRE(entries[1].content == ""_b);
+        REQUIRE(entries[2].name == "a(1).txt");
+        REQUIRE(entries[2].content == bstr(1000, 'x'));
+    }
+
+    SECTION("Long names")
+    {
+        const auto split_name = std::string(120, 'a') + "/" + "b.txt";
+        const auto long_name = std::string(300, 'c') + ".txt";
+        {
+            const flow::FileSaverTar file_saver(path);
+            file_saver.save(std::make_shared<io::File>(split_name, "1"_b));
+            file_saver.save(std::make_shared<io::File>(long_name, "2"_b));
+            file_saver.finish();
+        }
+        const auto entries = read_tar(path);
+        io::remove(path);
+        REQUIRE(entries.size() == 2);
+        REQUIRE(entries[0].name == split_name);
+        REQUIRE(entries[0].content == "1"_b);
+        REQUIRE(entries[1].name == long_name);
+        REQUIRE(entries[1].content == "2"_b);
+    }
+
+    SECTION("Concurrent saving")
+    {
+        {
+            const flow::FileSaverTar file_saver(path);
+            std::vector<std::thread> threads;
+            for (const auto i : algo::range(4))
+            {
+                threads.emplace_back([&, i]()
+                {
+                    for (const auto j : algo::range(50))
+                    {
+                        file_saver.save(std::make_shared<io::File>(
+                            algo::format("%d/%d.txt", i, j),
+                            bstr(algo::format("%d-%d", i, j))));
+                    }
+                });
+            }
+            for (auto &thread : threads)
+                thread.join();
+            file_saver.finish();
+        }
+        const auto entries = read_tar(path);
+        io::remove(path);
+        REQUIRE(entries.size() == 200);
+        for (const auto &entry : entries)
+        {
+            REQUIRE(algo::replace_all(entry.name, "/", "-")
+                == entry.content.str() + ".txt");
+        }
+    }
+
+    SECTION("Streams failing midway")
+    {
+        // the second failure happens past the writer's buffer, after part
+        // of the entry already reached the disk
+        for (const uoff_t fail_pos : {1000, 6 * 1024 * 1024})
+        {
+            {
+                const flow::FileSaverTar file_saver(path);
+                file_saver.save(std::make_shared<io::File>("a.txt", "1"_b));
+                REQUIRE_THROWS_AS(
+                    file_saver.save(std::shared_ptr<io::File>(
+                        tests::failing_file(
+                            "b.txt", 8 * 1024 * 1024, fail_pos))),
+                    err::IoError);
+                file_saver.save(std::make_shared<io::File>("c.txt", "2"_b));
+                REQUIRE(file_saver.get_saved_file_count() == 2);
+                file_saver.finish();
+            }
+            const auto entries = read_tar(path);
+            io::remove(path);
+            REQUIRE(entries.size() == 2);
+            REQUIRE(entries[0].name == "a.txt");
+            REQUIRE(entries[0].content == "1"_b);
+            REQUIRE(entries[1].name == "c.txt");
+            REQUIRE(entries[1].content == "2"_b);
+        }
+    }
+}
@@ -0,0 +1,162 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/file_saver_zip.h"
+#include <thread>
+#include <zlib.h>
+#include "algo/format.h"
+#include "algo/range.h"
+#include "io/file_byte_stream.h"
+#include "io/file_system.h"
+#include "test_support/catch.h"
+
+using namespace au;
+
+namespace
+{
+    struct ZipEntry final
+    {
+        std::string name;
+        bstr content;
+    };
+}
+
+static std::vector<ZipEntry> read_zip(const io::path &path)
+{
+    io::FileByteStream input_stream(path, io::FileMode::Read);
+    input_stream.seek(input_stream.size() - 22);
+    REQUIRE(input_stream.read(4) == "PK\x05\x06"_b);
+    input_stream.skip(4);
+    uoff_t entry_count = input_stream.read_le<u16>();
+    input_stream.skip(6);
+    uoff_t directory_offset = input_stream.read_le<u32>();
+    if (entry_count == 0xFFFF)
+    {
+        input_stream.seek(input_stream.size() - 22 - 20);
+        REQUIRE(input_stream.read(4) == "PK\x06\x07"_b);
+        input_stream.skip(4);
+        input_stream.seek(input_stream.read_le<u64>());
+        REQUIRE(input_stream.read(4) == "PK\x06\x06"_b);
+        input_stream.skip(20);
+        entry_count = input_stream.read_le<u64>();
+        input_stream.skip(16);
+        directory_offset = input_stream.read_le<u64>();
+    }
+
+    std::vector<ZipEntry> entries;
+    input_stream.seek(directory_offset);
+    for (const auto i : algo::range(entry_count))
+    {
+        REQUIRE(input_stream.read(4) == "PK\x01\x02"_b);
+        input_stream.skip(12);
+        const auto crc = input_stream.read_le<u32>();
+        const auto size = input_stream.read_le<u32>();
+        input_stream.skip(4);
+        const auto name_size = input_stream.read_le<u16>();
+        const auto extra_size = input_stream.read_le<u16>();
+        input_stream.skip(10);
+        const auto offset = input_stream.read_le<u32>();
+        const auto name = input_stream.read(name_size).str();
+        input_stream.skip(extra_size);
+
+        const auto old_pos = input_stream.pos();
+        input_stream.seek(offset);
+        REQUIRE(input_stream.read(4) == "PK\x03\x04"_b);
+        input_stream.skip(22);
+        REQUIRE(input_stream.read_le<u16>() == name_size);
+        input_stream.skip(2 + name_size);
+        const auto content = input_stream.read(size);
+        REQUIRE(crc32(0, content.get<const Bytef>(), size) == crc);
+        input_stream.seek(old_pos);
+
+        entries.push_back({name, content});
+    }
+    return entries;
+}
+
+TEST_CASE("Saving files to zip archives", "[flow]")
+{
+    const io::path path = "tests/trash.zip";
+
+    SECTION("Plain files")
+    {
+        {
+            const flow::FileSaverZip file_saver(path);
+            file_saver.save(std::make_shared<io::File>("a.txt", "test"_b));
+            file_saver.save(std::make_shared<io::File>("dir/b.txt", ""_b));
+            file_saver.save(
+                std::make_shared<io::File>("a.txt", bstr(1000, 'x')));
+            REQUIRE(file_saver.get_saved_file_count() == 3);
+            file_saver.finish();
+        }
+        const auto entries = read_zip(path);
+        io::remove(path);
+        REQUIRE(entries.size() == 3);
+        REQUIRE(entries[0].name == "a.txt");
+        REQUIRE(entries[0].content == "test"_b);
+        REQUIRE(entries[1].name == "dir/b.txt");
+        REQUIRE(entries[1].content == ""_b);
+        REQUIRE(entries[2].name == "a(1).txt");
+        REQUIRE(entries[2].content == bstr(1000, 'x'));
+    }
+
+    SECTION("More files than the plain zip format can hold")
+    {
+        {
+            const flow::FileSaverZip file_saver(path);
+            for (const auto i : algo::range(70000))
+            {
+                file_saver.save(std::make_shared<io::File>(
+                    algo::format("%d", i), ""_b));
+            }
+            file_saver.finish();
+        }
+        const auto entries = read_zip(path);
+        io::remove(path);
+        REQUIRE(entries.size() == 70000);
+        REQUIRE(entries.back().name == "69999");
+    }
+
+    SECTION("Concurrent saving")
+    {
+        {
+            const flow::FileSaverZip file_saver(path);
+            std::vector<std::thread> threads;
+            for (const auto i : algo::range(4))
+            {
+                threads.emplace_back([&, i]()
+                {
+                    for (const auto j : algo::range(50))
+                    {
+                        file_saver.save(std::make_shared<io::File>(
+                            algo::format("%d-%d", i, j),
+                            bstr(algo::format("%d-%d", i, j))));
+                    }
+                });
+            }
+            for (auto &thread : threads)
+                thread.join();
+            file_saver.flush();
+            file_saver.finish();
+        }
+        const auto entries = read_zip(path);
+        io::remove(path);
+        REQUIRE(entries.size() == 200);
+        for (const auto &entry : entries)
+            REQUIRE(entry.content.str() == entry.name);
+    }
+}
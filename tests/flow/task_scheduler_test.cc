@@ -0,0 +1,158 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/task_scheduler.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "algo/range.h"
+#include "test_support/catch.h"
+
+using namespace au;
+using namespace au::flow;
+
+namespace
+{
+    class LambdaTask final : public ITask
+    {
+    public:
+        LambdaTask(std::function<bool()> callback) : callback(callback)
+        {
+        }
+
+        bool work() const override
+        {
+            return callback();
+        }
+
+    private:
+        std::function<bool()> callback;
+    };
+}
+
+static std::shared_ptr<ITask> make_task(std::function<bool()> callback)
+{
+    return std::make_shared<LambdaTask>(callback);
+}
+
+// Spawns a complete binary tree of tasks, similar to how nested decoding
+// bursts into many small tasks.
+static void spawn_tree(
+    TaskScheduler &scheduler,
+    std::atomic<int> &counter,
+    const int depth,
+    const int work_amount)
+{
+    scheduler.push_front(make_task([&, depth, work_amount]()
+    {
+        volatile int sink = 0;
+        for (const auto i : algo::range(work_amount))
+            sink += i;
+        ++counter;
+        if (depth > 0)
+        {
+            spawn_tree(scheduler, counter, depth - 1, work_amount);
+            spawn_tree(scheduler, counter, depth - 1, work_amount);
+        }
+        return true;
+    }));
+}
+
+TEST_CASE("TaskScheduler", "[flow]")
+{
+    SECTION("Running with no tasks")
+    {
+        TaskScheduler scheduler;
+        const auto result = scheduler.run(4);
+        REQUIRE(result.success_count == 0);
+        REQUIRE(result.error_count == 0);
+    }
+
+    SECTION("Counting successes and errors")
+    {
+        TaskScheduler scheduler;
+        for (const auto i : algo::range(10))
+            scheduler.push_back(make_task([=]() { return i % 3 != 0; }));
+        const auto result = scheduler.run(4);
+        REQUIRE(result.success_count == 6);
+        REQUIRE(result.error_count == 4);
+    }
+
+    SECTION("Ordering of push_front and push_back on a single thread")
+    {
+        TaskScheduler scheduler;
+        std::vector<std::string> order;
+        scheduler.push_back(make_task([&]()
+        {
+            order.push_back("a");
+            scheduler.push_front(make_task([&]()
+            {
+                order.push_back("a1");
+                return true;
+            }));
+            scheduler.push_front(make_task([&]()
+            {
+                order.push_back("a2");
+                return true;
+            }));
+            return true;
+        }));
+        scheduler.push_back(make_task([&]()
+        {
+            order.push_back("b");
+            return true;
+        }));
+        scheduler.run(1);
+        REQUIRE(order == std::vector<std::string>({"a", "a2", "a1", "b"}));
+    }
+
+    SECTION("Waiting for tasks spawned by other tasks")
+    {
+        for (const auto thread_count : {1, 2, 4, 8})
+        {
+            TaskScheduler scheduler;
+            std::atomic<int> counter(0);
+            spawn_tree(scheduler, counter, 10, 0);
+            const auto result = scheduler.run(thread_count);
+            REQUIRE(counter == 2047);
+            REQUIRE(result.success_count == 2047);
+            REQUIRE(result.error_count == 0);
+        }
+    }
+
+    SECTION("Waking parked workers for late tasks")
+    {
+        TaskScheduler scheduler;
+        std::atomic<int> counter(0);
+        scheduler.push_back(make_task([&]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            for (const auto i : algo::range(20))
+                scheduler.push_front(make_task([&]()
+                {
+                    ++counter;
+                    return true;
+                }));
+            return true;
+        }));
+        const auto result = scheduler.run(4);
+        REQUIRE(counter == 20);
+        REQUIRE(result.success_count == 21);
+    }
+}
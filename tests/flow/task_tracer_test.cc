@@ -0,0 +1,110 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "flow/task_tracer.h"
+#include <set>
+#include <thread>
+#include "algo/range.h"
+#include "algo/str.h"
+#include "io/memory_byte_stream.h"
+#include "test_support/catch.h"
+
+using namespace au;
+using namespace au::flow;
+
+TEST_CASE("TaskTracer", "[flow]")
+{
+    SECTION("Recording spans")
+    {
+        TaskTracer tracer;
+        {
+            TraceSpan span(&tracer, "decode", "dec", "test.bin");
+            span.set_bytes_in(10);
+            span.set_bytes_out(20);
+        }
+        const auto events = tracer.get_events();
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].name == "decode");
+        REQUIRE(events[0].decoder_name == "dec");
+        REQUIRE(events[0].file_name == "test.bin");
+        REQUIRE(events[0].bytes_in == 10);
+        REQUIRE(events[0].bytes_out == 20);
+        REQUIRE(events[0].end >= events[0].begin);
+    }
+
+    SECTION("Finishing spans early")
+    {
+        TaskTracer tracer;
+        {
+            TraceSpan span(&tracer, "recognize", "", "test.bin");
+            span.set_decoder_name("dec");
+            span.finish();
+            span.set_bytes_out(20);
+        }
+        const auto events = tracer.get_events();
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].decoder_name == "dec");
+        REQUIRE(events[0].bytes_out == 0);
+    }
+
+    SECTION("Spans without tracer")
+    {
+        TraceSpan span(nullptr, "decode", "dec", "test.bin");
+        span.set_bytes_in(10);
+        REQUIRE_NOTHROW(span.finish());
+    }
+
+    SECTION("Recording from many threads")
+    {
+        TaskTracer tracer;
+        std::vector<std::thread> threads;
+        for (const auto i : algo::range(4))
+        {
+            threads.push_back(std::thread([&tracer]()
+            {
+                for (const auto j : algo::range(100))
+                    TraceSpan(&tracer, "decode", "dec", "test.bin");
+            }));
+        }
+        for (auto &thread : threads)
+            thread.join();
+
+        const auto events = tracer.get_events();
+        REQUIRE(events.size() == 400);
+        std::set<size_t> thread_ids;
+        for (const auto &event : events)
+            thread_ids.insert(event.thread_id);
+        REQUIRE(thread_ids.size() == 4);
+    }
+
+    SECTION("Writing Chrome trace")
+    {
+        TaskTracer tracer;
+        TraceSpan(&tracer, "read_file", "dec", "dir\\\"quoted\".bin");
+        TraceSpan(&tracer, "encode", "dec", "test.bin");
+        io::MemoryByteStream output_stream;
+        tracer.write_chrome_trace(output_stream);
+        output_stream.seek(0);
+        const auto json = output_stream.read_to_eof().str();
+        REQUIRE(json.find("{\"traceEvents\":[") == 0);
+        REQUIRE(json.find("\"name\":\"read_file\"") != std::string::npos);
+        REQUIRE(json.find("\"name\":\"encode\"") != std::string::npos);
+        REQUIRE(json.find("dir\\\\\\\"quoted\\\".bin") != std::string::npos);
+        REQUIRE(json.find("},\n]}") == std::string::npos);
+        REQUIRE(json.substr(json.size() - 3) == "]}\n");
+    }
+}
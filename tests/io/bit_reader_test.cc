@@ -0,0 +1,192 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "algo/range.h"
+#include "io/lsb_bit_reader.h"
+#include "io/lsb_bit_stream.h"
+#include "io/memory_byte_stream.h"
+#include "io/msb_bit_reader.h"
+#include "io/msb_bit_stream.h"
+#include "test_support/catch.h"
+
+using namespace au;
+
+static bstr get_random_data(const size_t size)
+{
+    bstr data(size);
+    for (const auto i : algo::range(size))
+        data[i] = rand();
+    return data;
+}
+
+// Compares the reader against the byte-at-a-time path of the bit stream.
+template<class TReader, class TStream> static void test_against_stream()
+{
+    const auto data = get_random_data(1000);
+    io::MemoryByteStream input_stream(data);
+    TStream expected_reader(input_stream);
+    TReader actual_reader(data);
+    while (true)
+    {
+        const size_t bits = rand() % 33;
+        if (bits > expected_reader.left())
+        {
+            REQUIRE_THROWS(actual_reader.read(bits));
+            REQUIRE(actual_reader.pos() == expected_reader.pos());
+            const auto left = expected_reader.left();
+            REQUIRE(actual_reader.read(left) == expected_reader.read(left));
+            break;
+        }
+        INFO("Position: " << actual_reader.pos() << ", bits: " << bits);
+        const auto value = expected_reader.read(bits);
+        REQUIRE(actual_reader.peek(bits) == value);
+        REQUIRE(actual_reader.read(bits) == value);
+        REQUIRE(actual_reader.pos() == expected_reader.pos());
+    }
+    REQUIRE(actual_reader.left() == 0);
+}
+
+template<class TReader> static void test_seeking()
+{
+    const auto data = get_random_data(100);
+    TReader reader(data);
+    for (const uoff_t pos : algo::range(data.size() * 8 - 32))
+    {
+        reader.seek(pos);
+        const auto value = reader.read(32);
+        reader.seek(pos + 5);
+        reader.read(27);
+        reader.seek(pos);
+        REQUIRE(reader.pos() == pos);
+        REQUIRE(reader.read(32) == value);
+    }
+    REQUIRE_THROWS(reader.seek(data.size() * 8 + 1));
+}
+
+TEST_CASE("MsbBitReader", "[io]")
+{
+    SECTION("Peeking and consuming")
+    {
+        const auto data = "\x8F\x01"_b; // 10001111 00000001
+        io::MsbBitReader reader(data);
+        REQUIRE(reader.peek(0) == 0);
+        REQUIRE(reader.peek(3) == 0b100);
+        REQUIRE(reader.peek(9) == 0b100011110);
+        reader.consume(4);
+        REQUIRE(reader.pos() == 4);
+        REQUIRE(reader.peek(12) == 0b111100000001);
+        reader.consume(12);
+        REQUIRE(reader.left() == 0);
+    }
+
+    SECTION("Peeking beyond EOF pads with zeros")
+    {
+        const auto data = "\xFF"_b;
+        io::MsbBitReader reader(data);
+        reader.consume(4);
+        REQUIRE(reader.peek(8) == 0b11110000);
+        REQUIRE(reader.peek(32) == 0xF0000000);
+    }
+
+    SECTION("Consuming beyond EOF throws errors")
+    {
+        const auto data = "\xFF\x00"_b;
+        io::MsbBitReader reader(data);
+        reader.consume(7);
+        REQUIRE_THROWS(reader.consume(10));
+        REQUIRE(reader.pos() == 7);
+        REQUIRE(reader.read(9) == 0b100000000);
+        REQUIRE_THROWS(reader.read(1));
+    }
+
+    SECTION("Empty input")
+    {
+        const bstr data;
+        io::MsbBitReader reader(data);
+        REQUIRE(reader.size() == 0);
+        REQUIRE(reader.peek(8) == 0);
+        REQUIRE_THROWS(reader.read(1));
+    }
+
+    SECTION("Seeking")
+    {
+        test_seeking<io::MsbBitReader>();
+    }
+
+    SECTION("Random reads")
+    {
+        for (const auto i : algo::range(10))
+            test_against_stream<io::MsbBitReader, io::MsbBitStream>();
+    }
+}
+
+TEST_CASE("LsbBitReader", "[io]")
+{
+    SECTION("Peeking and consuming")
+    {
+        const auto data = "\x8F\x01"_b; // 10001111 00000001
+        io::LsbBitReader reader(data);
+        REQUIRE(reader.peek(0) == 0);
+        REQUIRE(reader.peek(3) == 0b111);
+        REQUIRE(reader.peek(9) == 0b110001111);
+        reader.consume(4);
+        REQUIRE(reader.pos() == 4);
+        REQUIRE(reader.peek(12) == 0b000000011000);
+        reader.consume(12);
+        REQUIRE(reader.left() == 0);
+    }
+
+    SECTION("Peeking beyond EOF pads with zeros")
+    {
+        const auto data = "\xFF"_b;
+        io::LsbBitReader reader(data);
+        reader.consume(4);
+        REQUIRE(reader.peek(8) == 0b00001111);
+        REQUIRE(reader.peek(32) == 0x0000000F);
+    }
+
+    SECTION("Consuming beyond EOF throws errors")
+    {
+        const auto data = "\xFF\x00"_b;
+        io::LsbBitReader reader(data);
+        reader.consume(7);
+        REQUIRE_THROWS(reader.consume(10));
+        REQUIRE(reader.pos() == 7);
+        REQUIRE(reader.read(9) == 1);
+        REQUIRE_THROWS(reader.read(1));
+    }
+
+    SECTION("Empty input")
+    {
+        const bstr data;
+        io::LsbBitReader reader(data);
+        REQUIRE(reader.size() == 0);
+        REQUIRE(reader.peek(8) == 0);
+        REQUIRE_THROWS(reader.read(1));
+    }
+
+    SECTION("Seeking")
+    {
+        test_seeking<io::LsbBitReader>();
+    }
+
+    SECTION("Random reads")
+    {
+        for (const auto i : algo::range(10))
+            test_against_stream<io::LsbBitReader, io::LsbBitStream>();
+    }
+}
@@ -51,6 +51,30 @@ TEST_CASE("FileByteStream", "[io][stream]")
         io::remove("tests/trash.out");
     }
 
+    SECTION("Clones of read-only files have independent positions")
+    {
+        io::FileByteStream stream(
+            "tests/dec/png/files/reimu_transparent.png", io::FileMode::Read);
+        stream.seek(1);
+        const auto clone = stream.clone();
+        REQUIRE(clone->pos() == 1);
+        REQUIRE(clone->size() == stream.size());
+        tests::compare_binary(clone->read(3), "PNG"_b);
+        REQUIRE(clone->pos() == 4);
+        REQUIRE(stream.pos() == 1);
+        tests::compare_binary(stream.read(3), "PNG"_b);
+    }
+
+    SECTION("Reading beyond EOF of read-only files throws errors")
+    {
+        io::FileByteStream stream(
+            "tests/dec/png/files/reimu_transparent.png", io::FileMode::Read);
+        stream.seek(stream.size() - 1);
+        REQUIRE_THROWS(stream.read(2));
+        REQUIRE(stream.pos() == stream.size() - 1);
+        REQUIRE_THROWS(stream.seek(stream.size() + 1));
+    }
+
     SECTION("Full test suite")
     {
         tests::stream_test(
@@ -0,0 +1,59 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "io/slice_byte_stream.h"
+#include "io/memory_byte_stream.h"
+#include "test_support/catch.h"
+#include "test_support/common.h"
+
+using namespace au;
+
+TEST_CASE("SliceByteStream", "[io][stream]")
+{
+    io::MemoryByteStream parent_stream("0123456789"_b);
+
+    SECTION("Reading within the slice")
+    {
+        io::SliceByteStream stream(parent_stream, 2, 5);
+        REQUIRE(stream.size() == 5);
+        REQUIRE(stream.pos() == 0);
+        tests::compare_binary(stream.read(3), "234"_b);
+        tests::compare_binary(stream.seek(1).read_to_eof(), "3456"_b);
+    }
+
+    SECTION("Reading beyond the slice throws errors")
+    {
+        io::SliceByteStream stream(parent_stream, 2, 5);
+        stream.seek(4);
+        REQUIRE_THROWS(stream.read(2));
+    }
+
+    SECTION("Slicing beyond the parent stream throws errors")
+    {
+        REQUIRE_THROWS(io::SliceByteStream(parent_stream, 8, 3));
+        REQUIRE_THROWS(io::SliceByteStream(parent_stream, 11, 0));
+    }
+
+    SECTION("Clones have independent positions")
+    {
+        io::SliceByteStream stream(parent_stream, 2, 5);
+        stream.seek(1);
+        const auto clone = stream.clone();
+        tests::compare_binary(clone->read(2), "34"_b);
+        tests::compare_binary(stream.read(1), "3"_b);
+    }
+}
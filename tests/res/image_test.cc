@@ -16,11 +16,21 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "res/image.h"
+#include <type_traits>
 #include "algo/range.h"
+#include "err.h"
+#include "io/memory_byte_stream.h"
+#include "res/image_kernels.h"
 #include "test_support/catch.h"
 
 using namespace au;
 
+// std::vector copies elements on reallocation unless moving cannot throw
+static_assert(
+    std::is_nothrow_move_constructible<res::Image>::value
+        && std::is_nothrow_move_assignable<res::Image>::value,
+    "Moving images must not throw");
+
 static res::Image create_test_image(const size_t width, const size_t height)
 {
     res::Image test_image(width, height);
@@ -269,3 +279,165 @@ TEST_CASE("Image offsetting", "[res]")
         }
     }
 }
+
+TEST_CASE("Image reading from streams", "[res]")
+{
+    bstr input(4 * 100 * 70 + 1);
+    for (auto &c : input)
+        c = rand();
+
+    SECTION("Matching reading from memory")
+    {
+        for (const auto fmt : {
+            res::PixelFormat::Gray8,
+            res::PixelFormat::BGR565,
+            res::PixelFormat::RGB888,
+            res::PixelFormat::BGRA8888,
+            res::PixelFormat::RGBnA8888})
+        {
+            io::MemoryByteStream input_stream(input);
+            const res::Image expected(100, 70, input, fmt);
+            const res::Image actual(100, 70, input_stream, fmt);
+            REQUIRE(input_stream.pos()
+                == 100 * 70 * res::pixel_format_to_bpp(fmt));
+            for (const auto y : algo::range(70))
+            for (const auto x : algo::range(100))
+                REQUIRE(actual.at(x, y) == expected.at(x, y));
+        }
+    }
+
+    SECTION("Not enough input")
+    {
+        io::MemoryByteStream input_stream(input);
+        REQUIRE_THROWS_AS(
+            res::Image(100, 71, input_stream, res::PixelFormat::BGRA8888),
+            err::EofError);
+        REQUIRE(input_stream.pos() == 0);
+    }
+}
+
+static std::vector<res::Pixel> get_random_pixels(const size_t count)
+{
+    std::vector<res::Pixel> pixels(count);
+    for (auto &c : pixels)
+    {
+        c.b = rand();
+        c.g = rand();
+        c.r = rand();
+        c.a = rand() % 3 ? rand() : 0;
+    }
+    return pixels;
+}
+
+static void compare_pixels(
+    const std::vector<res::Pixel> &actual,
+    const std::vector<res::Pixel> &expected)
+{
+    REQUIRE(actual.size() == expected.size());
+    for (const auto i : algo::range(actual.size()))
+        REQUIRE(actual[i] == expected[i]);
+}
+
+TEST_CASE("Image kernels", "[res]")
+{
+    const auto &expected_kernels
+        = res::get_image_kernels(algo::SimdLevel::None);
+
+    for (const auto level : {
+        algo::SimdLevel::Sse2,
+        algo::SimdLevel::Ssse3,
+        algo::SimdLevel::Avx2,
+        algo::SimdLevel::Neon})
+    {
+        if (!algo::is_simd_level_supported(level))
+            continue;
+        INFO("SIMD level: " << static_cast<int>(level));
+        const auto &kernels = res::get_image_kernels(level);
+
+        for (const auto count : {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 100})
+        {
+            INFO("Pixel count: " << count);
+            const auto source = get_random_pixels(count);
+            const auto target = get_random_pixels(count);
+            auto expected = target, actual = target;
+
+            expected_kernels.invert(expected.data(), count);
+            kernels.invert(actual.data(), count);
+            compare_pixels(actual, expected);
+
+            expected_kernels.reverse(expected.data(), count);
+            kernels.reverse(actual.data(), count);
+            compare_pixels(actual, expected);
+
+            expected_kernels.apply_mask(expected.data(), source.data(), count);
+            kernels.apply_mask(actual.data(), source.data(), count);
+            compare_pixels(actual, expected);
+
+            expected_kernels.overlay_non_transparent(
+                expected.data(), source.data(), count);
+            kernels.overlay_non_transparent(
+                actual.data(), source.data(), count);
+            compare_pixels(actual, expected);
+
+            expected_kernels.overlay_add(
+                expected.data(), source.data(), count);
+            kernels.overlay_add(actual.data(), source.data(), count);
+            compare_pixels(actual, expected);
+
+            const auto table = get_random_pixels(256);
+            for (const auto palette_size : {0, 1, 100, 256})
+            {
+                auto expected_copy = expected, actual_copy = actual;
+                expected_kernels.apply_palette(
+                    expected_copy.data(), count, table.data(), palette_size);
+                kernels.apply_palette(
+                    actual_copy.data(), count, table.data(), palette_size);
+                compare_pixels(actual_copy, expected_copy);
+            }
+        }
+    }
+}
+
+TEST_CASE("Image transformations", "[res]")
+{
+    SECTION("Flipping")
+    {
+        const auto image = create_test_image(5, 3);
+        res::Image vertical(image), horizontal(image);
+        vertical.flip_vertically();
+        horizontal.flip_horizontally();
+        for (const auto y : algo::range(3))
+        for (const auto x : algo::range(5))
+        {
+            REQUIRE(vertical.at(x, y) == image.at(x, 2 - y));
+            REQUIRE(horizontal.at(x, y) == image.at(4 - x, y));
+        }
+    }
+
+    SECTION("Applying palettes")
+    {
+        res::Palette palette(2);
+        palette[0] = {1, 2, 3, 4};
+        palette[1] = {5, 6, 7, 8};
+        res::Image image(3, 1);
+        image.at(0, 0) = {0xFF, 0xFF, 1, 0xFF};
+        image.at(1, 0) = {0xFF, 0xFF, 0, 0xFF};
+        image.at(2, 0) = {0xFF, 0xFF, 2, 0xFF};
+        image.apply_palette(palette);
+        REQUIRE(image.at(0, 0) == palette[1]);
+        REQUIRE(image.at(1, 0) == palette[0]);
+        REQUIRE(image.at(2, 0) == res::Pixel({0xFF, 0xFF, 2, 0}));
+    }
+
+    SECTION("Moving")
+    {
+        auto image = create_test_image(5, 3);
+        const auto expected = image;
+        const res::Image moved(std::move(image));
+        REQUIRE(moved.width() == 5);
+        REQUIRE(moved.height() == 3);
+        for (const auto y : algo::range(3))
+        for (const auto x : algo::range(5))
+            REQUIRE(moved.at(x, y) == expected.at(x, y));
+    }
+}
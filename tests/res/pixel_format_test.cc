@@ -18,6 +18,7 @@
 #include "res/pixel_format.h"
 #include "algo/format.h"
 #include "algo/range.h"
+#include "res/pixel_kernels.h"
 #include "test_support/catch.h"
 
 using namespace au;
@@ -127,3 +128,46 @@ TEST_CASE("PixelFormat", "[res]")
             0b11111110000000010000001000000011, PF::RGBnA8888, {1, 2, 3, 1});
     }
 }
+
+static const auto format_count = static_cast<int>(res::PixelFormat::Count);
+
+static const algo::SimdLevel simd_levels[] =
+{
+    algo::SimdLevel::Sse2,
+    algo::SimdLevel::Ssse3,
+    algo::SimdLevel::Avx2,
+    algo::SimdLevel::Neon,
+};
+
+TEST_CASE("PixelFormat kernels", "[res]")
+{
+    bstr input(4 * 1000);
+    for (auto &c : input)
+        c = rand();
+
+    for (const auto level : simd_levels)
+    {
+        if (!algo::is_simd_level_supported(level))
+            continue;
+        INFO("SIMD level: " << static_cast<int>(level));
+        for (const auto i : algo::range(format_count))
+        {
+            const auto fmt = static_cast<res::PixelFormat>(i);
+            INFO("Pixel format: " << i);
+            for (const auto count : {0, 1, 7, 8, 15, 16, 17, 33, 63, 1000})
+            {
+                std::vector<res::Pixel> expected(count), actual(count);
+                res::read_pixels(
+                    input.get<u8>(),
+                    expected.data(),
+                    count,
+                    fmt,
+                    algo::SimdLevel::None);
+                res::read_pixels(
+                    input.get<u8>(), actual.data(), count, fmt, level);
+                for (const auto j : algo::range(count))
+                    compare_pixels(actual[j], expected[j]);
+            }
+        }
+    }
+}
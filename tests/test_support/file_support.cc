@@ -16,20 +16,88 @@
 // along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
 
 #include "test_support/file_support.h"
+#include <cstring>
 #include "algo/format.h"
 #include "algo/pack/zlib.h"
 #include "algo/range.h"
+#include "err.h"
 #include "test_support/catch.h"
 #include "test_support/common.h"
 
 using namespace au;
 
+namespace
+{
+    // Claims to hold the given number of bytes, but fails midway.
+    class FailingStream final : public io::BaseByteStream
+    {
+    public:
+        FailingStream(const uoff_t stream_size, const uoff_t fail_pos)
+            : stream_size(stream_size), fail_pos(fail_pos), stream_pos(0)
+        {
+        }
+
+        uoff_t size() const override
+        {
+            return stream_size;
+        }
+
+        uoff_t pos() const override
+        {
+            return stream_pos;
+        }
+
+        std::unique_ptr<io::BaseByteStream> clone() const override
+        {
+            auto ret = std::make_unique<FailingStream>(stream_size, fail_pos);
+            ret->seek(stream_pos);
+            return std::move(ret);
+        }
+
+    protected:
+        void read_impl(void *destination, const size_t size) override
+        {
+            if (stream_pos + size > fail_pos)
+                throw err::IoError("Simulated read error");
+            std::memset(destination, 'x', size);
+            stream_pos += size;
+        }
+
+        void write_impl(const void *source, const size_t size) override
+        {
+            throw err::NotSupportedError("Not implemented");
+        }
+
+        void seek_impl(const uoff_t offset) override
+        {
+            stream_pos = offset;
+        }
+
+        void resize_impl(const uoff_t new_size) override
+        {
+            throw err::NotSupportedError("Not implemented");
+        }
+
+    private:
+        const uoff_t stream_size;
+        const uoff_t fail_pos;
+        uoff_t stream_pos;
+    };
+}
+
 std::unique_ptr<io::File> tests::stub_file(
     const std::string &path, const bstr &data)
 {
     return std::make_unique<io::File>(path, data);
 }
 
+std::unique_ptr<io::File> tests::failing_file(
+    const std::string &path, const uoff_t size, const uoff_t fail_pos)
+{
+    return std::make_unique<io::File>(
+        path, std::make_unique<FailingStream>(size, fail_pos));
+}
+
 std::unique_ptr<io::File> tests::file_from_path(
     const io::path &path, const std::string &custom_path)
 {
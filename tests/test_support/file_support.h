@@ -26,6 +26,11 @@ namespace tests {
     std::unique_ptr<io::File> stub_file(
         const std::string &path, const bstr &data);
 
+    // The file claims to hold size bytes, but reading past fail_pos throws
+    // err::IoError.
+    std::unique_ptr<io::File> failing_file(
+        const std::string &path, const uoff_t size, const uoff_t fail_pos);
+
     std::unique_ptr<io::File> file_from_path(
         const io::path &path, const std::string &custom_path = "");
 
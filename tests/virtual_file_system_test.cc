@@ -0,0 +1,105 @@
+// Copyright (C) 2016 by rr-
+//
+// This file is part of arc_unpacker.
+//
+// arc_unpacker is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// arc_unpacker is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with arc_unpacker. If not, see <http://www.gnu.org/licenses/>.
+
+#include "virtual_file_system.h"
+#include "algo/range.h"
+#include "test_support/catch.h"
+#include "test_support/common.h"
+
+using namespace au;
+
+static std::function<std::unique_ptr<io::File>()> make_factory(
+    const std::string &content)
+{
+    return [=]()
+    {
+        return std::make_unique<io::File>("dummy", bstr(content));
+    };
+}
+
+TEST_CASE("VirtualFileSystem", "[core]")
+{
+    VirtualFileSystem::clear();
+
+    SECTION("Looking up registered files")
+    {
+        VirtualFileSystem::register_file("dir/Test.DAT", make_factory("1"));
+        tests::compare_binary(
+            VirtualFileSystem::get_by_stem("test")->stream.read_to_eof(),
+            "1"_b);
+        tests::compare_binary(
+            VirtualFileSystem::get_by_name("TEST.dat")->stream.read_to_eof(),
+            "1"_b);
+        tests::compare_binary(
+            VirtualFileSystem::get_by_path("DIR/test.dat")
+                ->stream.read_to_eof(),
+            "1"_b);
+        REQUIRE(!VirtualFileSystem::get_by_stem("dir"));
+        REQUIRE(!VirtualFileSystem::get_by_name("test"));
+        REQUIRE(!VirtualFileSystem::get_by_path("test.dat"));
+    }
+
+    SECTION("Ambiguous stems resolve to the first path")
+    {
+        VirtualFileSystem::register_file("b/test.dat", make_factory("2"));
+        VirtualFileSystem::register_file("a/test.bin", make_factory("1"));
+        tests::compare_binary(
+            VirtualFileSystem::get_by_stem("test")->stream.read_to_eof(),
+            "1"_b);
+        VirtualFileSystem::unregister_file("A/TEST.BIN");
+        tests::compare_binary(
+            VirtualFileSystem::get_by_stem("test")->stream.read_to_eof(),
+            "2"_b);
+        VirtualFileSystem::unregister_file("b/test.dat");
+        REQUIRE(!VirtualFileSystem::get_by_stem("test"));
+    }
+
+    SECTION("Looking up files in registered directories")
+    {
+        VirtualFileSystem::register_directory("tests/dec/png/files");
+        REQUIRE(VirtualFileSystem::get_by_name("REIMU_TRANSPARENT.PNG"));
+        REQUIRE(VirtualFileSystem::get_by_stem("reimu_transparent"));
+        REQUIRE(VirtualFileSystem::get_by_path(
+            "tests/dec/png/files/reimu_transparent.png"));
+        REQUIRE(!VirtualFileSystem::get_by_name("reimu_transparent"));
+
+        VirtualFileSystem::unregister_directory("tests/dec/png/files");
+        REQUIRE(!VirtualFileSystem::get_by_name("reimu_transparent.png"));
+    }
+
+    SECTION("Registered files take precedence over directories")
+    {
+        VirtualFileSystem::register_directory("tests/dec/png/files");
+        VirtualFileSystem::register_file(
+            "reimu_transparent.png", make_factory("1"));
+        tests::compare_binary(
+            VirtualFileSystem::get_by_name("reimu_transparent.png")
+                ->stream.read_to_eof(),
+            "1"_b);
+    }
+
+    SECTION("Disabling")
+    {
+        VirtualFileSystem::register_file("test.dat", make_factory("1"));
+        VirtualFileSystem::disable();
+        REQUIRE(!VirtualFileSystem::get_by_name("test.dat"));
+        VirtualFileSystem::enable();
+        REQUIRE(VirtualFileSystem::get_by_name("test.dat"));
+    }
+
+    VirtualFileSystem::clear();
+}